@@ -458,6 +458,7 @@ void CMainCtrl::initStoreConnections()
     connect(m_pView->getStoreView(), &CStoreDlg::doUpdatePluginInfo, m_pModel->getStoreManager(), &CStoreManager::onUpdatePluginInfo);
     connect(m_pView->getStoreView(), &CStoreDlg::doServerSearchChanged, m_pModel->getStoreManager(), &CStoreManager::onServerSearchChanged);
     connect(m_pView->getStoreView(), &CStoreDlg::doLocalSearchChanged, m_pModel->getStoreManager(), &CStoreManager::onLocalSearchChanged);
+    connect(m_pView->getStoreView(), &CStoreDlg::doCancelArchive, m_pModel->getStoreManager(), &CStoreManager::onCancelArchive);
 
     //Model -> view
     connect(m_pModel->getStoreManager(), &CStoreManager::doSetServerPluginModel, m_pView->getStoreView(), &CStoreDlg::onSetServerPluginModel);
@@ -486,11 +487,23 @@ void CMainCtrl::initSettingsConnections()
     connect(m_pView->getPreferenceDlg()->getGeneralSettings(), &CGeneralSettingsWidget::doEnableTutorialHelper, m_pModel->getSettingsManager(), &CSettingsManager::onEnableTutorialHelper);
     connect(m_pView->getPreferenceDlg()->getGeneralSettings(), &CGeneralSettingsWidget::doEnableNativeDialog, m_pModel->getSettingsManager(), &CSettingsManager::onUseNativeDlg);
     connect(m_pView->getPreferenceDlg()->getWorkflowSettings(), &CWorkflowSettingsWidget::doSetSaveFolder, m_pModel->getSettingsManager(), &CSettingsManager::onSetWorkflowSaveFolder);
+    connect(m_pView->getPreferenceDlg()->getWorkflowSettings(), &CWorkflowSettingsWidget::doSetBatchWorkerCount, m_pModel->getSettingsManager(), &CSettingsManager::onSetBatchWorkerCount);
+    connect(m_pView->getPreferenceDlg()->getWorkflowSettings(), &CWorkflowSettingsWidget::doSetBatchPrefetch, m_pModel->getSettingsManager(), &CSettingsManager::onSetBatchPrefetch);
+    connect(m_pView->getPreferenceDlg()->getWorkflowSettings(), &CWorkflowSettingsWidget::doSetCacheMemory, m_pModel->getSettingsManager(), &CSettingsManager::onSetWorkflowCacheMemory);
+    connect(m_pView->getPreferenceDlg()->getGeneralSettings(), &CGeneralSettingsWidget::doSetImageCacheMemory, m_pModel->getSettingsManager(), &CSettingsManager::onSetImageCacheMemory);
+    connect(m_pView->getPreferenceDlg()->getGeneralSettings(), &CGeneralSettingsWidget::doSetImageCacheMemory, m_pModel->getDataManager()->getImgMgr(), &CImgManager::onSetCacheMemory);
 
     // Manager -> preferences widget
     connect(m_pModel->getSettingsManager(), &CSettingsManager::doEnableTutorialHelper, m_pView->getPreferenceDlg()->getGeneralSettings(), &CGeneralSettingsWidget::onEnableTutorialHelper);
     connect(m_pModel->getSettingsManager(), &CSettingsManager::doEnableNativeDialog, m_pView->getPreferenceDlg()->getGeneralSettings(), &CGeneralSettingsWidget::onEnableNativeDialog);
     connect(m_pModel->getSettingsManager(), &CSettingsManager::doSetWorkflowSaveFolder, m_pView->getPreferenceDlg()->getWorkflowSettings(), &CWorkflowSettingsWidget::onSetSaveFolder);
+    connect(m_pModel->getSettingsManager(), &CSettingsManager::doSetBatchWorkerCount, m_pView->getPreferenceDlg()->getWorkflowSettings(), &CWorkflowSettingsWidget::onSetBatchWorkerCount);
+    connect(m_pModel->getSettingsManager(), &CSettingsManager::doSetBatchPrefetch, m_pView->getPreferenceDlg()->getWorkflowSettings(), &CWorkflowSettingsWidget::onSetBatchPrefetch);
+    connect(m_pModel->getSettingsManager(), &CSettingsManager::doSetWorkflowCacheMemory, m_pView->getPreferenceDlg()->getWorkflowSettings(), &CWorkflowSettingsWidget::onSetCacheMemory);
+    connect(m_pModel->getSettingsManager(), &CSettingsManager::doSetImageCacheMemory, m_pView->getPreferenceDlg()->getGeneralSettings(), &CGeneralSettingsWidget::onSetImageCacheMemory);
+
+    // Manager -> image cache
+    connect(m_pModel->getSettingsManager(), &CSettingsManager::doSetImageCacheMemory, m_pModel->getDataManager()->getImgMgr(), &CImgManager::onSetCacheMemory);
 }
 
 void CMainCtrl::initPluginConnections()
@@ -34,6 +34,7 @@ macx: ICON = $$PWD/Images/ikomia.icns
 SOURCES += \
         Model/CDbManager.cpp \
         Model/CMainModel.cpp \
+        Model/Log/CLogFileSink.cpp \
         Model/CMultiModel.cpp \
         Model/CTrainingMonitoring.cpp \
         Model/Crash/QBreakpadHandler.cpp \
@@ -55,36 +56,50 @@ SOURCES += \
         Model/Project/CDatasetItemDbMgr.cpp \
         Model/Project/CDimensionItemDbMgr.cpp \
         Model/Project/CProjectExportMgr.cpp \
+        Model/Process/CProcessLibraryCache.cpp \
         Model/Process/CProcessManager.cpp \
+        Model/Process/CProcessSearchIndex.cpp \
         Model/Project/CProjectViewProxyModel.cpp \
         Model/Render/CRenderManager.cpp \
         Model/Render/C3dAnimation.cpp \
         Model/ProgressBar/CProgressBarManager.cpp \
         Model/Graphics/CGraphicsManager.cpp \
         Model/Graphics/CGraphicsDbManager.cpp \
+        Model/Graphics/CGraphicsBurner.cpp \
         Model/Results/CResultManager.cpp \
         Model/Results/CResultDbManager.cpp \
+        Model/Results/CMeasureColumns.cpp \
         Model/User/CUserManager.cpp \
         Model/User/CUserSqlQueryModel.cpp \
         Model/User/CUser.cpp \
         Model/Data/CFeaturesTableModel.cpp \
         Model/Data/CMeasuresTableModel.cpp \
         Model/Data/Video/CLiveStreamItemDbMgr.cpp \
+        Model/Data/Video/CVideoFrameQueue.cpp \
+        Model/Data/Video/CVideoIndex.cpp \
         Model/Data/Video/CVideoItemDbMgr.cpp \
         Model/Data/Video/CVideoManager.cpp \
         Model/Data/Image/CImageItemDbMgr.cpp \
+        Model/Data/Image/CImageCache.cpp \
+        Model/Data/Image/CDisplayConversion.cpp \
+        Model/Data/Image/CThumbnailStore.cpp \
         Model/Data/Image/CImgManager.cpp \
         Model/Data/CMainDataManager.cpp \
         Model/Store/CStoreManager.cpp \
         Model/Store/CStoreQueryModel.cpp \
         Model/Store/CStoreDbManager.cpp \
         Model/Store/CStoreOnlineIconManager.cpp \
+        Model/Store/CZipArchive.cpp \
         Model/Wizard/CWizardManager.cpp \
         Model/Wizard/CWizardScenario.cpp \
         Model/Wizard/CWizardDbManager.cpp \
         Model/Wizard/CWizardQueryModel.cpp \
         Model/Wizard/CWizardStepModel.cpp \
         Model/Settings/CSettingsManager.cpp \
+        Model/Workflow/CBatchInputPrefetcher.cpp \
+        Model/Workflow/CBatchRunner.cpp \
+        Model/Workflow/CWorkflowOutputCache.cpp \
+        Model/Workflow/CWorkflowProfiler.cpp \
         Model/Workflow/CWorkflowDBManager.cpp \
         Model/Workflow/CWorkflowInput.cpp \
         Model/Workflow/CWorkflowInputViewManager.cpp \
@@ -104,6 +119,7 @@ SOURCES += \
         View/Modules/PluginManager/CCppPluginMaker.cpp \
         View/Modules/Workflow/CWorkflowView.cpp \
         View/Modules/Workflow/CWorkflowScene.cpp \
+        View/Modules/Workflow/CWorkflowTimelineWidget.cpp \
         View/Modules/Workflow/CWorkflowItem.cpp \
         View/Modules/Workflow/CWorkflowPortItem.cpp \
         View/Modules/Workflow/CWorkflowConnection.cpp \
@@ -157,6 +173,7 @@ SOURCES += \
         View/DoubleView/Image/CImageScene.cpp \
         View/DoubleView/Image/CImageView.cpp \
         View/DoubleView/Image/CImageViewSync.cpp \
+        View/DoubleView/Image/CTiledImageItem.cpp \
         View/DoubleView/Result/CResultTableView.cpp \
         View/DoubleView/Result/CResultTableDisplay.cpp \
         View/DoubleView/Result/CResultsViewer.cpp \
@@ -195,6 +212,7 @@ SOURCES += \
         View/Store/CStorePluginListView.cpp \
         View/Store/CStorePluginListViewDelegate.cpp \
         View/Notifications/CNotificationPopup.cpp \
+        View/Notifications/CLogListModel.cpp \
         View/Notifications/CNotificationPane.cpp \
         View/Wizard/CWizardPane.cpp \
         View/Wizard/CWizardTutoListView.cpp \
@@ -211,6 +229,9 @@ SOURCES += \
 HEADERS += \
         Model/CDbManager.h \
         Model/CMainModel.h \
+        Model/Log/CLogFileSink.h \
+        Model/Log/CLogQueue.hpp \
+        Model/Log/CLogStore.hpp \
         Model/CTrainingMonitoring.h \
         Model/CTreeItem.hpp \
         Model/CItem.hpp \
@@ -247,8 +268,10 @@ HEADERS += \
         Model/Project/CDimensionItemDbMgr.h \
         Model/Project/CProjectExportMgr.h \
         Model/Process/CProcessItem.hpp \
+        Model/Process/CProcessLibraryCache.h \
         Model/Process/CProcessManager.h \
         Model/Process/CProcessModel.hpp \
+        Model/Process/CProcessSearchIndex.h \
         Model/Project/CProjectViewProxyModel.h \
         Model/Render/CRenderManager.h \
         Model/Render/C3dAnimation.h \
@@ -256,11 +279,13 @@ HEADERS += \
         Model/Graphics/CGraphicsManager.h \
         Model/Graphics/CGraphicsLayerItem.hpp \
         Model/Graphics/CGraphicsDbManager.h \
+        Model/Graphics/CGraphicsBurner.h \
         Model/Graphics/CGraphicsLayerInfo.hpp \
         Model/Graphics/CGraphicsLayerInfo.hpp \
         Model/Results/CResultItem.hpp \
         Model/Results/CResultManager.h \
         Model/Results/CResultDbManager.h \
+        Model/Results/CMeasureColumns.h \
         Model/User/CUserManager.h \
         Model/User/CUserSqlQueryModel.h \
         Model/User/CUser.h \
@@ -273,10 +298,15 @@ HEADERS += \
         Model/Wizard/CWizardStepModel.h \
         Model/Data/Video/CLiveStreamItemDbMgr.h \
         Model/Data/Video/CVideoItem.hpp \
+        Model/Data/Video/CVideoFrameQueue.h \
+        Model/Data/Video/CVideoIndex.h \
         Model/Data/Video/CVideoItemDbMgr.h \
         Model/Data/Video/CVideoManager.h \
         Model/Data/Image/CImageItem.hpp \
         Model/Data/Image/CImageItemDbMgr.h \
+        Model/Data/Image/CImageCache.h \
+        Model/Data/Image/CDisplayConversion.h \
+        Model/Data/Image/CThumbnailStore.h \
         Model/Data/Image/CImgManager.h \
         Model/Data/Video/CLiveStreamItem.hpp \
         Model/Data/CMainDataManager.h \
@@ -284,8 +314,13 @@ HEADERS += \
         Model/Store/CStoreQueryModel.h \
         Model/Store/CStoreDbManager.h \
         Model/Store/CStoreOnlineIconManager.h \
+        Model/Store/CZipArchive.h \
         Model/Settings/CSettingsManager.h \
         Model/Wizard/Tutorials/CTutoStartingHelper.hpp \
+        Model/Workflow/CBatchInputPrefetcher.h \
+        Model/Workflow/CBatchRunner.h \
+        Model/Workflow/CWorkflowOutputCache.h \
+        Model/Workflow/CWorkflowProfiler.h \
         Model/Workflow/CWorkflowDBManager.h \
         Model/Workflow/CWorkflowInput.h \
         Model/Workflow/CWorkflowInputViewManager.h \
@@ -304,6 +339,7 @@ HEADERS += \
         View/Modules/PluginManager/PluginManagerDefine.hpp \
         View/Modules/Workflow/CWorkflowView.h \
         View/Modules/Workflow/CWorkflowScene.h \
+        View/Modules/Workflow/CWorkflowTimelineWidget.h \
         View/Modules/Workflow/CWorkflowItem.h \
         View/Modules/Workflow/CWorkflowPortItem.h \
         View/Modules/Workflow/CWorkflowConnection.h \
@@ -361,6 +397,7 @@ HEADERS += \
         View/DoubleView/Image/CImageScene.h \
         View/DoubleView/Image/CImageView.h \
         View/DoubleView/Image/CImageViewSync.h \
+        View/DoubleView/Image/CTiledImageItem.h \
         View/DoubleView/Image/CImageExportDlg.h \
         View/DoubleView/3D/C3dDisplay.h \
         View/DoubleView/3D/C3dAnimationDlg.h \
@@ -407,6 +444,7 @@ HEADERS += \
         View/Store/CStorePluginListView.h \
         View/Store/CStorePluginListViewDelegate.h \
         View/Notifications/CNotificationPopup.h \
+        View/Notifications/CLogListModel.h \
         View/Notifications/CNotificationPane.h \
         Controller/CMainCtrl.h \
         Main/AppDefine.hpp \
@@ -468,6 +506,11 @@ macx: LIBS += -framework OpenCL
 ########
 win32: LIBS += -lOpenGL32
 
+#########################
+#Process memory counters
+#########################
+win32: LIBS += -lpsapi
+
 ######
 #Curl
 ######
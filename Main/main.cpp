@@ -28,6 +28,7 @@
 #include "View/Common/CCrashReporDlg.h"
 #include "Model/Crash/QBreakpadHandler.h"
 #include "Model/Matomo/piwiktracker.h"
+#include "Model/Workflow/CBatchRunner.h"
 
 inline int myErrorHandler(int /*status*/, const char* /*func_name*/, const char* /*err_msg*/,
                    const char* /*file_name*/, int /*line*/, void*)
@@ -36,8 +37,44 @@ inline int myErrorHandler(int /*status*/, const char* /*func_name*/, const char*
     return 0;
 }
 
+inline void registerMetaTypes()
+{
+    qRegisterMetaType<WorkflowVertex>("WorkflowVertex");
+    qRegisterMetaType<CWorkflowTask::State>("CWorkflowTask::State");
+    qRegisterMetaType<QVector<int>>();
+    qRegisterMetaType<QVector<quint64>>();
+    qRegisterMetaType<QTextBlock>("QTextBlock");
+    qRegisterMetaType<QTextCursor>("QTextCursor");
+    qRegisterMetaType<CMat>("CMat");
+}
+
+inline void setApplicationInfo()
+{
+    QCoreApplication::setOrganizationName("Ikomia");
+    QCoreApplication::setOrganizationDomain("www.ikomia.com");
+    QCoreApplication::setApplicationVersion(Utils::IkomiaApp::getCurrentVersionName());
+    QCoreApplication::setApplicationName("Ikomia Studio");
+}
+
+// Headless batch mode: no widget, OpenGL, splash screen or translation setup
+inline int runBatch(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QThreadPool::globalInstance()->setStackSize(8*1024*1024);
+    registerMetaTypes();
+    std::setlocale(LC_NUMERIC, "C");
+    cv::redirectError(myErrorHandler);
+    setApplicationInfo();
+
+    CBatchRunner runner;
+    return runner.exec(app.arguments());
+}
+
 int main(int argc, char *argv[])
 {
+    if(CBatchRunner::isBatchCommand(argc, argv))
+        return runBatch(argc, argv);
+
     const QColor orange(204,90,32,255);
 
 #ifdef Q_OS_MACOS
@@ -56,12 +93,7 @@ int main(int argc, char *argv[])
     QThreadPool::globalInstance()->setStackSize(8*1024*1024);
 
     // Meta registration
-    qRegisterMetaType<WorkflowVertex>("WorkflowVertex");
-    qRegisterMetaType<CWorkflowTask::State>("CWorkflowTask::State");
-    qRegisterMetaType<QVector<int>>();
-    qRegisterMetaType<QTextBlock>("QTextBlock");
-    qRegisterMetaType<QTextCursor>("QTextCursor");
-    qRegisterMetaType<CMat>("CMat");
+    registerMetaTypes();
 
     //Set locale LC_Numeric to force . as decimal separator
     std::setlocale(LC_NUMERIC, "C");
@@ -128,10 +160,7 @@ int main(int argc, char *argv[])
     QApplication::setFont(font);
 
     // QSettings
-    QApplication::setOrganizationName("Ikomia");
-    QApplication::setOrganizationDomain("www.ikomia.com");
-    QApplication::setApplicationVersion(Utils::IkomiaApp::getCurrentVersionName());
-    QApplication::setApplicationName("Ikomia Studio");
+    setApplicationInfo();
 
     // Instantiate CMainView first to have initialization messages in the notification center
     CMainView view;
@@ -47,6 +47,7 @@ class CItem
             m_pix = item.m_pix;
             m_bChecked = item.m_bChecked;
             m_bHighlighted = item.m_bHighlighted;
+            m_bModified = true;
         }
         CItem(CItem&& item)
         {
@@ -56,6 +57,7 @@ class CItem
             m_pix = std::move(item.m_pix);
             m_bChecked = std::move(item.m_bChecked);
             m_bHighlighted = std::move(item.m_bHighlighted);
+            m_bModified = true;
         }
 
         //Destructors
@@ -76,10 +78,15 @@ class CItem
             std::swap(first.m_pix, second.m_pix);
             std::swap(first.m_bChecked, second.m_bChecked);
             std::swap(first.m_bHighlighted, second.m_bHighlighted);
+            std::swap(first.m_bModified, second.m_bModified);
         }
 
         //Setters
-        virtual void            setName(const std::string& name) { m_name = name; }
+        virtual void            setName(const std::string& name)
+        {
+            m_name = name;
+            m_bModified = true;
+        }
         void                    setIconPixmap(QPixmap pix) { m_pix = pix; }
         void                    setChecked(bool bChecked)
         {
@@ -90,6 +97,8 @@ class CItem
             m_bHighlighted = bHighlighted;
         }
         void                    setDbId(int id) { m_dbId = id; }
+        //Dirty flag: item has to be written on next incremental project save
+        void                    setModified(bool bModified) { m_bModified = bModified; }
 
         //Getters
         virtual TreeItemType    getTypeId() const { return TreeItemType::NONE; }
@@ -111,6 +120,10 @@ class CItem
         {
             return m_bHighlighted;
         }
+        bool                    isModified() const
+        {
+            return m_bModified;
+        }
 
     protected:
 
@@ -128,6 +141,7 @@ class CItem
         QPixmap             m_pix;
         bool                m_bChecked = true;
         bool                m_bHighlighted = false;
+        bool                m_bModified = true;
 };
 
 #endif // CITEM_HPP
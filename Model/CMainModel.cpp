@@ -217,6 +217,9 @@ void CMainModel::initLogFile()
     if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
         return;
 
+    file.close();
+    m_logSink.start(QString::fromStdString(m_logFilePath));
+
     // Write all Qt Message in log file
     qInstallMessageHandler(logMessageOutput);
     CLogManager::instance().addOutputManager(std::bind(&CMainModel::writeLogMsg, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
@@ -306,6 +309,11 @@ void CMainModel::initPython()
 
     emit doSetSplashMessage(tr("Configure Python environment..."), Qt::AlignCenter, qApp->palette().highlight().color());
     QCoreApplication::processEvents();
+    initPythonInterpreter();
+}
+
+void CMainModel::initPythonInterpreter()
+{
     QString pythonPath = Utils::IkomiaApp::getQIkomiaFolder() + "/Python";
     std::string pythonExe;
     std::string pythonLib;
@@ -457,20 +465,8 @@ void CMainModel::initMatomo()
 
 void CMainModel::writeLogMsg(int type, const QString& msg, const QString& categoryName)
 {
-    Q_UNUSED(categoryName);
-    Q_UNUSED(type);
-
-    QFile file(QString::fromStdString(m_logFilePath));
-    if(!file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text))
-        return;
-
-    auto date = QDate::currentDate();
-    auto time = QTime::currentTime();
-    QString str = date.toString(Qt::ISODate) + " " + time.toString(Qt::ISODate) + ": " + msg;
-
-    QTextStream out(&file);
-    out << str << "\n";
-    file.close();
+    // Called from any thread: file is written asynchronously, except critical and fatal messages
+    m_logSink.write(type, msg, categoryName);
 }
 
 void CMainModel::checkUserInstall()
@@ -37,6 +37,7 @@
 #include "Store/CStoreManager.h"
 #include "Settings/CSettingsManager.h"
 #include "Model/CDbManager.h"
+#include "Model/Log/CLogFileSink.h"
 
 /**
  * @brief
@@ -73,6 +74,9 @@ class CMainModel : public QObject
 
         void                    notifyViewShow();
 
+        // Interpreter setup only: no user install check, usable without GUI
+        static void             initPythonInterpreter();
+
     signals:
 
         void                    doSetSplashMessage(const QString &message, int alignment, const QColor &color);
@@ -111,6 +115,8 @@ class CMainModel : public QObject
 
     private:
 
+        // First member: destroyed last as managers may log on destruction
+        CLogFileSink            m_logSink;
         CDbManager              m_dbMgr;
         CProjectManager         m_projectMgr;
         CProcessManager         m_processMgr;
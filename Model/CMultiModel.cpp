@@ -60,6 +60,14 @@ void CMultiModel::TreeItem::clearChildren()
     assert(m_children.capacity() == 0);
 }
 
+void CMultiModel::TreeItem::clearSource()
+{
+    // Wrapped items are deleted: back to row-based resolution
+    m_pSource = nullptr;
+    for(auto& it : m_children)
+        it->clearSource();
+}
+
 void CMultiModel::TreeItem::insertChild(CMultiModel::TreeItem *pItem, int position)
 {
     assert(pItem);
@@ -142,22 +150,18 @@ void CMultiModel::addSubModelToTree( TreeItem * pParentItem, QAbstractItemModel
 	if ( pModel )
 	{
         int	nKids = pModel->rowCount( index );
-		if ( nKids )
+        // Rows already present in tree are contiguous (this function is called from addModel and from rowCount)
+        int firstKid = (pParentItem != m_pRootItem) ? pParentItem->m_children.size() : 0;
+        if ( nKids > firstKid )
 		{
-            for ( int nKid = 0; nKid < nKids; ++nKid )
+            // Exact allocation: the shadow tree can hold a lot of items
+            pParentItem->m_children.reserve( pParentItem->m_children.size() + nKids - firstKid );
+
+            for ( int nKid = firstKid; nKid < nKids; ++nKid )
 			{
-                // Test if already present in tree (because this function is called from addModel and from rowCount)
-                bool bIsPresent = false;
-                for(auto& it : pParentItem->m_children)
-                {
-                    if(it->m_nRow == nKid && pParentItem != m_pRootItem)
-                        bIsPresent = true;
-                }
-                if(bIsPresent == false)
-                {
-                    TreeItem *	pChildItem = new TreeItem( pModel, nKid, pParentItem );
-                    pParentItem->m_children.push_back( pChildItem );
-                }
+                TreeItem *	pChildItem = new TreeItem( pModel, nKid, pParentItem );
+                pChildItem->m_pSource = pModel->index( nKid, 0, index ).internalPointer();
+                pParentItem->m_children.push_back( pChildItem );
 			}
         }
     }
@@ -311,42 +315,44 @@ QVariant CMultiModel::data( const QModelIndex & index, int role ) const
 
 QModelIndex CMultiModel::wrappedIndex( TreeItem * pTreeItem, QAbstractItemModel * pModel, const QModelIndex & index  ) const
 {
-	// We need to map our index into the appropriate index in the wrapped model
-	// To do this, we recurse up the tree until we get to ourself (MultiModel),
-	// keeping track of the row numbers in the wrapped model.  We then go back 
-	// down through the wrapped model to retrieve -its- index that corresponds
-	// to the same location in its tree
-
-	// Row numbers are pushed onto the -front- of the vector as we work our way
-	// bottom-up through the tree, so that when we iterate over them, they come 
-	// off in top-down order.
-	// 
-    QVector< int >	rows;
-    // If parent is root, we set 0 because a project index always start at row 0
-    if(pTreeItem->m_pParent == m_pRootItem)
-        rows.push_front(0);
-    else
+    // Direct link to the wrapped item: no need to walk the tree.
+    // If parent is root, row is 0 because a project index always start at row 0
+    if ( pTreeItem->m_pSource )
     {
-        rows.push_front( pTreeItem->m_nRow );
-
-        TreeItem *	pTreeParent = pTreeItem->m_pParent;
-        while ( pTreeParent->m_pParent != m_pRootItem )
-        {
-            rows.push_front( pTreeParent->m_nRow );
-            pTreeParent = pTreeParent->m_pParent;
-        }
-        // We stop when parent is root and we set 0 because we always start at 0 index in submodel
-        rows.push_front(0);
+        int row = (pTreeItem->m_pParent == m_pRootItem) ? 0 : pTreeItem->m_nRow;
+        QModelIndex wrapped = createWrappedIndex( pModel, row, index.column(), pTreeItem->m_pSource );
+        if ( wrapped.isValid() )
+            return wrapped;
     }
 
-	// Now, work down the wrapped model tree to the correct index
-	QModelIndex	wrapped;
-	QVector< int >::const_iterator	it = rows.begin();
-	QVector< int >::const_iterator	eIt = rows.end();
-	while ( it != eIt )
-		wrapped = pModel->index( *it++, index.column(), wrapped );
+    QModelIndex wrapped = findWrappedIndex( pTreeItem, pModel, index.column() );
+    // Link is stored for next calls
+    if ( wrapped.isValid() && index.column() == 0 )
+        pTreeItem->m_pSource = wrapped.internalPointer();
+
+    return wrapped;
+}
 
-	return wrapped;
+QModelIndex CMultiModel::createWrappedIndex( QAbstractItemModel * pModel, int row, int col, void * pSource ) const
+{
+    Q_UNUSED(pModel);
+    Q_UNUSED(row);
+    Q_UNUSED(col);
+    Q_UNUSED(pSource);
+    return QModelIndex();
+}
+
+QModelIndex CMultiModel::findWrappedIndex( TreeItem * pTreeItem, QAbstractItemModel * pModel, int col ) const
+{
+    // We map our index into the appropriate index in the wrapped model by
+    // resolving the parent first, then the row number of the item in the
+    // wrapped model. We stop when parent is root and we set 0 because
+    // we always start at 0 index in submodel
+    if ( pTreeItem->m_pParent == m_pRootItem )
+        return pModel->index( 0, col );
+
+    QModelIndex wrappedParent = findWrappedIndex( pTreeItem->m_pParent, pModel, 0 );
+    return pModel->index( pTreeItem->m_nRow, col, wrappedParent );
 }
 
 void CMultiModel::printTree() const
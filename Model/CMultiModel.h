@@ -40,12 +40,14 @@ class CMultiModel :	public QAbstractItemModel
                 ~TreeItem();
 
                 void    clearChildren();
+                void    clearSource();
                 void    insertChild(TreeItem* pItem, int position);
                 void    eraseChild(int position);
 
                 QAbstractItemModel *		m_pModel = nullptr;     // Wrapped model or "this", depending on level in tree
                 int							m_nRow;                 // Row number of item with respect to level
                 TreeItem *					m_pParent = nullptr;	// Back pointer to parent of this item
+                void *                      m_pSource = nullptr;    // Internal pointer of the wrapped index (direct link)
                 QVector< TreeItem * >       m_children;             // Forward pointers to children of this item
         };
 
@@ -70,10 +72,17 @@ class CMultiModel :	public QAbstractItemModel
 
     protected:
 
+        // Build the wrapped index from the direct link, return invalid index if the wrapped model doesn't support it
+        virtual QModelIndex createWrappedIndex( QAbstractItemModel * pModel, int row, int col, void * pSource ) const;
+
         void                addSubModelToTree( TreeItem * pParentItem, QAbstractItemModel * pModel, const QModelIndex & index = QModelIndex() );
         void                addModelToTree(TreeItem * pParentItem, QAbstractItemModel * pModel);
         void                printTree( TreeItem * pItem, int level ) const;
 
+    private:
+
+        QModelIndex         findWrappedIndex( TreeItem * pTreeItem, QAbstractItemModel * pModel, int col ) const;
+
     protected:
 
         TreeItem *	m_pRootItem = nullptr;                        // Root of the tree; initially empty
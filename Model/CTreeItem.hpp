@@ -149,6 +149,11 @@ class CTreeItem : public std::enable_shared_from_this< CTreeItem<types...> >
             auto visitor = make_forwarding_visitor<bool>([](const auto& t){ return t->isHighlighted();});
             return boost::apply_visitor(visitor, m_node);
         }
+        bool            isModified() const
+        {
+            auto visitor = make_forwarding_visitor<bool>([](const auto& t){ return t->isModified();});
+            return boost::apply_visitor(visitor, m_node);
+        }
 
         void            setName(const std::string& name)
         {
@@ -165,17 +170,29 @@ class CTreeItem : public std::enable_shared_from_this< CTreeItem<types...> >
             auto visitor = make_forwarding_visitor<void>([bHighlighted](const auto& t){ t->setHighlighted(bHighlighted);});
             return boost::apply_visitor(visitor, m_node);
         }
+        void            setDbId(int id)
+        {
+            auto visitor = make_forwarding_visitor<void>([id](const auto& t){ t->setDbId(id);});
+            return boost::apply_visitor(visitor, m_node);
+        }
+        void            setModified(bool bModified)
+        {
+            auto visitor = make_forwarding_visitor<void>([bModified](const auto& t){ t->setModified(bModified);});
+            return boost::apply_visitor(visitor, m_node);
+        }
 
         void            clearChildren()
         {
             for(auto&& it : m_children)
                 it->clearChildren();
             m_children.clear();
+            setModified(true);
         }
 
         void            erase(int pos)
         {
             m_children.erase(m_children.begin()+pos);
+            setModified(true);
         }
 
         template<typename T>
@@ -199,6 +216,7 @@ class CTreeItem : public std::enable_shared_from_this< CTreeItem<types...> >
         void            emplace_back(T &&t)
         {
             m_children.emplace_back(std::make_shared<self>(self::shared_from_this(), std::forward<T>(t)));
+            setModified(true);
         }
 
         template<class T>
@@ -208,6 +226,8 @@ class CTreeItem : public std::enable_shared_from_this< CTreeItem<types...> >
                 m_children.insert(m_children.begin()+pos, std::make_shared<self>(self::shared_from_this(), t));
             else
                 m_children.push_back(std::make_shared<self>(self::shared_from_this(), t));
+
+            setModified(true);
         }
 
         void            insert(item_t item, size_t pos)
@@ -216,6 +236,8 @@ class CTreeItem : public std::enable_shared_from_this< CTreeItem<types...> >
                 m_children.insert(m_children.begin()+pos, item);
             else
                 m_children.push_back(item);
+
+            setModified(true);
         }
 
         void            move(item_t newParent)
@@ -236,6 +236,19 @@ class CTreeModel : public QAbstractItemModel
                 return createIndex(p->getRow(), 0, (void*)p.get());
         }
 
+        QModelIndex createItemIndex(int row, int column, void* pItem) const
+        {
+            return createIndex(row, column, pItem);
+        }
+
+        QModelIndex getLastChildIndex(std::shared_ptr<TreeItem> parent)
+        {
+            if(parent == nullptr || parent->getChildCount() == 0)
+                return QModelIndex();
+
+            return createIndex(parent->getChildCount() - 1, 0, (void*)parent->getLastChild().get());
+        }
+
         template<class T>
         void emplace_back(const QModelIndex &index, T&& t)
         {
@@ -168,6 +168,7 @@ void CMainDataManager::displayImageSequence(const QModelIndex& index, size_t inp
 
 void CMainDataManager::beforeProjectClose(int projectIndex, bool bWithCurrentImage)
 {
+    m_imgMgr.beforeProjectClose();
     m_videoMgr.beforeProjectClose(projectIndex, bWithCurrentImage);
 }
 
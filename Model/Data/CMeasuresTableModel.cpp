@@ -18,6 +18,77 @@
 
 #include "CMeasuresTableModel.h"
 
-CMeasuresTableModel::CMeasuresTableModel(QObject *parent) : QSqlQueryModel(parent)
+CMeasuresTableModel::CMeasuresTableModel(QObject *parent) : QAbstractTableModel(parent)
 {
 }
+
+void CMeasuresTableModel::setColumns(const CMeasureColumns &columns)
+{
+    beginResetModel();
+    m_columns = columns;
+    endResetModel();
+}
+
+int CMeasuresTableModel::rowCount(const QModelIndex &parent) const
+{
+    if(parent.isValid())
+        return 0;
+
+    return static_cast<int>(m_columns.getObjectCount());
+}
+
+int CMeasuresTableModel::columnCount(const QModelIndex &parent) const
+{
+    if(parent.isValid())
+        return 0;
+
+    return m_fixedColumnCount + static_cast<int>(m_columns.getColumnCount());
+}
+
+QVariant CMeasuresTableModel::data(const QModelIndex &index, int role) const
+{
+    if(!index.isValid() || role != Qt::DisplayRole)
+        return QVariant();
+
+    size_t row = static_cast<size_t>(index.row());
+    switch(index.column())
+    {
+        case 0: return index.row() + 1;
+        case 1: return m_columns.getObjectId(row);
+        case 2: return m_columns.getLabel(row);
+    }
+
+    // Values are read in place from the column buffer
+    size_t count = 0;
+    const double* pValues = m_columns.getValues(static_cast<size_t>(index.column() - m_fixedColumnCount), row, count);
+
+    if(count == 0)
+        return QVariant();
+    else if(count == 1)
+        return pValues[0];
+
+    QStringList values;
+    for(size_t i=0; i<count; ++i)
+        values.push_back(QString::number(pValues[i]));
+
+    return values.join(";");
+}
+
+QVariant CMeasuresTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if(role != Qt::DisplayRole || orientation != Qt::Horizontal)
+        return QAbstractTableModel::headerData(section, orientation, role);
+
+    switch(section)
+    {
+        case 0: return tr("Id");
+        case 1: return tr("Object");
+        case 2: return tr("Category");
+    }
+
+    size_t col = static_cast<size_t>(section - m_fixedColumnCount);
+    if(col < m_columns.getColumnCount())
+        return m_columns.getColumn(col).m_name;
+
+    return QVariant();
+}
@@ -21,13 +21,27 @@
 #ifndef CMEASURESTABLEMODEL_H
 #define CMEASURESTABLEMODEL_H
 
-#include <QSqlQueryModel>
+#include <QAbstractTableModel>
+#include "Model/Results/CMeasureColumns.h"
 
-class CMeasuresTableModel : public QSqlQueryModel
+class CMeasuresTableModel : public QAbstractTableModel
 {
     public:
 
         CMeasuresTableModel(QObject* parent=Q_NULLPTR);
+
+        void        setColumns(const CMeasureColumns& columns);
+
+        int         rowCount(const QModelIndex &parent = QModelIndex()) const override;
+        int         columnCount(const QModelIndex &parent = QModelIndex()) const override;
+        QVariant    data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+        QVariant    headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    private:
+
+        // Id, Object and Category columns before measures
+        const int       m_fixedColumnCount = 3;
+        CMeasureColumns m_columns;
 };
 
 #endif // CMEASURESTABLEMODEL_H
@@ -0,0 +1,121 @@
+// Copyright (C) 2021 Ikomia SAS
+// Contact: https://www.ikomia.com
+//
+// This file is part of the IkomiaStudio software.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "CDisplayConversion.h"
+#include <limits>
+#include "Data/CDataConversion.h"
+
+namespace
+{
+    //Under this size, splitting is not worth it
+    const int minParallelPixels = 512 * 512;
+
+    void releaseMat(void* pInfo)
+    {
+        delete static_cast<CMat*>(pInfo);
+    }
+}
+
+QImage CDisplayConversion::toQImage(const CMat &image, bool bShareBuffer)
+{
+    if(!image.data || image.dims > 2)
+        return CDataConversion::CMatToQImage(image);
+
+    const int channels = image.channels();
+    if(channels != 1 && channels != 3 && channels != 4)
+        return CDataConversion::CMatToQImage(image);
+
+    if(image.depth() == CV_8U)
+    {
+        QImage qimage = wrap(image);
+        if(qimage.isNull() == false)
+            return bShareBuffer ? qimage : qimage.copy();
+
+        return CDataConversion::CMatToQImage(image);
+    }
+    return wrap(toDisplayDepth(image));
+}
+
+QImage CDisplayConversion::wrap(const CMat &image)
+{
+    //QImage requires 32 bits aligned buffers
+    if(reinterpret_cast<quintptr>(image.data) % 4 != 0)
+        return QImage();
+
+    QImage::Format format;
+    switch(image.channels())
+    {
+        case 1: format = QImage::Format_Grayscale8; break;
+        case 3: format = QImage::Format_RGB888; break;
+        case 4: format = QImage::Format_RGBA8888; break;
+        default: return QImage();
+    }
+
+    //Buffer is shared: the copy of the CMat header is released with the image.
+    //Read-only constructor: any write to the QImage detaches from the CMat buffer
+    CMat* pOwner = new CMat(image);
+    return QImage(static_cast<const uchar*>(pOwner->data), pOwner->cols, pOwner->rows, (int)pOwner->step[0], format, releaseMat, pOwner);
+}
+
+CMat CDisplayConversion::toDisplayDepth(const CMat &image)
+{
+    //Stripes of rows processed in parallel: vectorized min-max then vectorized scaling
+    const int stripeCount = (image.total() < (size_t)minParallelPixels) ? 1 : std::max(1, cv::getNumThreads());
+    const int stripeRows = (image.rows + stripeCount - 1) / stripeCount;
+    std::vector<double> mins(stripeCount, 0.0), maxs(stripeCount, 0.0);
+
+    cv::parallel_for_(cv::Range(0, stripeCount), [&](const cv::Range& range)
+    {
+        for(int i=range.start; i<range.end; ++i)
+        {
+            int start = i * stripeRows;
+            int end = std::min(image.rows, start + stripeRows);
+            if(start >= end)
+            {
+                mins[i] = std::numeric_limits<double>::max();
+                maxs[i] = std::numeric_limits<double>::lowest();
+                continue;
+            }
+            //All channels share the same window
+            cv::Mat stripe = image.rowRange(start, end);
+            cv::minMaxLoc(stripe.reshape(1), &mins[i], &maxs[i]);
+        }
+    });
+
+    double minVal = *std::min_element(mins.begin(), mins.end());
+    double maxVal = *std::max_element(maxs.begin(), maxs.end());
+    double scale = (maxVal > minVal) ? 255.0 / (maxVal - minVal) : 1.0;
+    double shift = -minVal * scale;
+
+    CMat display;
+    display.create(image.rows, image.cols, CV_MAKETYPE(CV_8U, image.channels()));
+    cv::parallel_for_(cv::Range(0, stripeCount), [&](const cv::Range& range)
+    {
+        for(int i=range.start; i<range.end; ++i)
+        {
+            int start = i * stripeRows;
+            int end = std::min(image.rows, start + stripeRows);
+            if(start >= end)
+                continue;
+
+            cv::Mat dst = display.rowRange(start, end);
+            image.rowRange(start, end).convertTo(dst, CV_8U, scale, shift);
+        }
+    });
+    return display;
+}
@@ -0,0 +1,44 @@
+/*
+ * Copyright (C) 2021 Ikomia SAS
+ * Contact: https://www.ikomia.com
+ *
+ * This file is part of the IkomiaStudio software.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CDISPLAYCONVERSION_H
+#define CDISPLAYCONVERSION_H
+
+#include <QImage>
+#include "Data/CMat.hpp"
+
+//Conversion of images for display.
+//8 bits images are wrapped without copy: the QImage shares the CMat buffer (read-only, writes detach)
+//and keeps it alive. Buffers reused by their producer (video and live stream frames) must not be shared.
+//Other depths are windowed (min-max) to 8 bits in a single parallel pass per stage.
+//Unsupported layouts fall back to CDataConversion::CMatToQImage.
+class CDisplayConversion
+{
+    public:
+
+        static QImage   toQImage(const CMat& image, bool bShareBuffer = true);
+
+    private:
+
+        static QImage   wrap(const CMat& image);
+        static CMat     toDisplayDepth(const CMat& image);
+};
+
+#endif // CDISPLAYCONVERSION_H
@@ -0,0 +1,261 @@
+// Copyright (C) 2021 Ikomia SAS
+// Contact: https://www.ikomia.com
+//
+// This file is part of the IkomiaStudio software.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "CImageCache.h"
+#include <QtConcurrent/QtConcurrent>
+#include <QFileInfo>
+#include "CDisplayConversion.h"
+
+CImageCache::CImageCache()
+{
+    m_pool.setMaxThreadCount(2);
+}
+
+CImageCache::~CImageCache()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_wanted.clear();
+    }
+    m_pool.clear();
+    m_pool.waitForDone();
+}
+
+void CImageCache::setMaxMemory(size_t maxMemory)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_maxMemory = maxMemory;
+
+    if(m_maxMemory == 0)
+    {
+        m_wanted.clear();
+        m_entries.clear();
+        m_lru.clear();
+        m_memory = 0;
+    }
+    else
+        evict();
+}
+
+CMat CImageCache::getImage(const std::string &path, const SubsetBounds &bounds, CDataInfoPtr &infoPtr)
+{
+    auto key = makeKey(path, bounds);
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        waitPending(lock, key);
+
+        //Cached buffer is private: callers (workflow inputs) may write their image in place
+        auto pEntry = find(key);
+        if(pEntry)
+        {
+            infoPtr = pEntry->m_infoPtr;
+            return pEntry->m_image.clone();
+        }
+    }
+
+    //Cache miss: decode in caller thread
+    auto entry = decode(path);
+    CMat image = entry.m_image.clone();
+    infoPtr = entry.m_infoPtr;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    insert(key, std::move(entry));
+    return image;
+}
+
+QImage CImageCache::getDisplayImage(const std::string &path, const SubsetBounds &bounds, const CMat &image)
+{
+    auto key = makeKey(path, bounds);
+    CMat cachedImage;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto pEntry = find(key);
+        if(pEntry)
+        {
+            if(pEntry->m_displayImage.isNull() == false)
+                return pEntry->m_displayImage;
+
+            cachedImage = pEntry->m_image;
+        }
+    }
+
+    //Cached display image is built from the cache private buffer, not from the caller one
+    if(cachedImage.data == nullptr)
+        return CDisplayConversion::toQImage(image);
+
+    QImage displayImage = CDisplayConversion::toQImage(cachedImage);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto pEntry = find(key);
+    if(pEntry && pEntry->m_displayImage.isNull())
+    {
+        m_memory -= pEntry->m_memory;
+        pEntry->m_displayImage = displayImage;
+        pEntry->m_memory = getMemorySize(*pEntry);
+        m_memory += pEntry->m_memory;
+        evict();
+    }
+    return displayImage;
+}
+
+void CImageCache::prefetch(const std::vector<CacheItem> &items)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    //Previous requests not started yet are dropped
+    m_wanted.clear();
+
+    if(m_maxMemory == 0)
+        return;
+
+    for(auto&& item : items)
+    {
+        auto key = makeKey(item.first, item.second);
+        m_wanted.insert(key);
+
+        if(m_entries.find(key) != m_entries.end() || m_pending.find(key) != m_pending.end())
+            continue;
+
+        m_pending.insert(key);
+        auto path = item.first;
+
+        QtConcurrent::run(&m_pool, [this, key, path]
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if(m_wanted.find(key) == m_wanted.end())
+                {
+                    m_pending.erase(key);
+                    m_cond.notify_all();
+                    return;
+                }
+            }
+
+            CEntry entry;
+            bool bDecoded = false;
+
+            try
+            {
+                entry = decode(path);
+                entry.m_displayImage = CDisplayConversion::toQImage(entry.m_image);
+                entry.m_memory = getMemorySize(entry);
+                bDecoded = true;
+            }
+            catch(std::exception&)
+            {
+                //Error will be reported if the image is requested for display
+            }
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if(bDecoded)
+                insert(key, std::move(entry));
+
+            m_pending.erase(key);
+            m_cond.notify_all();
+        });
+    }
+}
+
+void CImageCache::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_wanted.clear();
+    m_entries.clear();
+    m_lru.clear();
+    m_memory = 0;
+}
+
+std::string CImageCache::makeKey(const std::string &path, const SubsetBounds &bounds) const
+{
+    //Modification time and size: images edited on disk are decoded again
+    QFileInfo info(QString::fromStdString(path));
+    std::string key = path + "|" + std::to_string(info.lastModified().toMSecsSinceEpoch()) + "|" + std::to_string(info.size());
+    for(auto&& it : bounds)
+        key += "|" + std::to_string(it.second.first) + "," + std::to_string(it.second.second);
+
+    return key;
+}
+
+CImageCache::CEntry CImageCache::decode(const std::string &path) const
+{
+    CEntry entry;
+    CImageDataIO io(path);
+    entry.m_image = io.read();
+    entry.m_infoPtr = io.dataInfo();
+    entry.m_memory = getMemorySize(entry);
+    return entry;
+}
+
+CImageCache::CEntry *CImageCache::find(const std::string &key)
+{
+    auto it = m_entries.find(key);
+    if(it == m_entries.end())
+        return nullptr;
+
+    //Most recently used first
+    m_lru.splice(m_lru.begin(), m_lru, it->second.second);
+    return &it->second.first;
+}
+
+void CImageCache::insert(const std::string &key, CEntry &&entry)
+{
+    //Cache disabled
+    if(m_maxMemory == 0)
+        return;
+
+    auto it = m_entries.find(key);
+    if(it != m_entries.end())
+    {
+        m_memory -= it->second.first.m_memory;
+        m_lru.erase(it->second.second);
+        m_entries.erase(it);
+    }
+
+    m_lru.push_front(key);
+    m_memory += entry.m_memory;
+    m_entries.emplace(key, std::make_pair(std::move(entry), m_lru.begin()));
+    evict();
+}
+
+void CImageCache::evict()
+{
+    //Most recent entry is kept even if it exceeds the budget
+    while(m_memory > m_maxMemory && m_lru.size() > 1)
+    {
+        auto it = m_entries.find(m_lru.back());
+        if(it != m_entries.end())
+        {
+            m_memory -= it->second.first.m_memory;
+            m_entries.erase(it);
+        }
+        m_lru.pop_back();
+    }
+}
+
+void CImageCache::waitPending(std::unique_lock<std::mutex> &lock, const std::string &key)
+{
+    m_cond.wait(lock, [this, &key]{ return m_pending.find(key) == m_pending.end(); });
+}
+
+size_t CImageCache::getMemorySize(const CEntry &entry) const
+{
+    size_t size = entry.m_image.total() * entry.m_image.elemSize();
+    if(entry.m_displayImage.isNull() == false)
+        size += static_cast<size_t>(entry.m_displayImage.sizeInBytes());
+
+    return size;
+}
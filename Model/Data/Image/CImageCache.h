@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2021 Ikomia SAS
+ * Contact: https://www.ikomia.com
+ *
+ * This file is part of the IkomiaStudio software.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CIMAGECACHE_H
+#define CIMAGECACHE_H
+
+#include <QImage>
+#include <QThreadPool>
+#include <list>
+#include <set>
+#include <unordered_map>
+#include <mutex>
+#include <condition_variable>
+#include "CImageDataManager.h"
+
+//Thread-safe LRU cache of decoded images and of their display conversion.
+//Entries are keyed by file path, modification time, size and subset bounds, neighbour images are decoded on worker threads.
+//Images are returned as copies of the cached buffers. A maximum memory of 0 disables the cache.
+class CImageCache
+{
+    public:
+
+        using CacheItem = std::pair<std::string, SubsetBounds>;
+
+        CImageCache();
+        ~CImageCache();
+
+        void            setMaxMemory(size_t maxMemory);
+
+        CMat            getImage(const std::string& path, const SubsetBounds& bounds, CDataInfoPtr& infoPtr);
+        QImage          getDisplayImage(const std::string& path, const SubsetBounds& bounds, const CMat& image);
+
+        void            prefetch(const std::vector<CacheItem>& items);
+        void            clear();
+
+    private:
+
+        struct CEntry
+        {
+            CMat            m_image;
+            QImage          m_displayImage;
+            CDataInfoPtr    m_infoPtr = nullptr;
+            size_t          m_memory = 0;
+        };
+
+        using LruList = std::list<std::string>;
+        using EntryMap = std::unordered_map<std::string, std::pair<CEntry, LruList::iterator>>;
+
+        std::string     makeKey(const std::string& path, const SubsetBounds& bounds) const;
+
+        CEntry          decode(const std::string& path) const;
+
+        //Following methods require m_mutex to be locked
+        CEntry*         find(const std::string& key);
+        void            insert(const std::string& key, CEntry&& entry);
+        void            evict();
+        void            waitPending(std::unique_lock<std::mutex>& lock, const std::string& key);
+
+        size_t          getMemorySize(const CEntry& entry) const;
+
+    private:
+
+        std::mutex              m_mutex;
+        std::condition_variable m_cond;
+        LruList                 m_lru;
+        EntryMap                m_entries;
+        //Keys currently decoded by worker threads, and keys still requested by last prefetch
+        std::set<std::string>   m_pending;
+        std::set<std::string>   m_wanted;
+        QThreadPool             m_pool;
+        size_t                  m_maxMemory = 1024 * 1024 * 1024;
+        size_t                  m_memory = 0;
+};
+
+#endif // CIMAGECACHE_H
@@ -71,6 +71,7 @@ class CImageItem : public CItem
         void                    setFullPath(const std::string& path)
         {
             m_fullPath = path;
+            m_bModified = true;
         }
         void                    setGraphicsContext(GraphicsContextPtr& contextPtr)
         {
@@ -100,7 +101,8 @@ class CImageItem : public CItem
 
         void                    addWorkflowDbId(int id)
         {
-            m_protocolIds.insert(id);
+            if(m_protocolIds.insert(id).second)
+                m_bModified = true;
         }
 
     protected:
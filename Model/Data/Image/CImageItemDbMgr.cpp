@@ -68,20 +68,17 @@ std::shared_ptr<CItem> CImageItemDbMgr::load(const QSqlQuery &q, QModelIndex &pr
 
 void CImageItemDbMgr::save(std::shared_ptr<ProjectTreeItem> itemPtr, int dbId)
 {
-    Q_UNUSED(dbId);
-
     createTables();
 
     //Insert current image path into the global map
     auto pItem = itemPtr->getNode<std::shared_ptr<CImageItem>>();
     auto path = QString::fromStdString(pItem->getFullPath());
-    auto id = itemPtr->getId();
-    m_mapPaths.insert(id, path);
+    m_mapPaths.insert(dbId, path);
 
     //Insert protocol ids associated with current image into the global map
     auto protocolIds = QVector<int>::fromStdVector(pItem->getWorkflowDbIds());
     if(protocolIds.size() > 0)
-        m_mapWorkflowIds.insert(id, protocolIds);
+        m_mapWorkflowIds.insert(dbId, protocolIds);
 }
 
 void CImageItemDbMgr::batchSave()
@@ -90,6 +87,9 @@ void CImageItemDbMgr::batchSave()
     if(db.isValid() == false)
         throw CException(DatabaseExCode::INVALID_QUERY, "Invalid database connection", __func__, __FILE__, __LINE__);
 
+    if(m_bIncremental == true)
+        removeItems(m_mapPaths.keys().toVector().toStdVector());
+
     //Batch save image paths
     QSqlQuery q1(db);
     if(!q1.prepare(QString("INSERT INTO image (itemId, path) values (?, ?)")))
@@ -127,6 +127,12 @@ void CImageItemDbMgr::batchSave()
         throw CException(DatabaseExCode::INVALID_QUERY, q2.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
 }
 
+void CImageItemDbMgr::removeItems(const std::vector<int>& dbIds)
+{
+    removeRows("image", "itemId", dbIds);
+    removeRows("protocolImageMap", "imageId", dbIds);
+}
+
 void CImageItemDbMgr::createTables()
 {
     if(m_bTablesCreated == false)
@@ -139,25 +145,31 @@ void CImageItemDbMgr::createTables()
         QStringList tables = db.tables(QSql::Tables);
 
         //Table "image" to store path
-        if(tables.contains("image"))
+        if(isTableReusable(tables, "image") == false)
         {
-            if(!q.exec(QString("DROP TABLE image")))
+            if(tables.contains("image"))
+            {
+                if(!q.exec(QString("DROP TABLE image")))
+                    throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+            }
+
+            if(!q.exec("CREATE TABLE image (id INTEGER PRIMARY KEY, itemId INTEGER, path TEXT NOT NULL);"))
                 throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
         }
 
-        if(!q.exec("CREATE TABLE image (id INTEGER PRIMARY KEY, itemId INTEGER, path TEXT NOT NULL);"))
-            throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
-
         //Table "protocolImageMap" to store associations between protocol and image
-        if(tables.contains("protocolImageMap"))
+        if(isTableReusable(tables, "protocolImageMap") == false)
         {
-            if(!q.exec(QString("DROP TABLE protocolImageMap")))
+            if(tables.contains("protocolImageMap"))
+            {
+                if(!q.exec(QString("DROP TABLE protocolImageMap")))
+                    throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+            }
+
+            if(!q.exec("CREATE TABLE protocolImageMap (id INTEGER PRIMARY KEY, imageId INTEGER, protocolId INTEGER);"))
                 throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
         }
 
-        if(!q.exec("CREATE TABLE protocolImageMap (id INTEGER PRIMARY KEY, imageId INTEGER, protocolId INTEGER);"))
-            throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
-
         m_bTablesCreated = true;
     }
 }
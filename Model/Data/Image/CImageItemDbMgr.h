@@ -35,6 +35,7 @@ class CImageItemDbMgr : public CProjectItemBaseDbMgr
         std::shared_ptr<CItem>      load(const QSqlQuery& q, QModelIndex &previousIndex) override;
         void                        save(std::shared_ptr<ProjectTreeItem> itemPtr, int dbId) override;
         void                        batchSave() override;
+        void                        removeItems(const std::vector<int>& dbIds) override;
 
     private:
 
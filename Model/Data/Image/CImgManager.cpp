@@ -23,7 +23,7 @@
 #include "Model/Results/CResultManager.h"
 #include "Model/Render/CRenderManager.h"
 #include "Model/Graphics/CGraphicsManager.h"
-#include "Data/CDataConversion.h"
+#include "Model/Data/Image/CDisplayConversion.h"
 
 CImgManager::CImgManager()
 {
@@ -85,6 +85,10 @@ CMat CImgManager::getImage(const QModelIndex& wrapIndex)
     auto pDataInfo = pDataset->getDataInfo()[currentImgIndex];
     assert(pDataInfo != nullptr);
 
+    // Single image: decoded image and info are shared through the cache
+    if(Utils::Data::getSubsetBoundsSize(bounds) == 1)
+        return m_imageCache.getImage(pDataInfo->getFileName(), bounds, m_pCurrentDataInfo);
+
     CImageDataIO io(pDataInfo->getFileName());
     m_pCurrentDataInfo = io.dataInfo();
 
@@ -116,6 +120,10 @@ CMat CImgManager::getImage(const QModelIndex &datasetWrapIndex, int imgIndex)
     auto pDataInfo = pDataset->getDataInfo()[imgIndex];
     assert(pDataInfo != nullptr);
 
+    // Single image: decoded image and info are shared through the cache
+    if(Utils::Data::getSubsetBoundsSize(bounds) == 1)
+        return m_imageCache.getImage(pDataInfo->getFileName(), bounds, m_pCurrentDataInfo);
+
     CImageDataIO io(pDataInfo->getFileName());
     m_pCurrentDataInfo = io.dataInfo();
 
@@ -137,8 +145,10 @@ void CImgManager::displaySimpleImage(CImageScene* pScene, const QModelIndex& ind
         return;
     }
 
-    // Notify view to display image
-    emit doDisplayImage(0, pScene, CDataConversion::CMatToQImage(image), index.data(Qt::DisplayRole).toString(), nullptr);
+    // Notify view to display image: display conversion is cached with the image
+    auto cacheItem = getCacheItem(wrapIndex, CProjectUtils::getIndexInDataset(wrapIndex));
+    QImage displayImage = m_imageCache.getDisplayImage(cacheItem.first, cacheItem.second, image);
+    emit doDisplayImage(0, pScene, displayImage, index.data(Qt::DisplayRole).toString(), nullptr);
     // Load results
     m_pResultMgr->loadImageResults(index);
     //Load associated graphics and protocols
@@ -150,6 +160,8 @@ void CImgManager::displaySimpleImage(CImageScene* pScene, const QModelIndex& ind
     // Display image info
     if(m_bInfoUpdate)
         displayImageInfo(image, wrapIndex);
+    // Decode previous and next images in background
+    prefetchNeighbours(wrapIndex);
 }
 
 void CImgManager::displayVolumeImage(CImageScene* pScene, const QModelIndex& index, const QModelIndex& wrapIndex, bool bNewSequence)
@@ -176,7 +188,7 @@ void CImgManager::displayVolumeImage(CImageScene* pScene, const QModelIndex& ind
     CMat plane = image.getPlane(currentImgIndex);
 
     // Notify view to display new slice/plane
-    emit doDisplayVolume(pScene, CDataConversion::CMatToQImage(plane), index.data(Qt::DisplayRole).toString(), bNewSequence, nullptr);
+    emit doDisplayVolume(pScene, CDisplayConversion::toQImage(plane), index.data(Qt::DisplayRole).toString(), bNewSequence, nullptr);
 
     // Check if we must load a new 3D volume
     if(bNewSequence)
@@ -242,6 +254,42 @@ void CImgManager::displayImageInfo(const CMat &image, const QModelIndex& wrapInd
     emit doDisplayImageInfo(infoList);
 }
 
+CImageCache::CacheItem CImgManager::getCacheItem(const QModelIndex &datasetWrapIndex, size_t imgIndex) const
+{
+    auto pDataset = CProjectUtils::getDataset<CMat>(datasetWrapIndex);
+    if(!pDataset || imgIndex >= pDataset->size())
+        return CImageCache::CacheItem();
+
+    auto pDataInfo = pDataset->getDataInfo()[imgIndex];
+    if(pDataInfo == nullptr)
+        return CImageCache::CacheItem();
+
+    return std::make_pair(pDataInfo->getFileName(), pDataset->subsetBounds(imgIndex));
+}
+
+void CImgManager::prefetchNeighbours(const QModelIndex &wrapIndex)
+{
+    auto pDataset = CProjectUtils::getDataset<CMat>(wrapIndex);
+    if(!pDataset || pDataset->hasDimension(DataDimension::VOLUME) || pDataset->hasDimension(DataDimension::TIME))
+        return;
+
+    auto currentIndex = CProjectUtils::getIndexInDataset(wrapIndex);
+    if(currentIndex == SIZE_MAX)
+        return;
+
+    // Nearest images first: next one is the most likely to be displayed
+    std::vector<CImageCache::CacheItem> items;
+    for(size_t i=1; i<=m_prefetchRange; ++i)
+    {
+        if(currentIndex + i < pDataset->size())
+            items.push_back(getCacheItem(wrapIndex, currentIndex + i));
+
+        if(currentIndex >= i)
+            items.push_back(getCacheItem(wrapIndex, currentIndex - i));
+    }
+    m_imageCache.prefetch(items);
+}
+
 void CImgManager::exportImage(const QModelIndex& index, const QString &path, bool bWithGraphics)
 {
     assert(m_pProjectMgr);
@@ -315,6 +363,17 @@ void CImgManager::enableInfoUpdate(bool bEnable)
     }
 }
 
+void CImgManager::beforeProjectClose()
+{
+    m_imageCache.clear();
+}
+
+void CImgManager::onSetCacheMemory(int memory)
+{
+    //Memory in MB
+    m_imageCache.setMaxMemory((size_t)std::max(0, memory) * 1024 * 1024);
+}
+
 void CImgManager::onCloseWorkflow()
 {
     assert(m_pProjectMgr);
@@ -22,6 +22,7 @@
 #define CIMGMANAGER_H
 
 #include "CImageDataManager.h"
+#include "CImageCache.h"
 
 class CImageScene;
 class CProgressBarManager;
@@ -56,14 +57,21 @@ class CImgManager : public QObject
 
         void                    enableInfoUpdate(bool bEnable);
 
+        void                    beforeProjectClose();
+
     public slots:
 
         void                    onCloseWorkflow();
+        void                    onSetCacheMemory(int memory);
 
     private:
 
         void                    displayImageInfo(const CMat& image, const QModelIndex& wrapIndex);
 
+        CImageCache::CacheItem  getCacheItem(const QModelIndex& datasetWrapIndex, size_t imgIndex) const;
+
+        void                    prefetchNeighbours(const QModelIndex& wrapIndex);
+
     signals:
 
         void                    doDisplayImage(int index, CImageScene* pScene, QImage image, QString name, CViewPropertyIO* pViewProp);
@@ -79,6 +87,9 @@ class CImgManager : public QObject
     private:
 
         CImageDataMgrPtr        m_pImgMgr = nullptr;
+        CImageCache             m_imageCache;
+        //Number of images decoded in advance on each side of the current one
+        const size_t            m_prefetchRange = 2;
         CProjectManager*        m_pProjectMgr = nullptr;
         CProgressBarManager*    m_pProgressMgr = nullptr;
         CRenderManager*         m_pRenderMgr = nullptr;
@@ -0,0 +1,219 @@
+// Copyright (C) 2021 Ikomia SAS
+// Contact: https://www.ikomia.com
+//
+// This file is part of the IkomiaStudio software.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "CThumbnailStore.h"
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QImageReader>
+#include <QSaveFile>
+#include <QtConcurrent/QtConcurrent>
+#include "Main/LogCategory.h"
+#include "Data/CDataConversion.h"
+#include "CImageDataManager.h"
+#include "UtilsTools.hpp"
+
+CThumbnailStore::CThumbnailStore(const QSize& size, QObject *pParent) : QObject(pParent)
+{
+    m_size = size;
+    m_folder = QString::fromStdString(Utils::IkomiaApp::getIkomiaFolder() + "/Thumbnails/");
+    QDir().mkpath(m_folder);
+    //Keep one core for the UI
+    m_pool.setMaxThreadCount(std::max(1, QThread::idealThreadCount() - 1));
+    QtConcurrent::run(&m_pool, [this]{ prune(); });
+}
+
+CThumbnailStore::~CThumbnailStore()
+{
+    clear();
+    m_pool.waitForDone();
+}
+
+void CThumbnailStore::request(const QString &path)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if(m_failed.find(path) != m_failed.end() || m_inProgress.find(path) != m_inProgress.end())
+        return;
+
+    //Already requested: move it to the front
+    auto it = m_queued.find(path);
+    if(it != m_queued.end())
+    {
+        m_queue.erase(it->second);
+    }
+
+    m_sequence++;
+    m_queue[m_sequence] = path;
+    m_queued[path] = m_sequence;
+
+    if(m_workerCount < m_pool.maxThreadCount())
+    {
+        m_workerCount++;
+        QtConcurrent::run(&m_pool, [this]{ run(); });
+    }
+}
+
+void CThumbnailStore::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_queue.clear();
+    m_queued.clear();
+    m_failed.clear();
+}
+
+QString CThumbnailStore::getCacheFilePath(const QFileInfo &fileInfo) const
+{
+    QString key = QString("%1|%2|%3x%4")
+            .arg(fileInfo.absoluteFilePath())
+            .arg(fileInfo.lastModified().toMSecsSinceEpoch())
+            .arg(m_size.width())
+            .arg(m_size.height());
+
+    QByteArray hash = QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Sha1);
+    //Without extension: the format depends on the image (see load)
+    return m_folder + QString::fromLatin1(hash.toHex());
+}
+
+QImage CThumbnailStore::load(const QString &path) const
+{
+    QFileInfo fileInfo(path);
+    if(fileInfo.exists() == false)
+        return QImage();
+
+    QString cachePath = getCacheFilePath(fileInfo);
+    QImage thumbnail(cachePath + ".jpg");
+
+    if(thumbnail.isNull())
+        thumbnail.load(cachePath + ".png");
+
+    if(thumbnail.isNull())
+    {
+        thumbnail = decode(path);
+        if(thumbnail.isNull() == false)
+        {
+            //JPG drops transparency: images with alpha channel are stored as PNG
+            bool bAlpha = thumbnail.hasAlphaChannel();
+            //Atomic replacement: a concurrent read never sees a partial file
+            QSaveFile file(cachePath + (bAlpha ? ".png" : ".jpg"));
+            if(file.open(QIODevice::WriteOnly) && thumbnail.save(&file, bAlpha ? "PNG" : "JPG", bAlpha ? -1 : 90))
+                file.commit();
+        }
+    }
+    return thumbnail;
+}
+
+QImage CThumbnailStore::decode(const QString &path) const
+{
+    //Qt codecs: decode at reduced resolution (JPEG is scaled during decompression)
+    QImageReader reader(path);
+    reader.setAutoTransform(true);
+
+    if(reader.canRead())
+    {
+        QSize size = reader.size();
+        if(size.isValid())
+        {
+            if(size.width() > m_size.width() || size.height() > m_size.height())
+                reader.setScaledSize(size.scaled(m_size, Qt::KeepAspectRatio));
+
+            QImage image = reader.read();
+            if(image.isNull() == false)
+                return image;
+        }
+    }
+
+    //Other formats: full decoding
+    try
+    {
+        CImageDataIO io(path.toStdString());
+        CMat img = io.read();
+        QImage image = CDataConversion::CMatToQImage(img);
+        return image.scaled(m_size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    }
+    catch(std::exception& e)
+    {
+        //Placeholder is kept if the thumbnail is not created
+        qCWarning(logProject).noquote() << QString::fromStdString(e.what());
+    }
+    return QImage();
+}
+
+void CThumbnailStore::run()
+{
+    while(true)
+    {
+        QString path;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if(m_queue.empty())
+            {
+                m_workerCount--;
+                return;
+            }
+
+            auto it = std::prev(m_queue.end());
+            path = it->second;
+            m_queue.erase(it);
+            m_queued.erase(path);
+            m_inProgress.insert(path);
+        }
+
+        QImage thumbnail = load(path);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_inProgress.erase(path);
+
+            //Not requested again: placeholder is kept
+            if(thumbnail.isNull())
+                m_failed.insert(path);
+        }
+
+        if(thumbnail.isNull() == false)
+            emit doThumbnailReady(path, thumbnail);
+    }
+}
+
+void CThumbnailStore::prune()
+{
+    QDir dir(m_folder);
+    QFileInfoList files = dir.entryInfoList(QStringList() << "*.jpg" << "*.png", QDir::Files);
+
+    qint64 totalSize = 0;
+    for(auto&& info : files)
+        totalSize += info.size();
+
+    if(totalSize <= m_maxFolderSize)
+        return;
+
+    //Least recently used first: obsolete thumbnails (image modified or removed) are never read again
+    std::sort(files.begin(), files.end(), [](const QFileInfo& info1, const QFileInfo& info2)
+    {
+        return std::max(info1.lastRead(), info1.lastModified()) < std::max(info2.lastRead(), info2.lastModified());
+    });
+
+    for(auto&& info : files)
+    {
+        if(totalSize <= m_maxFolderSize)
+            break;
+
+        if(QFile::remove(info.absoluteFilePath()))
+            totalSize -= info.size();
+    }
+}
+
+#include "moc_CThumbnailStore.cpp"
@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2021 Ikomia SAS
+ * Contact: https://www.ikomia.com
+ *
+ * This file is part of the IkomiaStudio software.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CTHUMBNAILSTORE_H
+#define CTHUMBNAILSTORE_H
+
+#include <QObject>
+#include <QImage>
+#include <QThreadPool>
+#include <QFileInfo>
+#include <map>
+#include <set>
+#include <mutex>
+
+//Persistent store of image thumbnails.
+//Thumbnails are decoded on worker threads, at reduced resolution when the codec supports it.
+//Most recent requests are served first: views request visible items on each paint.
+//Thumbnails are saved in the Ikomia folder, keyed by file path and modification time.
+//Least recently used files are removed at startup when the folder exceeds its size limit.
+class CThumbnailStore : public QObject
+{
+    Q_OBJECT
+
+    public:
+
+        CThumbnailStore(const QSize& size, QObject* pParent = nullptr);
+        ~CThumbnailStore();
+
+        //Thread-safe, doThumbnailReady is emitted when available
+        void    request(const QString& path);
+        void    clear();
+
+    signals:
+
+        void    doThumbnailReady(const QString& path, const QImage& thumbnail);
+
+    private:
+
+        QString getCacheFilePath(const QFileInfo& fileInfo) const;
+
+        QImage  load(const QString& path) const;
+        QImage  decode(const QString& path) const;
+
+        void    run();
+        void    prune();
+
+    private:
+
+        std::mutex                  m_mutex;
+        //Requests by sequence number (highest first) and sequence number by path
+        std::map<quint64, QString>  m_queue;
+        std::map<QString, quint64>  m_queued;
+        //Paths currently decoded by a worker
+        std::set<QString>           m_inProgress;
+        std::set<QString>           m_failed;
+        quint64                     m_sequence = 0;
+        int                         m_workerCount = 0;
+        QThreadPool                 m_pool;
+        QString                     m_folder;
+        QSize                       m_size;
+        const qint64                m_maxFolderSize = 512 * 1024 * 1024;
+};
+
+#endif // CTHUMBNAILSTORE_H
@@ -71,20 +71,17 @@ std::shared_ptr<CItem> CLiveStreamItemDbMgr::load(const QSqlQuery &q, QModelInde
 
 void CLiveStreamItemDbMgr::save(std::shared_ptr<ProjectTreeItem> itemPtr, int dbId)
 {
-    Q_UNUSED(dbId);
-
     createTables();
 
     //Insert current Video path into the global map
     auto pItem = itemPtr->getNode<std::shared_ptr<CLiveStreamItem>>();
     auto path = QString::fromStdString(pItem->getFullPath());
-    auto id = itemPtr->getId();
-    m_mapPaths.insert(id, path);
+    m_mapPaths.insert(dbId, path);
 
     //Insert protocol ids associated with current Video into the global map
     auto protocolIds = QVector<int>::fromStdVector(pItem->getWorkflowDbIds());
     if(protocolIds.size() > 0)
-        m_mapWorkflowIds.insert(id, protocolIds);
+        m_mapWorkflowIds.insert(dbId, protocolIds);
 }
 
 void CLiveStreamItemDbMgr::batchSave()
@@ -93,6 +90,9 @@ void CLiveStreamItemDbMgr::batchSave()
     if(db.isValid() == false)
         throw CException(DatabaseExCode::INVALID_QUERY, "Invalid database connection", __func__, __FILE__, __LINE__);
 
+    if(m_bIncremental == true)
+        removeItems(m_mapPaths.keys().toVector().toStdVector());
+
     //Batch save Video paths
     QSqlQuery q1(db);
     if(!q1.prepare(QString("INSERT INTO Stream (itemId, path) values (?, ?)")))
@@ -130,6 +130,12 @@ void CLiveStreamItemDbMgr::batchSave()
         throw CException(DatabaseExCode::INVALID_QUERY, q2.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
 }
 
+void CLiveStreamItemDbMgr::removeItems(const std::vector<int>& dbIds)
+{
+    removeRows("Stream", "itemId", dbIds);
+    removeRows("protocolVideoMap", "VideoId", dbIds);
+}
+
 void CLiveStreamItemDbMgr::createTables()
 {
     if(m_bTablesCreated == false)
@@ -142,25 +148,31 @@ void CLiveStreamItemDbMgr::createTables()
         QStringList tables = db.tables(QSql::Tables);
 
         //Table "Video" to store path
-        if(tables.contains("Stream"))
+        if(isTableReusable(tables, "Stream") == false)
         {
-            if(!q.exec(QString("DROP TABLE Stream")))
+            if(tables.contains("Stream"))
+            {
+                if(!q.exec(QString("DROP TABLE Stream")))
+                    throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+            }
+
+            if(!q.exec("CREATE TABLE Stream (id INTEGER PRIMARY KEY, itemId INTEGER, path TEXT NOT NULL);"))
                 throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
         }
 
-        if(!q.exec("CREATE TABLE Stream (id INTEGER PRIMARY KEY, itemId INTEGER, path TEXT NOT NULL);"))
-            throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
-
         //Table "protocolVideoMap" to store associations between protocol and Video
-        if(tables.contains("protocolVideoMap"))
+        if(isTableReusable(tables, "protocolVideoMap") == false)
         {
-            if(!q.exec(QString("DROP TABLE protocolVideoMap")))
+            if(tables.contains("protocolVideoMap"))
+            {
+                if(!q.exec(QString("DROP TABLE protocolVideoMap")))
+                    throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+            }
+
+            if(!q.exec("CREATE TABLE protocolVideoMap (id INTEGER PRIMARY KEY, VideoId INTEGER, protocolId INTEGER);"))
                 throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
         }
 
-        if(!q.exec("CREATE TABLE protocolVideoMap (id INTEGER PRIMARY KEY, VideoId INTEGER, protocolId INTEGER);"))
-            throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
-
         m_bTablesCreated = true;
     }
 }
@@ -0,0 +1,118 @@
+// Copyright (C) 2021 Ikomia SAS
+// Contact: https://www.ikomia.com
+//
+// This file is part of the IkomiaStudio software.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#include "CVideoFrameQueue.h"
+
+CVideoFrameQueue::CVideoFrameQueue(size_t capacity)
+{
+    m_capacity = std::max<size_t>(1, capacity);
+}
+
+void CVideoFrameQueue::setDropOldest(bool bDrop)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_bDropOldest = bDrop;
+}
+
+size_t CVideoFrameQueue::getSize() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_frames.size();
+}
+
+size_t CVideoFrameQueue::getDroppedCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_droppedCount;
+}
+
+bool CVideoFrameQueue::waitNotFull()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if(m_bDropOldest == false)
+        m_notFullCond.wait(lock, [this]{ return m_bAborted || m_frames.size() < m_capacity; });
+
+    return !m_bAborted;
+}
+
+bool CVideoFrameQueue::push(Frame &&frame)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if(m_bDropOldest)
+    {
+        while(m_frames.size() >= m_capacity)
+        {
+            m_frames.pop_front();
+            m_droppedCount++;
+        }
+    }
+    else
+        m_notFullCond.wait(lock, [this]{ return m_bAborted || m_frames.size() < m_capacity; });
+
+    if(m_bAborted)
+        return false;
+
+    m_frames.push_back(std::move(frame));
+    return true;
+}
+
+bool CVideoFrameQueue::tryPop(Frame &frame, bool bLatest, size_t generation)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Frames read before a seek are obsolete
+    while(!m_frames.empty() && m_frames.front().m_generation != generation)
+        m_frames.pop_front();
+
+    if(m_frames.empty())
+        return false;
+
+    // Consumer is late: skip stale frames and keep the most recent one
+    if(bLatest)
+    {
+        m_droppedCount += m_frames.size() - 1;
+        frame = std::move(m_frames.back());
+        m_frames.clear();
+    }
+    else
+    {
+        frame = std::move(m_frames.front());
+        m_frames.pop_front();
+    }
+    m_notFullCond.notify_one();
+    return true;
+}
+
+void CVideoFrameQueue::reset()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_droppedCount = 0;
+    m_bAborted = false;
+}
+
+void CVideoFrameQueue::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_frames.clear();
+}
+
+void CVideoFrameQueue::abort()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_bAborted = true;
+    m_notFullCond.notify_all();
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2021 Ikomia SAS
+ * Contact: https://www.ikomia.com
+ *
+ * This file is part of the IkomiaStudio software.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef CVIDEOFRAMEQUEUE_H
+#define CVIDEOFRAMEQUEUE_H
+
+#include <deque>
+#include <mutex>
+#include <chrono>
+#include <string>
+#include <condition_variable>
+#include "Data/CMat.hpp"
+
+//-----------------------------//
+//----- CVideoFrameQueue -----//
+//-----------------------------//
+/**
+ * @brief Bounded frame queue between the capture thread and the consumer (workflow or display).
+ * In live mode the oldest frame is dropped when the queue is full so that the consumer always gets fresh frames.
+ * Otherwise the capture thread waits for free space (no frame is lost for video files).
+ */
+class CVideoFrameQueue
+{
+    public:
+
+        using Clock = std::chrono::steady_clock;
+
+        struct Frame
+        {
+            CMat                m_image;
+            Clock::time_point   m_captureTime;
+            size_t              m_generation = 0;
+            size_t              m_pos = 0;
+            //End of capture (end of file or error): queued after the last frame so that it is consumed in order
+            bool                m_bEnd = false;
+            std::string         m_error;
+        };
+
+        CVideoFrameQueue(size_t capacity = 2);
+
+        void    setDropOldest(bool bDrop);
+
+        size_t  getSize() const;
+        size_t  getDroppedCount() const;
+
+        bool    waitNotFull();
+
+        bool    push(Frame&& frame);
+        bool    tryPop(Frame& frame, bool bLatest, size_t generation);
+
+        void    reset();
+        void    clear();
+        void    abort();
+
+    private:
+
+        mutable std::mutex      m_mutex;
+        std::condition_variable m_notFullCond;
+        std::deque<Frame>       m_frames;
+        size_t                  m_capacity = 2;
+        size_t                  m_droppedCount = 0;
+        bool                    m_bDropOldest = false;
+        bool                    m_bAborted = false;
+};
+
+#endif // CVIDEOFRAMEQUEUE_H
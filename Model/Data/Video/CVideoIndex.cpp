@@ -0,0 +1,212 @@
+// Copyright (C) 2021 Ikomia SAS
+// Contact: https://www.ikomia.com
+//
+// This file is part of the IkomiaStudio software.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#include "CVideoIndex.h"
+#include <QCryptographicHash>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QDateTime>
+#include <QtConcurrent/QtConcurrent>
+#include "Main/LogCategory.h"
+#include "CDataVideoBuffer.h"
+#include "UtilsTools.hpp"
+
+CVideoIndex::CVideoIndex()
+{
+    m_folder = QString::fromStdString(Utils::IkomiaApp::getIkomiaFolder() + "/VideoIndex/");
+    // Probing is I/O bound: one thread is enough and keeps the UI smooth
+    m_pool.setMaxThreadCount(1);
+    QtConcurrent::run(&m_pool, [this]{ prune(); });
+}
+
+CVideoIndex::~CVideoIndex()
+{
+    m_pool.clear();
+    m_pool.waitForDone();
+}
+
+size_t CVideoIndex::getFrameCount(const std::string &path)
+{
+    Entry entry;
+    if(find(path, entry) && entry.m_frameCount > 0)
+        return entry.m_frameCount;
+
+    entry = probe(path);
+    insert(path, entry);
+    return entry.m_frameCount;
+}
+
+bool CVideoIndex::find(const std::string &path, Entry &entry)
+{
+    QFileInfo fileInfo(QString::fromStdString(path));
+    if(fileInfo.exists() == false)
+        return false;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_entries.find(path);
+        if(it != m_entries.end() && isValid(fileInfo, it->second))
+        {
+            entry = it->second;
+            return true;
+        }
+    }
+
+    if(load(path, entry) && isValid(fileInfo, entry))
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_entries[path] = entry;
+        return true;
+    }
+    return false;
+}
+
+void CVideoIndex::update(const std::string &path, const CDataVideoInfoPtr &infoPtr)
+{
+    if(infoPtr == nullptr || infoPtr->m_frameCount == 0)
+        return;
+
+    Entry entry;
+    entry.m_frameCount = infoPtr->m_frameCount;
+
+    Entry current;
+    if(find(path, current) && current.m_frameCount == entry.m_frameCount)
+        return;
+
+    insert(path, entry);
+}
+
+void CVideoIndex::build(const std::vector<std::string> &paths)
+{
+    for(auto&& path : paths)
+    {
+        QtConcurrent::run(&m_pool, [this, path]
+        {
+            try
+            {
+                Entry entry;
+                if(find(path, entry) == false)
+                    insert(path, probe(path));
+            }
+            catch(std::exception& e)
+            {
+                qCWarning(logVideo).noquote() << QString::fromStdString(e.what());
+            }
+        });
+    }
+}
+
+QString CVideoIndex::getIndexFilePath(const std::string &path) const
+{
+    auto hash = QCryptographicHash::hash(QByteArray::fromStdString(path), QCryptographicHash::Sha1);
+    return m_folder + QString(hash.toHex()) + ".json";
+}
+
+bool CVideoIndex::isValid(const QFileInfo &fileInfo, const Entry &entry) const
+{
+    return entry.m_fileSize == fileInfo.size() && entry.m_lastModified == fileInfo.lastModified().toMSecsSinceEpoch();
+}
+
+bool CVideoIndex::load(const std::string &path, Entry &entry) const
+{
+    QFile file(getIndexFilePath(path));
+    if(file.open(QIODevice::ReadOnly) == false)
+        return false;
+
+    auto jsonDoc = QJsonDocument::fromJson(file.readAll());
+    if(jsonDoc.isNull() || jsonDoc.isObject() == false)
+        return false;
+
+    auto obj = jsonDoc.object();
+    if(obj["path"].toString().toStdString() != path)
+        return false;
+
+    entry.m_frameCount = static_cast<size_t>(obj["frameCount"].toDouble());
+    entry.m_fileSize = static_cast<qint64>(obj["fileSize"].toDouble());
+    entry.m_lastModified = static_cast<qint64>(obj["lastModified"].toDouble());
+    return true;
+}
+
+void CVideoIndex::save(const std::string &path, const Entry &entry) const
+{
+    QJsonObject obj;
+    obj["path"] = QString::fromStdString(path);
+    obj["frameCount"] = static_cast<double>(entry.m_frameCount);
+    obj["fileSize"] = static_cast<double>(entry.m_fileSize);
+    obj["lastModified"] = static_cast<double>(entry.m_lastModified);
+
+    QDir().mkpath(m_folder);
+    QFile file(getIndexFilePath(path));
+    if(file.open(QIODevice::WriteOnly | QIODevice::Truncate) == false)
+    {
+        qCWarning(logVideo).noquote() << QObject::tr("Unable to write video index file %1").arg(file.fileName());
+        return;
+    }
+    file.write(QJsonDocument(obj).toJson(QJsonDocument::Compact));
+}
+
+void CVideoIndex::insert(const std::string &path, Entry entry)
+{
+    QFileInfo fileInfo(QString::fromStdString(path));
+    entry.m_fileSize = fileInfo.size();
+    entry.m_lastModified = fileInfo.lastModified().toMSecsSinceEpoch();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_entries[path] = entry;
+    }
+    save(path, entry);
+}
+
+void CVideoIndex::prune()
+{
+    //Remove index files whose video has been deleted or modified since indexing
+    QDir dir(m_folder);
+    auto files = dir.entryInfoList(QStringList() << "*.json", QDir::Files);
+
+    for(auto&& indexFileInfo : files)
+    {
+        QFile file(indexFileInfo.absoluteFilePath());
+        if(file.open(QIODevice::ReadOnly) == false)
+            continue;
+
+        auto jsonDoc = QJsonDocument::fromJson(file.readAll());
+        file.close();
+        bool bStale = true;
+
+        if(jsonDoc.isObject())
+        {
+            auto obj = jsonDoc.object();
+            QFileInfo videoFileInfo(obj["path"].toString());
+            Entry entry;
+            entry.m_fileSize = static_cast<qint64>(obj["fileSize"].toDouble());
+            entry.m_lastModified = static_cast<qint64>(obj["lastModified"].toDouble());
+            bStale = videoFileInfo.exists() == false || isValid(videoFileInfo, entry) == false;
+        }
+
+        if(bStale)
+            file.remove();
+    }
+}
+
+CVideoIndex::Entry CVideoIndex::probe(const std::string &path)
+{
+    Entry entry;
+    CDataVideoBuffer videoReader(path);
+    entry.m_frameCount = videoReader.getFrameCount();
+    return entry;
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2021 Ikomia SAS
+ * Contact: https://www.ikomia.com
+ *
+ * This file is part of the IkomiaStudio software.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef CVIDEOINDEX_H
+#define CVIDEOINDEX_H
+
+#include <QThreadPool>
+#include <QFileInfo>
+#include <map>
+#include <mutex>
+#include "CVideoDataManager.h"
+
+//------------------------//
+//----- CVideoIndex -----//
+//------------------------//
+/**
+ * @brief Persistent per-file video frame count.
+ * Entries are stored as small JSON files in the Ikomia folder and are invalidated when the video file changes,
+ * so that frame count is known without opening the video again.
+ * Index files of missing or modified videos are removed at construction.
+ */
+class CVideoIndex
+{
+    public:
+
+        struct Entry
+        {
+            size_t  m_frameCount = 0;
+            qint64  m_fileSize = 0;
+            qint64  m_lastModified = 0;
+        };
+
+        CVideoIndex();
+        ~CVideoIndex();
+
+        size_t  getFrameCount(const std::string& path);
+
+        bool    find(const std::string& path, Entry& entry);
+
+        void    update(const std::string& path, const CDataVideoInfoPtr& infoPtr);
+
+        void    build(const std::vector<std::string>& paths);
+
+    private:
+
+        QString getIndexFilePath(const std::string& path) const;
+
+        bool    isValid(const QFileInfo& fileInfo, const Entry& entry) const;
+
+        bool    load(const std::string& path, Entry& entry) const;
+
+        void    save(const std::string& path, const Entry& entry) const;
+
+        void    insert(const std::string& path, Entry entry);
+
+        void    prune();
+
+        static Entry    probe(const std::string& path);
+
+    private:
+
+        std::map<std::string, Entry>    m_entries;
+        std::mutex                      m_mutex;
+        QThreadPool                     m_pool;
+        QString                         m_folder;
+};
+
+#endif // CVIDEOINDEX_H
@@ -23,7 +23,7 @@
 #include "Model/Workflow/CWorkflowManager.h"
 #include "Model/Graphics/CGraphicsManager.h"
 #include "Model/Results/CResultManager.h"
-#include "Data/CDataConversion.h"
+#include "Model/Data/Image/CDisplayConversion.h"
 
 //------------------------//
 //----- CVideoPlayer -----//
@@ -42,6 +42,7 @@ CVideoPlayer::CVideoPlayer(const QModelIndex &wrapIndex)
 CVideoPlayer::~CVideoPlayer()
 {
     stop();
+    m_seekWatcher.waitForFinished();
     m_mgrPtr->close();
 }
 
@@ -88,11 +89,22 @@ CMat CVideoPlayer::getImage()
         return CMat();
 
     std::lock_guard<std::mutex> lock(m_imgMutex);
+    // Frames already captured are now obsolete
+    m_generation++;
+    m_consumedPos = 0;
+    m_bCaptureEnded = false;
     m_currentImage = m_mgrPtr->playVideo(*pDataset, m_readTimeout);
     return m_currentImage;
 }
 
 CMat CVideoPlayer::getImage(size_t pos)
+{
+    auto image = readImage(pos);
+    m_currentImage = image;
+    return image;
+}
+
+CMat CVideoPlayer::readImage(size_t pos)
 {
     // If real video, set subset bound with new position image
     auto pDataset = CProjectUtils::getDataset<CMat>(m_wrapIndex);
@@ -100,8 +112,11 @@ CMat CVideoPlayer::getImage(size_t pos)
     Utils::Data::setSubsetBounds(bounds, DataDimension::IMAGE, pos, pos);
     // Play video at this position and get it
     std::lock_guard<std::mutex> lock(m_imgMutex);
-    m_currentImage = m_mgrPtr->playVideo(*pDataset, bounds, m_readTimeout);
-    return m_currentImage;
+    // Frames already captured are now obsolete
+    m_generation++;
+    m_consumedPos = 0;
+    m_bCaptureEnded = false;
+    return m_mgrPtr->playVideo(*pDataset, bounds, m_readTimeout);
 }
 
 CMat CVideoPlayer::getSequenceImage(const QModelIndex &wrapIndex)
@@ -132,6 +147,25 @@ CDataVideoBuffer::Type CVideoPlayer::getSourceType() const
     return m_mgrPtr->getSourceType();
 }
 
+CVideoPipelineStats CVideoPlayer::getPipelineStats() const
+{
+    std::lock_guard<std::mutex> lock(m_statsMutex);
+    return m_stats;
+}
+
+size_t CVideoPlayer::getCurrentPos() const
+{
+    // Reader is ahead of the consumed frame while capture thread is running
+    if(m_consumedPos != 0)
+        return m_consumedPos;
+
+    auto pInfo = m_mgrPtr->getDataVideoInfoPtr();
+    if(pInfo == nullptr)
+        return 0;
+
+    return pInfo->m_currentPos;
+}
+
 bool CVideoPlayer::isStream() const
 {
     return m_bStream;
@@ -151,55 +185,84 @@ void CVideoPlayer::play(const QModelIndex& modelIndex, int index)
 {
     m_bStop = false;
 
-    if(m_readWatcher.isFinished())
+    // Capture runs freely in its own thread, each play request only consumes the next frame
+    if(!m_bCapturing && !m_bCaptureEnded)
+        startCapture();
+
+    // Live stream: take the freshest frame and drop older ones
+    CVideoFrameQueue::Frame frame;
+    if(m_frameQueue.tryPop(frame, m_bStream, m_generation) == false)
+        return;
+
+    // Every frame read before the end has been consumed: the play loop of the view has to be stopped
+    if(frame.m_bEnd)
+    {
+        emit doPlayError(modelIndex, QString::fromStdString(frame.m_error));
+        return;
+    }
+
     {
-        auto future = QtConcurrent::run([&, modelIndex, index]
+        std::lock_guard<std::mutex> lock(m_statsMutex);
+        auto waitTime = std::chrono::duration<double, std::milli>(CVideoFrameQueue::Clock::now() - frame.m_captureTime).count();
+        updateAverage(m_stats.m_queueTime, waitTime);
+        m_stats.m_queueDepth = m_frameQueue.getSize();
+        m_stats.m_droppedFrames = m_frameQueue.getDroppedCount();
+    }
+
+    m_consumedPos = frame.m_pos;
+    // Notify that image changed
+    emit doImageIsLoaded(modelIndex, frame.m_image, index, false);
+}
+
+void CVideoPlayer::seek(const QModelIndex &modelIndex, int index, size_t pos)
+{
+    {
+        // Scrubbing: only the latest requested position matters,
+        // a running seek thread will pick it up when its current decoding is done
+        std::lock_guard<std::mutex> lock(m_seekMutex);
+        m_pendingSeekPos = static_cast<long long>(pos);
+
+        if(m_bSeeking)
+            return;
+
+        m_bSeeking = true;
+    }
+
+    auto future = QtConcurrent::run([this, modelIndex, index]
+    {
+        while(true)
         {
-            // Use unique_lock for synchronization purpose
-            // It is used with std::conditional_variable
-            std::unique_lock<std::mutex> lock(m_playMutex);
-            while(!m_bStop)
+            long long seekPos;
             {
-                try
-                {
-                    // Wait for new image
-                    m_threadCond.wait(lock);
-
-                    // Manage if we stop acquisition
-                    if(m_bStop)
-                        break;
-
-                    // Read new image
-                    // If read failed we exit the thread
-                    // and send signal to report error (the play loop of the view has to be stopped)
-                    auto image = getImage();
-                    if(image.empty())
-                    {
-                        emit doPlayError(modelIndex, "Video player error: invalid frame buffer.");
-                        break;
-                    }
-
-                    // Manage if we stop acquisition
-                    if(m_bStop)
-                        break;
-
-                    // Notify that image changed
-                    emit doImageIsLoaded(modelIndex, image, index, false);
-                }
-                catch(std::exception& e)
+                std::lock_guard<std::mutex> lock(m_seekMutex);
+                seekPos = m_pendingSeekPos;
+                m_pendingSeekPos = -1;
+
+                if(seekPos < 0)
                 {
-                    emit doPlayError(modelIndex, QString::fromStdString(e.what()));
+                    m_bSeeking = false;
                     break;
                 }
             }
-        });
-        m_readWatcher.setFuture(future);
-    }
-    else
-    {
-        // Notify thread that there is a new image
-        m_threadCond.notify_one();
-    }
+
+            try
+            {
+                // Current image is only updated in the main thread (onImageIsLoaded)
+                auto image = readImage(static_cast<size_t>(seekPos));
+                // Notify that image changed
+                emit doImageIsLoaded(modelIndex, image, index, false);
+            }
+            catch(std::exception& e)
+            {
+                std::lock_guard<std::mutex> lock(m_seekMutex);
+                m_pendingSeekPos = -1;
+                m_bSeeking = false;
+                emit doPlayError(modelIndex, QString::fromStdString(e.what()));
+                break;
+            }
+        }
+    });
+    m_seekWatcher.setFuture(future);
 }
 
 void CVideoPlayer::startRecord(const std::string &path)
@@ -212,12 +275,16 @@ void CVideoPlayer::stop()
 {
     m_bStop = true;
 
-    // Notify threads that the user stopped
-    m_threadCond.notify_all();
+    // Wake up capture thread if it waits for free space
+    m_frameQueue.abort();
 
     // Ensure read is stop
-    if(m_readWatcher.isRunning())
-        m_readWatcher.waitForFinished();
+    if(m_captureThread.joinable())
+        m_captureThread.join();
+
+    m_frameQueue.clear();
+    m_consumedPos = 0;
+    m_bCaptureEnded = false;
 
     m_mgrPtr->stopReadVideo();
 }
@@ -239,6 +306,107 @@ void CVideoPlayer::releaseProcessedImage()
     m_currentProcessedImage.release();
 }
 
+void CVideoPlayer::updateDispatchTime(double time)
+{
+    std::lock_guard<std::mutex> lock(m_statsMutex);
+    updateAverage(m_stats.m_dispatchTime, time);
+}
+
+void CVideoPlayer::startCapture()
+{
+    // Previous capture thread has already returned
+    if(m_captureThread.joinable())
+        m_captureThread.join();
+
+    m_frameQueue.reset();
+    m_frameQueue.setDropOldest(m_bStream);
+
+    {
+        std::lock_guard<std::mutex> lock(m_statsMutex);
+        m_stats = CVideoPipelineStats();
+    }
+
+    m_bCapturing = true;
+    m_captureThread = std::thread([this]
+    {
+        while(!m_bStop)
+        {
+            try
+            {
+                // Video file: read only when the consumer has freed a slot
+                if(m_frameQueue.waitNotFull() == false)
+                    break;
+
+                // Read new image
+                // If read failed we exit the thread, the error is queued after
+                // the frames already read so that they are still consumed
+                CVideoFrameQueue::Frame frame;
+                if(readFrame(frame) == false)
+                {
+                    pushEndFrame("Video player error: invalid frame buffer.");
+                    break;
+                }
+
+                // Manage if we stop acquisition
+                if(m_bStop)
+                    break;
+
+                if(m_frameQueue.push(std::move(frame)) == false)
+                    break;
+            }
+            catch(std::exception& e)
+            {
+                pushEndFrame(e.what());
+                break;
+            }
+        }
+        m_bCapturing = false;
+    });
+}
+
+void CVideoPlayer::pushEndFrame(const std::string &error)
+{
+    CVideoFrameQueue::Frame frame;
+    frame.m_bEnd = true;
+    frame.m_error = error;
+    frame.m_generation = m_generation;
+    frame.m_captureTime = CVideoFrameQueue::Clock::now();
+    m_bCaptureEnded = true;
+    m_frameQueue.push(std::move(frame));
+}
+
+bool CVideoPlayer::readFrame(CVideoFrameQueue::Frame &frame)
+{
+    auto pDataset = CProjectUtils::getDataset<CMat>(m_wrapIndex);
+    if(!pDataset)
+        return false;
+
+    auto start = CVideoFrameQueue::Clock::now();
+    {
+        std::lock_guard<std::mutex> lock(m_imgMutex);
+        // Readers may reuse their frame buffer: queued frames need their own copy
+        frame.m_image = m_mgrPtr->playVideo(*pDataset, m_readTimeout).clone();
+        frame.m_generation = m_generation;
+        auto pInfo = m_mgrPtr->getDataVideoInfoPtr();
+        frame.m_pos = pInfo ? pInfo->m_currentPos : 0;
+    }
+    frame.m_captureTime = CVideoFrameQueue::Clock::now();
+
+    std::lock_guard<std::mutex> lock(m_statsMutex);
+    updateAverage(m_stats.m_captureTime, std::chrono::duration<double, std::milli>(frame.m_captureTime - start).count());
+    return !frame.m_image.empty();
+}
+
+void CVideoPlayer::updateAverage(double &avg, double value)
+{
+    // Exponential moving average: smooth enough to be displayed while following latency changes
+    const double alpha = 0.1;
+    if(avg == 0)
+        avg = value;
+    else
+        avg = alpha * value + (1.0 - alpha) * avg;
+}
+
 //-------------------------//
 //----- CVideoManager -----//
 //-------------------------//
@@ -346,9 +514,9 @@ void CVideoManager::displayCurrentVideoImage(const QModelIndex& modelIndex, int
         }
     }
 
-    // Notify project manager to display image
+    // Notify project manager to display image: frame buffers are reused by the reader, display needs a copy
     QString name = pPlayer->getWrapIndex().data(Qt::DisplayRole).toString();
-    emit doDisplayVideoImage(modelIndex, index, CDataConversion::CMatToQImage(currentImage), name);
+    emit doDisplayVideoImage(modelIndex, index, CDisplayConversion::toQImage(currentImage, false), name);
 
     // Notify view to update video widgets
     updateInfo(modelIndex, index);
@@ -386,6 +554,16 @@ void CVideoManager::displayVideoInfo(const QModelIndex& index)
                 it->second = std::to_string(pDataset->size());
         }
     }
+
+    if(pPlayer->isPlaying())
+    {
+        auto stats = pPlayer->getPipelineStats();
+        infoList.push_back(std::make_pair(tr("Capture latency (ms)").toStdString(), QString::number(stats.m_captureTime, 'f', 1).toStdString()));
+        infoList.push_back(std::make_pair(tr("Queue latency (ms)").toStdString(), QString::number(stats.m_queueTime, 'f', 1).toStdString()));
+        infoList.push_back(std::make_pair(tr("Dispatch latency (ms)").toStdString(), QString::number(stats.m_dispatchTime, 'f', 1).toStdString()));
+        infoList.push_back(std::make_pair(tr("Queue depth").toStdString(), std::to_string(stats.m_queueDepth)));
+        infoList.push_back(std::make_pair(tr("Dropped frames").toStdString(), std::to_string(stats.m_droppedFrames)));
+    }
     emit doDisplayVideoInfo(infoList);
 }
 
@@ -395,10 +573,8 @@ void CVideoManager::updateVideoPos(const QModelIndex& modelIndex, size_t index,
     if(!pPlayer)
         return;
 
-    auto image = pPlayer->getImage(pos);
-
-    // Notify that image changed
-    onImageIsLoaded(modelIndex, image, index, false);
+    // Decoding is done in background, image is notified through doImageIsLoaded
+    pPlayer->seek(modelIndex, index, pos);
 }
 
 void CVideoManager::updateInfo(const QModelIndex &modelIndex, int index)
@@ -433,6 +609,11 @@ void CVideoManager::initInfo(const QModelIndex& modelIndex, int index)
     if(pInfo == nullptr)
         return;
 
+    // Keep video metadata for later use without opening the file (batch processing)
+    auto itemPtr = static_cast<ProjectTreeItem*>(pPlayer->getWrapIndex().internalPointer());
+    if(itemPtr && itemPtr->getTypeId() == TreeItemType::VIDEO)
+        m_videoIndex.update(m_pProjectMgr->getItemPath(modelIndex), pInfo);
+
     emit doSetSourceType(index, pPlayer->getSourceType());
     // Set fps rate in video display view
     emit doSetFPS(index, pInfo->m_fps);
@@ -658,6 +839,11 @@ void CVideoManager::enableInfoUpdate(const QModelIndex& index, bool bEnable)
     }
 }
 
+void CVideoManager::indexVideos(const std::vector<std::string> &paths)
+{
+    m_videoIndex.build(paths);
+}
+
 void CVideoManager::onNotifyVideoStart(const QModelIndex& index)
 {
     auto pPlayer = getPlayer(index);
@@ -686,6 +872,7 @@ void CVideoManager::onImageIsLoaded(const QModelIndex& modelIndex, const CMat& i
     if(!pPlayer)
         return;
 
+    auto start = CVideoFrameQueue::Clock::now();
     pPlayer->setCurrentImage(image);
 
     if(m_pWorkflowMgr->isWorkflowExists() == false)
@@ -701,6 +888,7 @@ void CVideoManager::onImageIsLoaded(const QModelIndex& modelIndex, const CMat& i
     }
     // Notify view that image changed
     emit doCurrentDataChanged(modelIndex, bNewSequence);
+    pPlayer->updateDispatchTime(std::chrono::duration<double, std::milli>(CVideoFrameQueue::Clock::now() - start).count());
 }
 
 void CVideoManager::onInitInfo(const QModelIndex &modelIndex, int index)
@@ -759,14 +947,11 @@ size_t CVideoManager::getCurrentPos(const QModelIndex& index)
     if(!pPlayer)
         return 0;
 
-    auto pInfo = pPlayer->getManager()->getDataVideoInfoPtr();
-    if(pInfo == nullptr)
-        return 0;
-
-    if (pInfo->m_currentPos == 0)
+    size_t currentPos = pPlayer->getCurrentPos();
+    if (currentPos == 0)
         return 0;
     else
-        return pInfo->m_currentPos - 1;
+        return currentPos - 1;
 }
 
 CMat CVideoManager::getVideoImage(const QModelIndex& index)
@@ -828,6 +1013,11 @@ CDataVideoBuffer::Type CVideoManager::getSourceType(const QModelIndex &index)
         return pPlayer->getSourceType();
 }
 
+size_t CVideoManager::getFrameCount(const std::string &path)
+{
+    return m_videoIndex.getFrameCount(path);
+}
+
 //#include "moc_CVideoManager.cpp"
 
 
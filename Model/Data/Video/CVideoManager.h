@@ -22,7 +22,10 @@
 #define CVIDEOMANAGER_H
 
 #include <QObject>
+#include <thread>
 #include "CVideoDataManager.h"
+#include "CVideoFrameQueue.h"
+#include "CVideoIndex.h"
 
 class CProjectManager;
 class CImageScene;
@@ -33,6 +36,16 @@ class CResultManager;
 
 using CVideoDataMgrPtr = std::shared_ptr<CVideoDataManager>;
 
+// Average latencies (ms) of the live pipeline stages
+struct CVideoPipelineStats
+{
+    double  m_captureTime = 0;
+    double  m_queueTime = 0;
+    double  m_dispatchTime = 0;
+    size_t  m_queueDepth = 0;
+    size_t  m_droppedFrames = 0;
+};
+
 //------------------------//
 //----- CVideoPlayer -----//
 //------------------------//
@@ -58,6 +71,8 @@ class CVideoPlayer : public QObject
         CMat                getSequenceImage(const QModelIndex& wrapIndex);
         std::string         getRecordPath() const;
         CDataVideoBuffer::Type  getSourceType() const;
+        CVideoPipelineStats getPipelineStats() const;
+        size_t              getCurrentPos() const;
 
         bool                isStream() const;
         bool                isPlaying() const;
@@ -65,6 +80,8 @@ class CVideoPlayer : public QObject
 
         void                play(const QModelIndex& modelIndex, int index);
 
+        void                seek(const QModelIndex& modelIndex, int index, size_t pos);
+
         void                startRecord(const std::string& path);
 
         void                stop();
@@ -74,11 +91,24 @@ class CVideoPlayer : public QObject
 
         void                releaseProcessedImage();
 
+        void                updateDispatchTime(double time);
+
     signals:
 
         void                doImageIsLoaded(const QModelIndex& modelIndex, const CMat& image, int index, bool bNewSequence);
         void                doPlayError(const QModelIndex& modelIndex, const QString& error);
 
+    private:
+
+        void                startCapture();
+
+        CMat                readImage(size_t pos);
+
+        bool                readFrame(CVideoFrameQueue::Frame& frame);
+        void                pushEndFrame(const std::string& error);
+
+        static void         updateAverage(double& avg, double value);
+
     private:
 
         CVideoDataMgrPtr        m_mgrPtr = nullptr;
@@ -89,10 +119,21 @@ class CVideoPlayer : public QObject
         CMat                    m_currentImage;
         CMat                    m_currentProcessedImage;
         std::string             m_recordPath = "";
-        std::mutex              m_playMutex;
         std::mutex              m_imgMutex;
-        QFutureWatcher<void>    m_readWatcher;
-        std::condition_variable m_threadCond;
+        //Capture runs for the whole playback: dedicated thread, not a pool slot
+        std::thread             m_captureThread;
+        std::atomic_bool        m_bCapturing{false};
+        QFutureWatcher<void>    m_seekWatcher;
+        std::mutex              m_seekMutex;
+        long long               m_pendingSeekPos = -1;
+        bool                    m_bSeeking = false;
+        CVideoFrameQueue        m_frameQueue;
+        std::atomic<size_t>     m_generation{0};
+        std::atomic<size_t>     m_consumedPos{0};
+        //Capture thread reached the end: it is restarted only after a seek or a stop
+        std::atomic_bool        m_bCaptureEnded{false};
+        CVideoPipelineStats     m_stats;
+        mutable std::mutex      m_statsMutex;
         const int               m_readTimeout = 5000; //in milliseconds
         const int               m_writeTimeout = 5000; //in milliseconds
 };
@@ -122,6 +163,7 @@ class CVideoManager : public QObject
         CMat                getCurrentImage(const QModelIndex& index);
         CDataVideoInfoPtr   getVideoInfo(const QModelIndex& index);
         CDataVideoBuffer::Type  getSourceType(const QModelIndex& index);
+        size_t              getFrameCount(const std::string& path);
 
         void                play(const QModelIndex& modelIndex, size_t inputIndex);
 
@@ -147,6 +189,8 @@ class CVideoManager : public QObject
 
         void                enableInfoUpdate(const QModelIndex& index, bool bEnable);
 
+        void                indexVideos(const std::vector<std::string>& paths);
+
     public slots:
 
         void                onNotifyVideoStart(const QModelIndex &index);
@@ -195,6 +239,7 @@ class CVideoManager : public QObject
 
         std::map<QPersistentModelIndex, CVideoPlayer*> m_players;
 
+        CVideoIndex             m_videoIndex;
         CProjectManager*        m_pProjectMgr = nullptr;
         CProgressBarManager*    m_pProgressMgr = nullptr;
         CProgressSignalHandler* m_pProgressSignal = nullptr;
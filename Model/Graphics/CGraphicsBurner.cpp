@@ -0,0 +1,196 @@
+// Copyright (C) 2021 Ikomia SAS
+// Contact: https://www.ikomia.com
+//
+// This file is part of the IkomiaStudio software.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "CGraphicsBurner.h"
+#include <QtConcurrent>
+#include <QThread>
+#include "Graphics/CGraphicsPoint.h"
+#include "Graphics/CGraphicsRectangle.h"
+#include "Graphics/CGraphicsEllipse.h"
+#include "Graphics/CGraphicsPolygon.h"
+#include "Graphics/CGraphicsPolyline.h"
+
+CGraphicsBurner::CGraphicsBurner()
+{
+}
+
+void CGraphicsBurner::add(CGraphicsItem *pItem)
+{
+    if(pItem == nullptr)
+        return;
+
+    CEntry entry;
+    entry.m_pItem = pItem;
+    entry.m_bBarrier = pItem->isTextItem();
+
+    //Layers are at scene origin: scene coordinates are image coordinates.
+    //Shape items bounding rect already includes half of the pen width
+    auto pShapeItem = dynamic_cast<QAbstractGraphicsShapeItem*>(pItem);
+    if(pShapeItem)
+    {
+        qreal padding = pShapeItem->pen().widthF() / 2.0;
+        entry.m_rect = pShapeItem->sceneBoundingRect().adjusted(-padding, -padding, padding, padding);
+    }
+    else
+        entry.m_bBarrier = true;
+
+    m_entries.push_back(entry);
+}
+
+void CGraphicsBurner::add(const ProxyGraphicsItemPtr &itemPtr)
+{
+    if(itemPtr == nullptr)
+        return;
+
+    CEntry entry;
+    entry.m_proxyPtr = itemPtr;
+
+    qreal padding = 0;
+    if(itemPtr->isTextItem() || getStrokePadding(itemPtr, padding) == false)
+        entry.m_bBarrier = true;
+    else
+        entry.m_rect = itemPtr->getBoundingQRect().adjusted(-padding, -padding, padding, padding);
+
+    m_entries.push_back(entry);
+}
+
+bool CGraphicsBurner::getStrokePadding(const ProxyGraphicsItemPtr &itemPtr, qreal &padding)
+{
+    //Geometry bounds don't include strokes and point markers: padding is the full size (conservative)
+    if(auto pointPtr = std::dynamic_pointer_cast<CProxyGraphicsPoint>(itemPtr))
+        padding = pointPtr->m_property.m_size;
+    else if(auto rectPtr = std::dynamic_pointer_cast<CProxyGraphicsRect>(itemPtr))
+        padding = rectPtr->m_property.m_lineSize;
+    else if(auto ellipsePtr = std::dynamic_pointer_cast<CProxyGraphicsEllipse>(itemPtr))
+        padding = ellipsePtr->m_property.m_lineSize;
+    else if(auto polygonPtr = std::dynamic_pointer_cast<CProxyGraphicsPolygon>(itemPtr))
+        padding = polygonPtr->m_property.m_lineSize;
+    else if(auto polylinePtr = std::dynamic_pointer_cast<CProxyGraphicsPolyline>(itemPtr))
+        padding = polylinePtr->m_property.m_lineSize;
+    else
+        return false;
+
+    return true;
+}
+
+void CGraphicsBurner::burn(CMat &image, bool bBgr)
+{
+    if(!image.data || m_entries.empty())
+        return;
+
+    const int width = (int)image.getNbCols();
+    const int height = (int)image.getNbRows();
+
+    if(m_entries.size() < m_minParallelCount || QThread::idealThreadCount() < 2)
+    {
+        CGraphicsConversion graphicsConv(width, height);
+        for(auto&& entry : m_entries)
+            draw(entry, image, graphicsConv, bBgr);
+
+        return;
+    }
+
+    const size_t chunkCount = (size_t)QThread::idealThreadCount() * 4;
+    auto waves = computeWaves(width, height);
+
+    for(auto&& wave : waves)
+    {
+        if(wave.size() < m_minParallelCount)
+        {
+            CGraphicsConversion graphicsConv(width, height);
+            for(auto index : wave)
+                draw(m_entries[index], image, graphicsConv, bBgr);
+        }
+        else
+        {
+            //Items of a wave write disjoint pixels: one conversion per chunk of items
+            std::vector<std::pair<size_t, size_t>> chunks;
+            size_t chunkSize = (wave.size() + chunkCount - 1) / chunkCount;
+
+            for(size_t i=0; i<wave.size(); i+=chunkSize)
+                chunks.push_back(std::make_pair(i, std::min(i + chunkSize, wave.size())));
+
+            QtConcurrent::blockingMap(chunks, [&](const std::pair<size_t, size_t>& chunk)
+            {
+                CGraphicsConversion graphicsConv(width, height);
+                for(size_t i=chunk.first; i<chunk.second; ++i)
+                    draw(m_entries[wave[i]], image, graphicsConv, bBgr);
+            });
+        }
+    }
+}
+
+std::vector<std::vector<size_t>> CGraphicsBurner::computeWaves(int width, int height) const
+{
+    //Wave of an item: 1 + highest wave among previous items sharing a grid cell with it.
+    //Cells are coarser than items so sharing a cell is a conservative overlap test.
+    const int gridCols = (width + m_cellSize - 1) / m_cellSize;
+    const int gridRows = (height + m_cellSize - 1) / m_cellSize;
+    std::vector<int> grid((size_t)gridCols * gridRows, -1);
+    std::vector<std::vector<size_t>> waves;
+    int barrierWave = -1;
+    int maxWave = -1;
+
+    for(size_t i=0; i<m_entries.size(); ++i)
+    {
+        const CEntry& entry = m_entries[i];
+        int wave = barrierWave + 1;
+
+        if(entry.m_bBarrier)
+        {
+            wave = maxWave + 1;
+            barrierWave = wave;
+        }
+        else
+        {
+            int left = std::max(0, (int)std::floor(entry.m_rect.left()) - m_margin) / m_cellSize;
+            int top = std::max(0, (int)std::floor(entry.m_rect.top()) - m_margin) / m_cellSize;
+            int right = std::min(width - 1, (int)std::ceil(entry.m_rect.right()) + m_margin) / m_cellSize;
+            int bottom = std::min(height - 1, (int)std::ceil(entry.m_rect.bottom()) + m_margin) / m_cellSize;
+
+            //Outside the image (right < left or bottom < top): no cell
+            for(int y=top; y<=bottom; ++y)
+            {
+                for(int x=left; x<=right; ++x)
+                    wave = std::max(wave, grid[y * gridCols + x] + 1);
+            }
+
+            for(int y=top; y<=bottom; ++y)
+            {
+                for(int x=left; x<=right; ++x)
+                    grid[y * gridCols + x] = wave;
+            }
+        }
+
+        maxWave = std::max(maxWave, wave);
+        if((int)waves.size() <= wave)
+            waves.resize(wave + 1);
+
+        waves[wave].push_back(i);
+    }
+    return waves;
+}
+
+void CGraphicsBurner::draw(const CGraphicsBurner::CEntry &entry, CMat &image, CGraphicsConversion &conv, bool bBgr) const
+{
+    //Double dispatch design pattern
+    if(entry.m_pItem)
+        entry.m_pItem->insertToImage(image, conv, false, false);
+    else if(entry.m_proxyPtr)
+        entry.m_proxyPtr->insertToImage(image, conv, false, false, bBgr);
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2021 Ikomia SAS
+ * Contact: https://www.ikomia.com
+ *
+ * This file is part of the IkomiaStudio software.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CGRAPHICSBURNER_H
+#define CGRAPHICSBURNER_H
+
+#include "Data/CMat.hpp"
+#include "Graphics/CGraphicsItem.hpp"
+#include "Graphics/CGraphicsConversion.h"
+
+// Burn graphics items into an image with several threads.
+// Items are drawn by waves: items of a same wave don't overlap and an item is always
+// drawn after the previous items it overlaps, so the result is identical to a
+// sequential drawing in insertion order. Item bounds are inflated by their stroke
+// width or point size. Text items (bounds known only at drawing) and items whose
+// stroke is unknown are drawn alone.
+class CGraphicsBurner
+{
+    public:
+
+        CGraphicsBurner();
+
+        void    add(CGraphicsItem* pItem);
+        void    add(const ProxyGraphicsItemPtr& itemPtr);
+
+        void    burn(CMat& image, bool bBgr=false);
+
+    private:
+
+        struct CEntry
+        {
+            CGraphicsItem*          m_pItem = nullptr;
+            ProxyGraphicsItemPtr    m_proxyPtr = nullptr;
+            QRectF                  m_rect;
+            bool                    m_bBarrier = false;
+        };
+
+        std::vector<std::vector<size_t>>    computeWaves(int width, int height) const;
+
+        static bool getStrokePadding(const ProxyGraphicsItemPtr& itemPtr, qreal& padding);
+
+        void    draw(const CEntry& entry, CMat& image, CGraphicsConversion& conv, bool bBgr) const;
+
+    private:
+
+        //Under this count, items are drawn sequentially
+        const size_t            m_minParallelCount = 64;
+        //Cell size of the occupancy grid
+        const int               m_cellSize = 32;
+        //Antialiasing and rounding margin (pixels)
+        const int               m_margin = 2;
+        std::vector<CEntry>     m_entries;
+};
+
+#endif // CGRAPHICSBURNER_H
@@ -65,6 +65,11 @@ void CGraphicsDbManager::batchSave()
 {
 }
 
+void CGraphicsDbManager::removeItems(const std::vector<int>& dbIds)
+{
+    removeRows("graphics", "layerId", dbIds);
+}
+
 int CGraphicsDbManager::getLayerChildsCount(int layerId)
 {
     auto db = connectDB();
@@ -132,50 +137,37 @@ void CGraphicsDbManager::updateProjectId(int oldId, int newId)
         throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
 }
 
-GraphicsDbInfo CGraphicsDbManager::loadGraphics(size_t typeId, const QString& path)
+GraphicsDbInfo CGraphicsDbManager::loadGraphics(const std::vector<int>& layerIds)
 {
+    GraphicsDbInfo info;
+    if(layerIds.empty())
+        return info;
+
     auto db = connectDB();
     if(db.isValid() == false)
         throw CException(DatabaseExCode::INVALID_QUERY, "Invalid database connection", __func__, __FILE__, __LINE__);
 
-    //Get project row for image from its path
-    QString type;
-    switch(typeId)
-    {
-        case TreeItemType::IMAGE:
-            type = "image";
-            break;
-        case TreeItemType::VIDEO:
-            type = "video";
-            break;
-        case TreeItemType::LIVE_STREAM:
-            type = "Stream";
-            break;
-    }
-    QSqlQuery q(db);
-    if(!q.exec(QString("SELECT p.left, p.right FROM project p INNER JOIN %1 i ON p.id = i.itemId WHERE i.path = '%2';").arg(type).arg(path)))
-        throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+    //Project saved without graphics
+    if(db.tables(QSql::Tables).contains("graphics") == false)
+        return info;
 
-    if(!q.next())
-        throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+    QStringList ids;
+    for(auto id : layerIds)
+        ids << QString::number(id);
 
-    int left = q.value(0).toInt();
-    int right = q.value(1).toInt();
+    //Get all graphics items of the given layers (indexed by layerId)
+    QSqlQuery q(db);
+    q.setForwardOnly(true);
 
-    //Get all graphics items for this image
-    if(!q.exec(QString("SELECT g.type, g.data, p.id FROM graphics g INNER JOIN project p ON g.layerId = p.id\
-                        WHERE (SELECT p.id FROM project p WHERE p.left > %1 AND p.right < %2);").arg(left).arg(right)))
-    {
+    if(!q.exec(QString("SELECT type, data, layerId FROM graphics WHERE layerId IN (%1) ORDER BY layerId, id;").arg(ids.join(","))))
         throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
-    }
 
-    GraphicsDbInfo info;
     while(q.next())
     {
         int itemType = q.value(0).toInt();
         QByteArray itemData = q.value(1).toByteArray();
         int layerId = q.value(2).toInt();
-        info.insert(std::make_pair(layerId, std::make_pair(itemType, itemData)));
+        info[layerId].push_back(std::make_pair(itemType, itemData));
     }
     return info;
 }
@@ -221,4 +213,14 @@ void CGraphicsDbManager::createTables()
        if(!q.exec("CREATE TABLE graphics (id INTEGER PRIMARY KEY, type INTEGER, data BLOB, layerId INTEGER);"))
            throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
     }
+
+    if(!createIndexes(db))
+        throw CException(DatabaseExCode::INVALID_QUERY, "Unable to create graphics index", __func__, __FILE__, __LINE__);
+}
+
+bool CGraphicsDbManager::createIndexes(QSqlDatabase &db)
+{
+    //Graphics items are always fetched, replaced or removed by layer
+    QSqlQuery q(db);
+    return q.exec("CREATE INDEX IF NOT EXISTS graphicsLayerIndex ON graphics (layerId);");
 }
@@ -25,7 +25,8 @@
 
 class CGraphicsLayer;
 
-using GraphicsDbInfo = std::unordered_multimap<int, std::pair<int, QByteArray>>;
+//Graphics items (type, data) per layer id, in insertion order
+using GraphicsDbInfo = std::unordered_map<int, std::vector<std::pair<int, QByteArray>>>;
 
 class CGraphicsDbManager: public CProjectItemBaseDbMgr
 {
@@ -38,8 +39,9 @@ class CGraphicsDbManager: public CProjectItemBaseDbMgr
         std::shared_ptr<CItem>  load(const QSqlQuery& q, QModelIndex& previousIndex) override;
         void                    save(std::shared_ptr<ProjectTreeItem> itemPtr, int dbId) override;
         void                    batchSave() override;
+        void                    removeItems(const std::vector<int>& dbIds) override;
 
-        GraphicsDbInfo          loadGraphics(size_t typeId, const QString& path);
+        GraphicsDbInfo          loadGraphics(const std::vector<int>& layerIds);
 
         void                    remove(std::vector<int> layerIds);
 
@@ -48,6 +50,7 @@ class CGraphicsDbManager: public CProjectItemBaseDbMgr
         QSqlDatabase            connectDB();
 
         void                    createTables();
+        bool                    createIndexes(QSqlDatabase& db);
 
         int                     getLayerChildsCount(int layerId);
 
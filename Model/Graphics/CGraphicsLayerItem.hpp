@@ -51,6 +51,7 @@ class CGraphicsLayerItem : public CItem
         void            setName(const std::string& name) override
         {
             m_name = name;
+            m_bModified = true;
             if(m_pLayer)
                 m_pLayer->setName(QString::fromStdString(name));
         }
@@ -17,14 +17,26 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "CGraphicsManager.h"
+#include <QtConcurrent>
+#include <QJsonDocument>
 #include <QDebug>
 #include "Main/LogCategory.h"
 #include "Main/AppTools.hpp"
 #include "Graphics/CGraphicsLayer.h"
+#include "Graphics/CGraphicsJSON.h"
+#include "Graphics/CGraphicsPoint.h"
+#include "Graphics/CGraphicsRectangle.h"
+#include "Graphics/CGraphicsEllipse.h"
+#include "Graphics/CGraphicsPolygon.h"
+#include "Graphics/CGraphicsPolyline.h"
+#include "Graphics/CGraphicsComplexPolygon.h"
+#include "Graphics/CGraphicsText.h"
+#include "CGraphicsBurner.h"
 
 CGraphicsManager::CGraphicsManager()
 {
     m_contextPtr = std::make_shared<CGraphicsContext>();
+    m_loadPool.setMaxThreadCount(1);
 }
 
 GraphicsContextPtr CGraphicsManager::getContext()
@@ -448,34 +460,30 @@ void CGraphicsManager::burnGraphicsToImage(const QModelIndex& imageIndex, CMat &
 
 void CGraphicsManager::burnGraphicsToImage(const std::vector<ProxyGraphicsItemPtr> &items, CMat &image)
 {
-    CGraphicsConversion graphicsConv((int)image.getNbCols(), (int)image.getNbRows());
-
-    //Double dispatch design pattern
+    CGraphicsBurner burner;
     for(auto it : items)
-        it->insertToImage(image, graphicsConv, false, false);
+        burner.add(it);
+
+    burner.burn(image);
 }
 
 void CGraphicsManager::burnLayerToImage(const CGraphicsLayer *pLayer, CMat &image)
 {
-    if(pLayer->isVisible() == false)
-        return;
-
-    CGraphicsConversion graphicsConv((int)image.getNbCols(), (int)image.getNbRows());
-    auto items = pLayer->getChildItems();
-
-    //Double dispatch design pattern
-    for(auto it : items)
-        dynamic_cast<CGraphicsItem*>(it)->insertToImage(image, graphicsConv, false, false);
-
-    auto childLayers = pLayer->getChildLayers();
-    for(auto it : childLayers)
-        burnLayerToImage(it, image);
+    CGraphicsBurner burner;
+    addLayerToBurner(pLayer, burner);
+    burner.burn(image);
 }
 
 void CGraphicsManager::onGraphicsChanged()
 {
     assert(m_pProjectMgr);
     assert(m_pWorkflowMgr);
+
+    //Graphics items are edited in the current layer: it has to be written on next save
+    auto pLayerItem = getLayerItem(m_currentLayerIndex);
+    if(pLayerItem)
+        pLayerItem->setModified(true);
+
     m_pProjectMgr->notifyDataChanged();
     m_pWorkflowMgr->notifyGraphicsChanged();
 }
@@ -489,6 +497,10 @@ void CGraphicsManager::onGraphicsRemoved(const QSet<CGraphicsLayer *> &layers)
     for(auto it: layers)
     {
         QModelIndex layerIndex = findLayerFromName(it->getName());
+        auto pLayerItem = getLayerItem(layerIndex);
+        if(pLayerItem)
+            pLayerItem->setModified(true);
+
         removeValidEmptyLayers(layerIndex);
     }
 
@@ -587,6 +599,20 @@ QModelIndex CGraphicsManager::createRootLayer()
     return layerIndex;
 }
 
+void CGraphicsManager::addLayerToBurner(const CGraphicsLayer *pLayer, CGraphicsBurner &burner)
+{
+    if(pLayer->isVisible() == false)
+        return;
+
+    auto items = pLayer->getChildItems();
+    for(auto it : items)
+        burner.add(dynamic_cast<CGraphicsItem*>(it));
+
+    auto childLayers = pLayer->getChildLayers();
+    for(auto it : childLayers)
+        addLayerToBurner(it, burner);
+}
+
 void CGraphicsManager::fillLayerTreeIds(const QModelIndex &layerIndex, std::vector<int> &ids)
 {
     auto pLayerItem = getLayerItem(layerIndex);
@@ -606,7 +632,51 @@ void CGraphicsManager::fillLayerTreeIds(const QModelIndex &layerIndex, std::vect
     }
 }
 
-void CGraphicsManager::loadLayer(CGraphicsLayer* pParentLayer, const QModelIndex& layerIndex, const GraphicsDbInfo &layersInfo)
+void CGraphicsManager::loadLayersAsync(const QModelIndex &imgIndex, const QModelIndex &rootLayerIndex, const QString &dbPath, const QString &connectionName)
+{
+    std::vector<int> layerIds;
+    fillLayerTreeIds(rootLayerIndex, layerIds);
+
+    QPersistentModelIndex imgPersistentIndex(imgIndex);
+    QPersistentModelIndex rootLayerPersistentIndex(rootLayerIndex);
+    auto pWatcher = new QFutureWatcher<CGraphicsLoadResult>(this);
+
+    connect(pWatcher, &QFutureWatcher<CGraphicsLoadResult>::finished, [this, pWatcher, imgPersistentIndex, rootLayerPersistentIndex]
+    {
+        CGraphicsLoadResult result = pWatcher->result();
+        pWatcher->deleteLater();
+        onLayersLoaded(imgPersistentIndex, rootLayerPersistentIndex, result);
+    });
+
+    //Dedicated connection for the loader thread
+    QString loaderConnection = connectionName + "GraphicsLoader";
+
+    //Rows are read and JSON blobs decoded here: graphics items (some are QObject) must be created in the main thread
+    auto future = QtConcurrent::run(&m_loadPool, [dbPath, loaderConnection, layerIds]
+    {
+        CGraphicsLoadResult result;
+        result.m_layerIds = layerIds;
+        try
+        {
+            GraphicsDbInfo dbInfo;
+            {
+                CGraphicsDbManager graphicsDB(dbPath, loaderConnection);
+                dbInfo = graphicsDB.loadGraphics(layerIds);
+            }
+            result.m_items = decodeGraphics(dbInfo);
+            result.m_bSuccess = true;
+        }
+        catch(std::exception& e)
+        {
+            qCCritical(logGraphics).noquote() << QString::fromStdString(e.what());
+        }
+        QSqlDatabase::removeDatabase(loaderConnection);
+        return result;
+    });
+    pWatcher->setFuture(future);
+}
+
+void CGraphicsManager::loadLayer(CGraphicsLayer* pParentLayer, const QModelIndex& layerIndex, const GraphicsJsonInfo &layersInfo)
 {
     //Warning :: layerIndex is from CProjectModel not from CMultiProjectModel
     auto pModel = static_cast<const CProjectModel*>(layerIndex.model());
@@ -623,15 +693,18 @@ void CGraphicsManager::loadLayer(CGraphicsLayer* pParentLayer, const QModelIndex
     }
 
     //Add all child items (CGraphicsItem)
-    CGraphicsJSON jsonMgr;
-    auto pFactory = m_registration.getQtBasedFactory();
-    auto itRange = layersInfo.equal_range(pLayerItem->getDbId());
-
-    for(auto it=itRange.first; it!=itRange.second; ++it)
+    auto itItems = layersInfo.find(pLayerItem->getDbId());
+    if(itItems != layersInfo.end())
     {
-        auto pItem = dynamic_cast<CGraphicsItem*>(pFactory.createObject(it->second.first, (QGraphicsItem*)pLayer));
-        if(pItem)
-            pItem->buildFromJsonData(jsonMgr, it->second.second);
+        CGraphicsJSON jsonMgr;
+        auto pFactory = m_registration.getQtBasedFactory();
+
+        for(auto&& record : itItems->second)
+        {
+            auto pItem = dynamic_cast<CGraphicsItem*>(pFactory.createObject(record.first, (QGraphicsItem*)pLayer));
+            if(pItem)
+                buildItem(pItem, jsonMgr, record.second);
+        }
     }
 
     //Iterate through all child layers
@@ -646,6 +719,85 @@ void CGraphicsManager::loadLayer(CGraphicsLayer* pParentLayer, const QModelIndex
     }
 }
 
+GraphicsJsonInfo CGraphicsManager::decodeGraphics(const GraphicsDbInfo &dbInfo)
+{
+    //Called from the loader thread: JSON decoding is the costly part of the load
+    GraphicsJsonInfo info;
+    for(auto&& layer : dbInfo)
+    {
+        auto& items = info[layer.first];
+        items.reserve(layer.second.size());
+
+        for(auto&& record : layer.second)
+        {
+            QJsonDocument doc = QJsonDocument::fromBinaryData(record.second);
+            if(doc.isNull())
+            {
+                qCWarning(logGraphics).noquote() << tr("Invalid graphics item data in layer %1").arg(layer.first);
+                continue;
+            }
+            items.push_back(std::make_pair(record.first, doc.object()));
+        }
+    }
+    return info;
+}
+
+void CGraphicsManager::buildItem(CGraphicsItem *pItem, CGraphicsJSON &jsonMgr, const QJsonObject &data)
+{
+    //Data already decoded: only item properties are set in the main thread
+    if(auto pPoint = dynamic_cast<CGraphicsPoint*>(pItem))
+        jsonMgr.buildObject(pPoint, data);
+    else if(auto pRect = dynamic_cast<CGraphicsRectangle*>(pItem))
+        jsonMgr.buildObject(pRect, data);
+    else if(auto pEllipse = dynamic_cast<CGraphicsEllipse*>(pItem))
+        jsonMgr.buildObject(pEllipse, data);
+    else if(auto pPolygon = dynamic_cast<CGraphicsPolygon*>(pItem))
+        jsonMgr.buildObject(pPolygon, data);
+    else if(auto pPolyline = dynamic_cast<CGraphicsPolyline*>(pItem))
+        jsonMgr.buildObject(pPolyline, data);
+    else if(auto pComplexPolygon = dynamic_cast<CGraphicsComplexPolygon*>(pItem))
+        jsonMgr.buildObject(pComplexPolygon, data);
+    else if(auto pText = dynamic_cast<CGraphicsText*>(pItem))
+        jsonMgr.buildObject(pText, data);
+    else
+        pItem->buildFromJsonData(jsonMgr, QJsonDocument(data).toBinaryData());
+}
+
+void CGraphicsManager::onLayersLoaded(const QPersistentModelIndex &imgIndex, const QPersistentModelIndex &rootLayerIndex, const CGraphicsLoadResult &result)
+{
+    //Read failure: layers stay unloaded, otherwise empty layers would replace stored graphics on next save
+    if(result.m_bSuccess == false)
+        return;
+
+    //Current image changed or layers already loaded by a previous request:
+    //layers will be loaded on next display
+    if(imgIndex.isValid() == false || rootLayerIndex.isValid() == false || imgIndex != m_currentImgIndex)
+        return;
+
+    auto pLayerItem = getLayerItem(rootLayerIndex);
+    if(pLayerItem == nullptr || pLayerItem->isLoaded())
+        return;
+
+    //Layer ids changed during the read (project saved): rows don't match layers anymore,
+    //read them again since the image is still displayed
+    std::vector<int> layerIds;
+    fillLayerTreeIds(rootLayerIndex, layerIds);
+
+    if(layerIds != result.m_layerIds)
+    {
+        CProjectDbManager projectDB(m_pProjectMgr->getModel(imgIndex));
+        loadLayersAsync(imgIndex, rootLayerIndex, projectDB.getPath(), projectDB.getConnectionName());
+        return;
+    }
+
+    loadLayer(nullptr, m_pProjectMgr->wrapIndex(rootLayerIndex), result.m_items);
+
+    //Set first child layer as current
+    auto pMultiModel = m_pProjectMgr->getMultiModel();
+    if(pMultiModel->rowCount(rootLayerIndex) > 0)
+        setCurrentLayer(pMultiModel->index(0, 0, rootLayerIndex), true);
+}
+
 void CGraphicsManager::removeValidEmptyLayers(const QModelIndex& layerIndex)
 {
     if(layerIndex.isValid() == false)
@@ -22,6 +22,8 @@
 #define CGRAPHICSMANAGER_H
 
 #include <QObject>
+#include <QThreadPool>
+#include <QJsonObject>
 #include "Main/AppDefine.hpp"
 #include "Graphics/CGraphicsContext.h"
 #include "Graphics/CGraphicsRegistration.h"
@@ -32,6 +34,20 @@
 #include "CGraphicsDbManager.h"
 
 class CGraphicsLayer;
+class CGraphicsBurner;
+class CGraphicsItem;
+class CGraphicsJSON;
+
+//Graphics items (type, decoded JSON data) per layer id, in insertion order
+using GraphicsJsonInfo = std::unordered_map<int, std::vector<std::pair<int, QJsonObject>>>;
+
+//Result of the graphics loader thread: decoded items of the requested layers
+struct CGraphicsLoadResult
+{
+    bool                m_bSuccess = false;
+    std::vector<int>    m_layerIds;
+    GraphicsJsonInfo    m_items;
+};
 
 class CGraphicsManager : public QObject
 {
@@ -92,12 +108,11 @@ class CGraphicsManager : public QObject
 
                     if(pLayerItem->isLoaded() == false)
                     {
-                        //Recursive loading of all graphics layers
+                        //Graphics items are read in a worker thread, they are built
+                        //and current layer is set once the read is complete
                         CProjectDbManager projectDB(m_pProjectMgr->getModel(index));
-                        QString path = QString::fromStdString(itemPtr->getFullPath());
-                        CGraphicsDbManager graphicsDB(projectDB.getPath(), projectDB.getConnectionName());
-                        GraphicsDbInfo info = graphicsDB.loadGraphics(itemPtr->getTypeId(), path);
-                        loadLayer(nullptr, wrapRootLayerIdx, info);
+                        loadLayersAsync(index, rootLayerIndex, projectDB.getPath(), projectDB.getConnectionName());
+                        return false;
                     }
 
                     //Set first child layer as current
@@ -167,9 +182,17 @@ class CGraphicsManager : public QObject
 
         QModelIndex             addLayer(CGraphicsLayer* pLayer, const QModelIndex& parentIndex);
 
+        void                    addLayerToBurner(const CGraphicsLayer* pLayer, CGraphicsBurner& burner);
+
         void                    fillLayerTreeIds(const QModelIndex& layerIndex, std::vector<int>& ids);
 
-        void                    loadLayer(CGraphicsLayer *pParentLayer, const QModelIndex &layerIndex, const GraphicsDbInfo& layersInfo);
+        void                    loadLayersAsync(const QModelIndex& imgIndex, const QModelIndex& rootLayerIndex, const QString& dbPath, const QString& connectionName);
+        void                    loadLayer(CGraphicsLayer *pParentLayer, const QModelIndex &layerIndex, const GraphicsJsonInfo& layersInfo);
+
+        static GraphicsJsonInfo decodeGraphics(const GraphicsDbInfo& dbInfo);
+        static void             buildItem(CGraphicsItem* pItem, CGraphicsJSON& jsonMgr, const QJsonObject& data);
+
+        void                    onLayersLoaded(const QPersistentModelIndex& imgIndex, const QPersistentModelIndex& rootLayerIndex, const CGraphicsLoadResult& result);
 
         void                    removeValidEmptyLayers(const QModelIndex &layerIndex);
 
@@ -183,6 +206,8 @@ class CGraphicsManager : public QObject
         //Layer database ids per project to be removed
         std::unordered_map<int, std::vector<int>>   m_removedLayers;
         GraphicsContextPtr      m_contextPtr;
+        //Single loader thread: graphics loading requests are serialized
+        QThreadPool             m_loadPool;
 };
 
 #endif // CGRAPHICSMANAGER_H
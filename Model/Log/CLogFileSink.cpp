@@ -0,0 +1,115 @@
+// Copyright (C) 2021 Ikomia SAS
+// Contact: https://www.ikomia.com
+//
+// This file is part of the IkomiaStudio software.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "CLogFileSink.h"
+
+CLogFileSink::CLogFileSink()
+{
+}
+
+CLogFileSink::~CLogFileSink()
+{
+    stop();
+}
+
+void CLogFileSink::start(const QString &path)
+{
+    stop();
+
+    m_path = path;
+    m_file.setFileName(m_path);
+    if(!m_file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text))
+        return;
+
+    // One write per batch, buffered by the stream
+    m_stream.setDevice(&m_file);
+    m_dropped = 0;
+    m_bStop = false;
+    // Dedicated thread: the writer lives as long as the application and must not hold a pool slot
+    m_thread = std::thread([this]{ run(); });
+}
+
+void CLogFileSink::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if(m_bStop)
+            return;
+
+        m_bStop = true;
+    }
+    m_cond.notify_one();
+
+    if(m_thread.joinable())
+        m_thread.join();
+
+    // Pending messages are written before the file is closed
+    flush();
+    std::lock_guard<std::mutex> lock(m_fileMutex);
+    m_stream.setDevice(nullptr);
+    m_file.close();
+}
+
+void CLogFileSink::write(int type, const QString &msg, const QString &categoryName)
+{
+    m_queue.push(type, msg, categoryName);
+
+    if(type == QtCriticalMsg || type == QtFatalMsg)
+        flush();
+}
+
+void CLogFileSink::flush()
+{
+    std::lock_guard<std::mutex> lock(m_fileMutex);
+    if(m_file.isOpen() == false)
+        return;
+
+    bool bWritten = false;
+    CLogEntry entry;
+
+    while(m_queue.pop(entry))
+    {
+        m_stream << entry.m_dateTime.toString("yyyy-MM-dd HH:mm:ss") << ": " << entry.m_msg << "\n";
+        bWritten = true;
+    }
+
+    size_t dropped = m_queue.getDroppedCount();
+    if(dropped > m_dropped)
+    {
+        m_stream << QString("%1 log message(s) dropped").arg(dropped - m_dropped) << "\n";
+        m_dropped = dropped;
+        bWritten = true;
+    }
+
+    if(bWritten)
+        m_stream.flush();
+}
+
+void CLogFileSink::run()
+{
+    bool bStop = false;
+    while(!bStop)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cond.wait_for(lock, std::chrono::milliseconds(m_flushPeriod), [this]{ return m_bStop; });
+            bStop = m_bStop;
+        }
+        flush();
+    }
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2021 Ikomia SAS
+ * Contact: https://www.ikomia.com
+ *
+ * This file is part of the IkomiaStudio software.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CLOGFILESINK_H
+#define CLOGFILESINK_H
+
+#include <QFile>
+#include <QTextStream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "CLogQueue.hpp"
+
+// Log file writer: callers only enqueue, a dedicated thread keeps the file open
+// and writes pending messages in batches. Critical and fatal messages are written
+// synchronously so that the file sent with crash reports is complete.
+class CLogFileSink
+{
+    public:
+
+        CLogFileSink();
+        ~CLogFileSink();
+
+        void        start(const QString& path);
+        void        stop();
+
+        // Thread-safe, blocks only for critical and fatal messages
+        void        write(int type, const QString& msg, const QString& categoryName);
+
+        // Write pending messages now
+        void        flush();
+
+    private:
+
+        void        run();
+
+    private:
+
+        const int               m_flushPeriod = 50; // ms
+        QString                 m_path;
+        CLogQueue               m_queue;
+        QFile                   m_file;
+        QTextStream             m_stream;
+        std::thread             m_thread;
+        bool                    m_bStop = true;
+        size_t                  m_dropped = 0;
+        std::mutex              m_mutex;
+        // Serializes queue consumers: writer thread and synchronous flushes
+        std::mutex              m_fileMutex;
+        std::condition_variable m_cond;
+};
+
+#endif // CLOGFILESINK_H
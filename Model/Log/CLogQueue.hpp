@@ -0,0 +1,142 @@
+// Copyright (C) 2021 Ikomia SAS
+// Contact: https://www.ikomia.com
+//
+// This file is part of the IkomiaStudio software.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef CLOGQUEUE_HPP
+#define CLOGQUEUE_HPP
+
+#include <atomic>
+#include <QString>
+#include <QDateTime>
+#include <QVector>
+
+struct CLogEntry
+{
+    int         m_type = QtInfoMsg;
+    QString     m_msg;
+    QString     m_category;
+    // Time of emission: entries may be written a while later
+    QDateTime   m_dateTime;
+};
+
+using CLogEntries = QVector<CLogEntry>;
+
+// Bounded lock-free multiple producers / single consumer queue (linked list with stub node).
+// Producers never block: messages are dropped and counted when the queue is full.
+class CLogQueue
+{
+    public:
+
+        CLogQueue(size_t capacity = 100000) : m_capacity(capacity)
+        {
+            m_pTail = new CNode;
+            m_pHead = m_pTail;
+        }
+
+        ~CLogQueue()
+        {
+            CLogEntry entry;
+            while(pop(entry));
+            delete m_pTail;
+        }
+
+        CLogQueue(const CLogQueue&) = delete;
+        CLogQueue& operator=(const CLogQueue&) = delete;
+
+        // Thread-safe
+        bool        push(int type, const QString& msg, const QString& category)
+        {
+            if(m_size.fetch_add(1, std::memory_order_relaxed) >= m_capacity)
+            {
+                m_size.fetch_sub(1, std::memory_order_relaxed);
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            m_count.fetch_add(1, std::memory_order_relaxed);
+
+            auto pNode = new CNode;
+            pNode->m_entry.m_type = type;
+            pNode->m_entry.m_msg = msg;
+            pNode->m_entry.m_category = category;
+            pNode->m_entry.m_dateTime = QDateTime::currentDateTime();
+
+            CNode* pPrev = m_pHead.exchange(pNode, std::memory_order_acq_rel);
+            pPrev->m_pNext.store(pNode, std::memory_order_release);
+            return true;
+        }
+
+        // Consumer thread only
+        bool        pop(CLogEntry& entry)
+        {
+            CNode* pNext = m_pTail->m_pNext.load(std::memory_order_acquire);
+            if(pNext == nullptr)
+                return false;
+
+            // Next node becomes the stub
+            entry = std::move(pNext->m_entry);
+            delete m_pTail;
+            m_pTail = pNext;
+            m_size.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        // Consumer thread only
+        size_t      popAll(CLogEntries& entries, size_t maxCount = SIZE_MAX)
+        {
+            size_t count = 0;
+            CLogEntry entry;
+
+            while(count < maxCount && pop(entry))
+            {
+                entries.push_back(std::move(entry));
+                count++;
+            }
+            return count;
+        }
+
+        size_t      getSize() const
+        {
+            return m_size.load(std::memory_order_relaxed);
+        }
+        size_t      getCount() const
+        {
+            return m_count.load(std::memory_order_relaxed);
+        }
+        size_t      getDroppedCount() const
+        {
+            return m_dropped.load(std::memory_order_relaxed);
+        }
+
+    private:
+
+        struct CNode
+        {
+            std::atomic<CNode*> m_pNext{nullptr};
+            CLogEntry           m_entry;
+        };
+
+    private:
+
+        std::atomic<CNode*> m_pHead{nullptr};
+        CNode*              m_pTail = nullptr;
+        const size_t        m_capacity;
+        std::atomic_size_t  m_size{0};
+        std::atomic_size_t  m_count{0};
+        std::atomic_size_t  m_dropped{0};
+};
+
+#endif // CLOGQUEUE_HPP
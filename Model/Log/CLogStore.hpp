@@ -0,0 +1,166 @@
+// Copyright (C) 2021 Ikomia SAS
+// Contact: https://www.ikomia.com
+//
+// This file is part of the IkomiaStudio software.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef CLOGSTORE_HPP
+#define CLOGSTORE_HPP
+
+#include <algorithm>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <QStringList>
+#include "CLogQueue.hpp"
+
+// Message filter of the notification center: words of the search box and checked categories
+struct CLogFilter
+{
+    QStringList m_words;
+    QStringList m_categories;
+
+    bool    isActive() const
+    {
+        return m_words.isEmpty() == false || m_categories.isEmpty() == false;
+    }
+
+    bool    accept(const CLogEntry& entry) const
+    {
+        bool bRet = m_words.isEmpty();
+        for(int i=0; i<m_words.size() && !bRet; ++i)
+            bRet = entry.m_msg.contains(m_words[i], Qt::CaseInsensitive);
+
+        if(m_categories.isEmpty() == false)
+        {
+            bRet = bRet && m_categories.contains(entry.m_category);
+            for(int i=0; i<m_categories.size() && !bRet; ++i)
+                bRet = entry.m_msg.contains(m_categories[i], Qt::CaseInsensitive);
+        }
+        return bRet;
+    }
+};
+
+// Append-only log history with a maximum size (oldest entries are discarded).
+// Entries are identified by a sequence number that is never reused.
+// Entries are stored in chunks allocated once at full size: appending only assigns a slot
+// beyond the end of existing snapshots, never the vector itself. A snapshot shares the chunks
+// and stays readable from another thread while new entries are appended.
+class CLogStore
+{
+    public:
+
+        using Chunk = std::vector<CLogEntry>;
+        using ChunkPtr = std::shared_ptr<Chunk>;
+
+        struct CSnapshot
+        {
+            std::vector<ChunkPtr>   m_chunks;
+            quint64                 m_chunkBase = 0;
+            quint64                 m_begin = 0;
+            quint64                 m_end = 0;
+
+            const CLogEntry&    at(quint64 seq) const
+            {
+                auto index = seq - m_chunkBase;
+                return (*m_chunks[index / m_chunkSize])[index % m_chunkSize];
+            }
+        };
+
+        CLogStore(size_t capacity = 100000) : m_capacity(std::max<size_t>(capacity, 1))
+        {
+        }
+
+        void        setCapacity(size_t capacity)
+        {
+            m_capacity = std::max<size_t>(capacity, 1);
+            trim();
+        }
+
+        // Sequence range of stored entries: [begin, end)
+        quint64     getBegin() const
+        {
+            return m_begin;
+        }
+        quint64     getEnd() const
+        {
+            return m_end;
+        }
+
+        const CLogEntry&    at(quint64 seq) const
+        {
+            assert(seq >= m_begin && seq < m_end);
+            auto index = seq - m_chunkBase;
+            return (*m_chunks[index / m_chunkSize])[index % m_chunkSize];
+        }
+
+        CSnapshot   getSnapshot() const
+        {
+            CSnapshot snapshot;
+            snapshot.m_chunks.assign(m_chunks.begin(), m_chunks.end());
+            snapshot.m_chunkBase = m_chunkBase;
+            snapshot.m_begin = m_begin;
+            snapshot.m_end = m_end;
+            return snapshot;
+        }
+
+        quint64     append(const CLogEntry& entry)
+        {
+            auto index = m_end - m_chunkBase;
+            if(index / m_chunkSize >= m_chunks.size())
+                m_chunks.push_back(std::make_shared<Chunk>(m_chunkSize));
+
+            (*m_chunks.back())[index % m_chunkSize] = entry;
+            m_end++;
+            trim();
+            return m_end - 1;
+        }
+
+        void        clear()
+        {
+            m_chunks.clear();
+            m_begin = m_end;
+            m_chunkBase = m_end;
+        }
+
+    private:
+
+        void        trim()
+        {
+            if(m_end - m_begin > m_capacity)
+                m_begin = m_end - m_capacity;
+
+            // Chunks may still be used by snapshots
+            while(m_chunks.empty() == false && m_chunkBase + m_chunkSize <= m_begin)
+            {
+                m_chunks.pop_front();
+                m_chunkBase += m_chunkSize;
+            }
+        }
+
+    public:
+
+        static const size_t     m_chunkSize = 4096;
+
+    private:
+
+        std::deque<ChunkPtr>    m_chunks;
+        quint64                 m_chunkBase = 0;
+        quint64                 m_begin = 0;
+        quint64                 m_end = 0;
+        size_t                  m_capacity = 100000;
+};
+
+#endif // CLOGSTORE_HPP
@@ -17,6 +17,10 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "CPluginManager.h"
+#include <numeric>
+#include <QElapsedTimer>
+#include <QDirIterator>
+#include <QtConcurrent/QtConcurrent>
 #include "Main/LogCategory.h"
 #include "Main/AppTools.hpp"
 #include "Core/CIkomiaRegistry.h"
@@ -42,8 +46,13 @@ CPluginManager::CPluginManager()
 void CPluginManager::loadProcessPlugins()
 {
     assert(m_pRegistry);
+    QElapsedTimer timer;
+    timer.start();
+
+    m_loadTimes.clear();
     loadCppProcessPlugins();
     loadPythonProcessPlugins();
+    reportLoadTimes(timer.nsecsElapsed() / 1e6);
 }
 
 TaskFactoryPtr CPluginManager::loadProcessPlugin(const QString &name, int language)
@@ -223,6 +232,15 @@ TaskFactoryPtr CPluginManager::loadPythonProcessPlugin(const QString &directory)
     }
 }
 
+std::vector<CPluginLoadTime> CPluginManager::getLoadTimes() const
+{
+    std::vector<CPluginLoadTime> times;
+    for(auto&& it : m_loadTimes)
+        times.push_back(it.second);
+
+    return times;
+}
+
 void CPluginManager::setRegistry(CIkomiaRegistry* pRegistry)
 {
     m_pRegistry = pRegistry;
@@ -481,42 +499,173 @@ void CPluginManager::addToPythonPath(const QString &path)
 void CPluginManager::loadCppProcessPlugins()
 {
     QDir pluginsDir(m_cppPath);
+    QStringList files;
+
+    //Plugins placed directly in the root folder
+    foreach (QString fileName, pluginsDir.entryList(QDir::Files|QDir::NoSymLinks))
+        files.push_back(pluginsDir.absoluteFilePath(fileName));
 
 #ifdef Q_OS_WIN64
     //Add plugin root folder to the search path of the DLL loader
     SetDllDirectoryA(QDir::toNativeSeparators(m_cppPath).toStdString().c_str());
+    loadCppLibraries(files);
 #endif
 
-    //Load plugins placed directly in the root folder
-    foreach (QString fileName, pluginsDir.entryList(QDir::Files|QDir::NoSymLinks))
-        loadCppProcessPlugin(pluginsDir.absoluteFilePath(fileName));
-
     //Scan sub-directories
     foreach (QString directory, pluginsDir.entryList(QDir::Dirs|QDir::NoDotAndDotDot))
     {
         auto dirPath = pluginsDir.absoluteFilePath(directory);
         QDir pluginDir(dirPath);
+        QStringList dirFiles;
+
+        foreach (QString fileName, pluginDir.entryList(QDir::Files|QDir::NoSymLinks))
+            dirFiles.push_back(pluginDir.absoluteFilePath(fileName));
 
 #ifdef Q_OS_WIN64
-        //Add current plugin folder to the search path of the DLL loader
+        //Add current plugin folder to the search path of the DLL loader:
+        //process wide setting, so libraries of different folders can't be loaded concurrently
         SetDllDirectoryA(QDir::toNativeSeparators(dirPath).toStdString().c_str());
+        loadCppLibraries(dirFiles);
 #endif
-
-        foreach (QString fileName, pluginDir.entryList(QDir::Files|QDir::NoSymLinks))
-            loadCppProcessPlugin(pluginDir.absoluteFilePath(fileName));
+        files.append(dirFiles);
     }
 
 #ifdef Q_OS_WIN64
     //Restore standard DLL search path
     SetDllDirectoryA(NULL);
+#else
+    loadCppLibraries(files);
 #endif
+
+    //Plugin root objects are created and registered in the main thread
+    for(auto&& fileName : files)
+    {
+        QElapsedTimer timer;
+        timer.start();
+        auto taskFactoryPtr = loadCppProcessPlugin(fileName);
+
+        auto it = m_loadTimes.find(fileName);
+        if(it != m_loadTimes.end())
+        {
+            it->second.m_initTime = timer.nsecsElapsed() / 1e6;
+            if(taskFactoryPtr)
+                it->second.m_name = QString::fromStdString(taskFactoryPtr->getInfo().getName());
+        }
+    }
+}
+
+void CPluginManager::loadCppLibraries(const QStringList &files)
+{
+    std::vector<QPluginLoader*> loaders;
+    for(auto&& fileName : files)
+    {
+        if(QLibrary::isLibrary(fileName) == false)
+            continue;
+
+        QPluginLoader* pLoader;
+        if(m_loaders.contains(fileName))
+            pLoader = m_loaders[fileName];
+        else
+            pLoader = m_loaders.insert(fileName, new QPluginLoader(fileName, this)).value();
+
+        if(pLoader->isLoaded() == false)
+            loaders.push_back(pLoader);
+    }
+
+    //Plugin metadata scan and library loading in parallel.
+    //Errors are reported when the root object is instantiated.
+    std::vector<double> times(loaders.size(), 0.0);
+    std::vector<size_t> indices(loaders.size());
+    std::iota(indices.begin(), indices.end(), 0);
+
+    QtConcurrent::blockingMap(indices, [&loaders, &times](size_t i)
+    {
+        QElapsedTimer timer;
+        timer.start();
+        loaders[i]->load();
+        times[i] = timer.nsecsElapsed() / 1e6;
+    });
+
+    for(size_t i=0; i<loaders.size(); ++i)
+    {
+        CPluginLoadTime loadTime;
+        loadTime.m_name = QFileInfo(loaders[i]->fileName()).fileName();
+        loadTime.m_language = ApiLanguage::CPP;
+        loadTime.m_loadTime = times[i];
+        m_loadTimes[loaders[i]->fileName()] = loadTime;
+    }
 }
 
 void CPluginManager::loadPythonProcessPlugins()
 {
     QDir pluginsDir(m_pythonPath);
+    QStringList directories;
+
     foreach (QString directory, pluginsDir.entryList(QDir::Dirs|QDir::NoDotAndDotDot))
-        loadPythonProcessPlugin(pluginsDir.absoluteFilePath(directory));
+        directories.push_back(pluginsDir.absoluteFilePath(directory));
+
+    //Imports need the GIL: one plugin at a time
+    for(auto&& directory : scanPythonPlugins(directories))
+    {
+        QElapsedTimer timer;
+        timer.start();
+        auto taskFactoryPtr = loadPythonProcessPlugin(directory);
+
+        auto& loadTime = m_loadTimes[directory];
+        loadTime.m_initTime = timer.nsecsElapsed() / 1e6;
+        if(taskFactoryPtr)
+            loadTime.m_name = QString::fromStdString(taskFactoryPtr->getInfo().getName());
+    }
+}
+
+QStringList CPluginManager::scanPythonPlugins(const QStringList &directories)
+{
+    //Filesystem work without the GIL, in parallel: plugin structure check
+    //and source files read ahead so that imports run from the system file cache
+    // Not std::vector<bool>: elements are written concurrently
+    std::vector<char> valid(directories.size(), false);
+    std::vector<double> times(directories.size(), 0.0);
+    std::vector<int> indices(directories.size());
+    std::iota(indices.begin(), indices.end(), 0);
+
+    QtConcurrent::blockingMap(indices, [&](int i)
+    {
+        QElapsedTimer timer;
+        timer.start();
+        QDir pluginDir(directories[i]);
+        valid[i] = pluginDir.exists(pluginDir.dirName() + ".py");
+
+        if(valid[i])
+        {
+            QDirIterator it(directories[i], {"*.py"}, QDir::Files, QDirIterator::Subdirectories);
+            while(it.hasNext())
+            {
+                QFile file(it.next());
+                if(file.open(QIODevice::ReadOnly))
+                    file.readAll();
+            }
+        }
+        times[i] = timer.nsecsElapsed() / 1e6;
+    });
+
+    QStringList plugins;
+    for(int i=0; i<directories.size(); ++i)
+    {
+        if(valid[i] == false)
+        {
+            //Not a plugin folder (no <dir>.py): ignored as before
+            qCDebug(logPlugin).noquote() << tr("Folder %1 is not a Python plugin, skipped").arg(directories[i]);
+            continue;
+        }
+
+        CPluginLoadTime loadTime;
+        loadTime.m_name = QDir(directories[i]).dirName();
+        loadTime.m_language = ApiLanguage::PYTHON;
+        loadTime.m_loadTime = times[i];
+        m_loadTimes[directories[i]] = loadTime;
+        plugins.push_back(directories[i]);
+    }
+    return plugins;
 }
 
 boost::python::object CPluginManager::loadPythonMainModule(const std::string& folder, const std::string &name)
@@ -653,3 +802,30 @@ void CPluginManager::fillPythonPackagesFromScript()
         qCCritical(logPlugin).noquote() << QString::fromStdString(Utils::Python::handlePythonException());
     }
 }
+
+void CPluginManager::reportLoadTimes(double totalTime) const
+{
+    auto times = getLoadTimes();
+    std::sort(times.begin(), times.end(), [](const CPluginLoadTime& t1, const CPluginLoadTime& t2)
+    {
+        return t1.m_loadTime + t1.m_initTime > t2.m_loadTime + t2.m_initTime;
+    });
+
+    qCInfo(logPlugin).noquote() << tr("%1 plugin(s) loaded in %2 ms").arg(times.size()).arg(totalTime, 0, 'f', 0);
+
+    //Full breakdown in debug, slowest ones only otherwise
+    const size_t maxInfo = 5;
+    for(size_t i=0; i<times.size(); ++i)
+    {
+        QString str = tr("Plugin %1 (%2): load %3 ms, init %4 ms")
+                .arg(times[i].m_name)
+                .arg(times[i].m_language == ApiLanguage::PYTHON ? "Python" : "C++")
+                .arg(times[i].m_loadTime, 0, 'f', 1)
+                .arg(times[i].m_initTime, 0, 'f', 1);
+
+        if(i < maxInfo)
+            qCInfo(logPlugin).noquote() << str;
+        else
+            qCDebug(logPlugin).noquote() << str;
+    }
+}
@@ -33,6 +33,16 @@
 class CIkomiaRegistry;
 class CProgressCircle;
 
+// Startup time of one plugin in ms: file scan and library/source loading (parallel),
+// then instantiation and registration (main thread, with the GIL for Python)
+struct CPluginLoadTime
+{
+    QString m_name;
+    int     m_language = ApiLanguage::CPP;
+    double  m_loadTime = 0;
+    double  m_initTime = 0;
+};
+
 class CPluginManager : public QObject
 {
     Q_OBJECT
@@ -51,6 +61,8 @@ class CPluginManager : public QObject
 
         bool                isProcessExists(const QString& name) const;
 
+        std::vector<CPluginLoadTime>    getLoadTimes() const;
+
         void                notifyViewShow();
         void                notifyPluginsLoaded();
 
@@ -79,7 +91,9 @@ class CPluginManager : public QObject
         void                addToPythonPath(const QString& path);
 
         void                    loadCppProcessPlugins();
+        void                    loadCppLibraries(const QStringList& files);
         void                    loadPythonProcessPlugins();
+        QStringList             scanPythonPlugins(const QStringList& directories);
         boost::python::object   loadPythonMainModule(const std::string& folder, const std::string& name);
 
         void                updatePythonQueryModel();
@@ -88,6 +102,8 @@ class CPluginManager : public QObject
         void                fillPythonPackages();
         void                fillPythonPackagesFromScript();
 
+        void                reportLoadTimes(double totalTime) const;
+
     private:
 
         CIkomiaRegistry*                        m_pRegistry = nullptr;
@@ -101,6 +117,8 @@ class CPluginManager : public QObject
         QString                                 m_pythonPath;
         QString                                 m_currentPluginName;
         const QSet<QString>                     m_systemModules = {"numpy","PyQt5"};
+        // Last startup breakdown, by plugin file or directory
+        std::map<QString, CPluginLoadTime>      m_loadTimes;
 };
 
 #endif // CPLUGINMANAGER_H
@@ -0,0 +1,227 @@
+// Copyright (C) 2021 Ikomia SAS
+// Contact: https://www.ikomia.com
+//
+// This file is part of the IkomiaStudio software.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "CProcessLibraryCache.h"
+#include <QCryptographicHash>
+#include <QFileInfo>
+#include <QSqlQuery>
+#include <QSqlError>
+#include "Main/AppTools.hpp"
+#include "Model/Plugin/CPluginTools.h"
+
+CProcessLibraryCache::CProcessLibraryCache()
+{
+    m_path = QString::fromStdString(Utils::IkomiaApp::getIkomiaFolder() + "/ProcessLibrary.db");
+}
+
+void CProcessLibraryCache::setTreeName(const QString &name)
+{
+    m_treeName = name;
+}
+
+CProcessLibraryCache::Fingerprints CProcessLibraryCache::computeFingerprints(const std::vector<TaskFactoryPtr> &processes) const
+{
+    Fingerprints fingerprints;
+    for(auto&& processPtr : processes)
+    {
+        auto info = processPtr->getInfo();
+        QCryptographicHash hash(QCryptographicHash::Sha1);
+
+        // Every field stored in the library tables
+        for(auto&& field : {info.getName(), info.getPath(), info.getShortDescription(), info.getDescription(), info.getKeywords(),
+                            info.getAuthors(), info.getArticle(), info.getJournal(), info.getDocumentationLink(), info.getVersion(),
+                            info.getIkomiaVersion(), info.getLicense(), info.getRepository(), info.getIconPath()})
+        {
+            hash.addData(QByteArray::fromStdString(field));
+            hash.addData("\0", 1);
+        }
+        hash.addData(QByteArray::number(info.getYear()));
+        hash.addData(QByteArray::number(info.getLanguage()));
+        hash.addData(QByteArray::number(info.getOS()));
+        hash.addData(QByteArray::number(info.isInternal()));
+
+        // Plugin folder and its modification time
+        if(info.isInternal() == false)
+        {
+            QFileInfo dirInfo(QString::fromStdString(Utils::CPluginTools::getDirectory(info.getName(), info.getLanguage())));
+            hash.addData(dirInfo.absoluteFilePath().toUtf8());
+            hash.addData(QByteArray::number(dirInfo.lastModified().toMSecsSinceEpoch()));
+        }
+        fingerprints[info.getName()] = hash.result().toHex();
+    }
+    return fingerprints;
+}
+
+QByteArray CProcessLibraryCache::computeStructureKey(const std::vector<TaskFactoryPtr> &processes) const
+{
+    // Tree items and identifiers depend on process order and paths
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(Utils::IkomiaApp::getCurrentVersionNumber().toUtf8());
+
+    for(auto&& processPtr : processes)
+    {
+        hash.addData(QByteArray::fromStdString(processPtr->getInfo().getName()));
+        hash.addData("\0", 1);
+        hash.addData(QByteArray::fromStdString(processPtr->getInfo().getPath()));
+        hash.addData("\0", 1);
+    }
+    return hash.result().toHex();
+}
+
+bool CProcessLibraryCache::attach(QSqlDatabase &db)
+{
+    QSqlQuery q(db);
+    q.prepare("ATTACH DATABASE ? AS libraryCache;");
+    q.addBindValue(m_path);
+
+    if(!q.exec())
+        return false;
+
+    m_bAttached = true;
+    return true;
+}
+
+void CProcessLibraryCache::detach(QSqlDatabase &db)
+{
+    if(m_bAttached == false)
+        return;
+
+    QSqlQuery q(db);
+    q.exec("DETACH DATABASE libraryCache;");
+    m_bAttached = false;
+}
+
+bool CProcessLibraryCache::isValid(QSqlDatabase &db, const QByteArray &structureKey, const Fingerprints &fingerprints, std::vector<std::string> &changed) const
+{
+    changed.clear();
+    if(m_bAttached == false)
+        return false;
+
+    QSqlQuery q(db);
+    if(!q.exec("SELECT value FROM libraryCache.meta WHERE key='structure';") || !q.next())
+        return false;
+
+    if(q.value(0).toByteArray() != structureKey)
+        return false;
+
+    if(!q.exec("SELECT name, fingerprint FROM libraryCache.fingerprint;"))
+        return false;
+
+    size_t count = 0;
+    while(q.next())
+    {
+        auto it = fingerprints.find(q.value(0).toString().toStdString());
+        if(it == fingerprints.end())
+            return false;
+
+        if(it->second != q.value(1).toByteArray())
+            changed.push_back(it->first);
+
+        count++;
+    }
+    return count == fingerprints.size();
+}
+
+void CProcessLibraryCache::restore(QSqlDatabase &db, const std::vector<std::string> &changed)
+{
+    QSqlQuery q(db);
+    exec(q, QString("DELETE FROM %1;").arg(m_treeName));
+    exec(q, QString("INSERT INTO %1 SELECT * FROM libraryCache.processTree;").arg(m_treeName));
+    exec(q, "INSERT INTO processFolder SELECT * FROM libraryCache.processFolder;");
+    exec(q, "INSERT INTO process SELECT * FROM libraryCache.process;");
+    exec(q, "INSERT INTO processFTS (id, name, shortDescription, description, keywords, user, authors, article, journal) "
+            "SELECT id, name, shortDescription, description, keywords, user, authors, article, journal FROM libraryCache.processFTS;");
+
+    if(changed.empty())
+        return;
+
+    // Changed processes are inserted again by the caller
+    QVariantList names;
+    for(auto&& name : changed)
+        names << QString::fromStdString(name);
+
+    for(auto&& table : {"process", "processFTS"})
+    {
+        if(!q.prepare(QString("DELETE FROM %1 WHERE name = ?;").arg(table)))
+            throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+
+        q.addBindValue(names);
+        if(!q.execBatch())
+            throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+    }
+}
+
+void CProcessLibraryCache::save(QSqlDatabase &db, const QByteArray &structureKey, const Fingerprints &fingerprints)
+{
+    QSqlQuery q(db);
+    for(auto&& table : {"processTree", "processFolder", "process", "processFTS", "fingerprint", "meta"})
+        exec(q, QString("DROP TABLE IF EXISTS libraryCache.%1;").arg(table));
+
+    exec(q, QString("CREATE TABLE libraryCache.processTree AS SELECT * FROM %1;").arg(m_treeName));
+    exec(q, "CREATE TABLE libraryCache.processFolder AS SELECT * FROM processFolder;");
+    exec(q, "CREATE TABLE libraryCache.process AS SELECT * FROM process;");
+    // Plain copy of the full text index content: indexed again on restore
+    exec(q, "CREATE TABLE libraryCache.processFTS AS "
+            "SELECT id, name, shortDescription, description, keywords, user, authors, article, journal FROM processFTS;");
+    exec(q, "CREATE TABLE libraryCache.fingerprint (name TEXT PRIMARY KEY, fingerprint TEXT);");
+    exec(q, "CREATE TABLE libraryCache.meta (key TEXT PRIMARY KEY, value TEXT);");
+
+    QVariantList names, values;
+    for(auto&& it : fingerprints)
+    {
+        names << QString::fromStdString(it.first);
+        values << it.second;
+    }
+
+    if(!q.prepare("INSERT INTO libraryCache.fingerprint (name, fingerprint) VALUES (?, ?);"))
+        throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+
+    q.addBindValue(names);
+    q.addBindValue(values);
+
+    if(!q.execBatch())
+        throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+
+    if(!q.prepare("INSERT INTO libraryCache.meta (key, value) VALUES ('structure', ?);"))
+        throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+
+    q.addBindValue(structureKey);
+    if(!q.exec())
+        throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+}
+
+std::pair<int, int> CProcessLibraryCache::getCachedIds(QSqlDatabase &db, const std::string &name) const
+{
+    QSqlQuery q(db);
+    q.prepare("SELECT id, folderId FROM libraryCache.process WHERE name = ?;");
+    q.addBindValue(QString::fromStdString(name));
+
+    if(!q.exec())
+        throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+
+    if(!q.next())
+        throw CException(DatabaseExCode::INVALID_QUERY, "Process " + name + " not found in library cache", __func__, __FILE__, __LINE__);
+
+    return std::make_pair(q.value(0).toInt(), q.value(1).toInt());
+}
+
+void CProcessLibraryCache::exec(QSqlQuery &q, const QString &query)
+{
+    if(!q.exec(query))
+        throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2021 Ikomia SAS
+ * Contact: https://www.ikomia.com
+ *
+ * This file is part of the IkomiaStudio software.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CPROCESSLIBRARYCACHE_H
+#define CPROCESSLIBRARYCACHE_H
+
+#include <QSqlDatabase>
+#include "Core/CTaskFactory.hpp"
+
+// Process library tables (tree, process, processFTS, processFolder) saved in a file
+// database with a fingerprint of each process, to skip the library construction when
+// processes and plugins did not change since the last launch.
+class CProcessLibraryCache
+{
+    public:
+
+        using Fingerprints = std::map<std::string, QByteArray>;
+
+        CProcessLibraryCache();
+
+        void            setTreeName(const QString& name);
+
+        Fingerprints    computeFingerprints(const std::vector<TaskFactoryPtr>& processes) const;
+        QByteArray      computeStructureKey(const std::vector<TaskFactoryPtr>& processes) const;
+
+        bool            attach(QSqlDatabase& db);
+        void            detach(QSqlDatabase& db);
+
+        bool            isValid(QSqlDatabase& db, const QByteArray& structureKey, const Fingerprints& fingerprints, std::vector<std::string>& changed) const;
+
+        void            restore(QSqlDatabase& db, const std::vector<std::string>& changed);
+        void            save(QSqlDatabase& db, const QByteArray& structureKey, const Fingerprints& fingerprints);
+
+        std::pair<int,int>  getCachedIds(QSqlDatabase& db, const std::string& name) const;
+
+    private:
+
+        void            exec(QSqlQuery& q, const QString& query);
+
+    private:
+
+        QString         m_path;
+        QString         m_treeName;
+        bool            m_bAttached = false;
+};
+
+#endif // CPROCESSLIBRARYCACHE_H
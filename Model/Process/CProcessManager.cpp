@@ -109,6 +109,7 @@ void CProcessManager::notifyModelUpdate()
 
     m_proxyList[m_processId] = new CProcessProxyModel;
     m_proxyList[m_processId]->setSourceModel(m_processList[m_processId].get());
+    applySearch(m_processId);
 
     emit doSetProcessModel(m_proxyList[m_processId]);
 }
@@ -177,6 +178,9 @@ void CProcessManager::updateProcessInfo(const CTaskInfo &info)
     {
         throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
     }
+
+    m_searchIndex.update(m_db, QString::fromStdString(info.getName()));
+    m_lastSearchText.clear();
 }
 
 WorkflowTaskPtr CProcessManager::createObject(const std::string &processName, const WorkflowTaskParamPtr& paramPtr)
@@ -347,7 +351,8 @@ void CProcessManager::onUpdateTableModel(const QModelIndex& index)
 
 void CProcessManager::onSearchTableProcess(const QString& text)
 {
-    if(text.isEmpty())
+    CProcessSearchIndex::Results results;
+    if(text.isEmpty() || searchProcess(text, results) == false)
     {
         m_processTableList[m_processId]->setTable("process");
         m_processTableList[m_processId]->select();
@@ -355,8 +360,11 @@ void CProcessManager::onSearchTableProcess(const QString& text)
     }
     else
     {
-        QString txtKey = Utils::Database::getFTSKeywords(text);
-        m_searchReq = QString("id in (select id from processFTS where processFTS MATCH '%1');").arg(txtKey);
+        QStringList ids;
+        for(auto&& result : results)
+            ids << QString::number(result.m_id);
+
+        m_searchReq = QString("id in (%1)").arg(ids.join(","));
         m_processTableList[m_processId]->setFilter(m_searchReq);
         m_processTableList[m_processId]->select();
         m_bIsSearching = true;
@@ -482,6 +490,8 @@ void CProcessManager::onUpdateProcessInfo(bool bFullEdit, const CTaskInfo &info)
     if(!q2.exec(strQuery))
         throw CException(DatabaseExCode::INVALID_QUERY, q2.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
 
+    m_searchIndex.update(m_db, QString::fromStdString(info.m_name));
+    m_lastSearchText.clear();
     updateTableModelQuery();
 }
 
@@ -512,72 +522,47 @@ void CProcessManager::fillModel(QSqlQuery query)
 
 void CProcessManager::updateModelFromSearch(const QString& text)
 {
-    // Reset tree model before filling it with new research
-    m_id = 0;
-    m_processList[ID::PROCESS_TREE] = std::make_shared<CProcessModel>();
-    m_processList[ID::PROCESS_TREE]->insertIcon(static_cast<size_t>(TreeItemType::FOLDER), QIcon(":/Images/folder.png"));
-    m_processList[ID::PROCESS_TREE]->insertIcon(static_cast<size_t>(TreeItemType::PROCESS), QIcon(":/Images/default-process.png"));
-
-    setModel(m_processList[m_processId].get());
-
-    // Set correct DB before query
-    makeCurrentDb();
-    QSqlQuery q(m_db);
-    QList<int> idList;
-    bool bSearch = false;
+    // Tree model is kept, the proxy filters and ranks processes from the search index
+    updateSearch(m_processId, text);
+    applySearch(m_processId);
+    emit doSetProcessModel(m_proxyList[m_processId]);
+}
 
-    if(text.isEmpty() == false)
+bool CProcessManager::searchProcess(const QString &text, CProcessSearchIndex::Results &results)
+{
+    // Tree and table are searched with the same text on each keystroke
+    if(text.isEmpty() == false && text == m_lastSearchText)
     {
-        QString txtKey = Utils::Database::getFTSKeywords(text);
-        if (!txtKey.isEmpty())
-        {
-            bSearch = true;
-
-            if(!q.exec(QString("SELECT id FROM processFTS WHERE processFTS MATCH '%1';").arg(txtKey)))
-                throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
-
-            while (q.next())
-            {
-                int id = q.value(0).toInt();
-                idList.append(id);
-            }
-        }
-    }   
-
-    if(!q.exec(QString("SELECT name, level, id, typeid, parentid FROM %1 ORDER BY left;").arg(m_currentTreeName)))
-        throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+        results = m_lastSearchResults;
+        return m_bLastSearch;
+    }
 
-    while (q.next())
-    {
-        int typeId = q.record().value("typeid").toInt();
-        switch(typeId)
-        {
-            case static_cast<int>(TreeItemType::NONE):
-                addCustomTreeItem<CFolderItem, CFolderItemImpl>(q);
-                break;
+    m_bLastSearch = m_searchIndex.search(text, results);
+    m_lastSearchText = text;
+    m_lastSearchResults = results;
+    return m_bLastSearch;
+}
 
-            case static_cast<int>(TreeItemType::FOLDER):
-                addCustomTreeItem<CFolderItem, CFolderItemImpl>(q);
-                break;
+void CProcessManager::updateSearch(CProcessManager::ID id, const QString &text)
+{
+    CProcessSearchIndex::Results results;
+    CSearchState& state = m_searchStates[id];
+    state.m_text = text;
+    state.m_bActive = searchProcess(text, results);
+    state.m_ranks.clear();
+
+    for(size_t i=0; i<results.size(); ++i)
+        state.m_ranks.insert(results[i].m_id, static_cast<int>(i));
+}
 
-            case static_cast<int>(TreeItemType::PROCESS):
-            {
-                if(bSearch == true)
-                {
-                    int id = q.record().value("id").toInt();
-                    if(idList.contains(id))
-                        addCustomTreeItem<CProcessItem, CProcessItemImpl>(q);
-                }
-                else
-                    addCustomTreeItem<CProcessItem, CProcessItemImpl>(q);
-                break;
-            }
+void CProcessManager::applySearch(CProcessManager::ID id)
+{
+    auto pProxy = static_cast<CProcessProxyModel*>(m_proxyList[id]);
+    if(pProxy == nullptr)
+        return;
 
-            default:
-                break;
-        }
-    }
-    notifyModelUpdate();
+    const CSearchState& state = m_searchStates[id];
+    pProxy->setSearchRanks(state.m_ranks, state.m_bActive);
 }
 
 void CProcessManager::createCustomTable()
@@ -679,31 +664,56 @@ void CProcessManager::createModel()
         createDb(m_dbType, m_dbName);
         createTree("ProcessLibrary");
         createCustomTable();
-        setTreeRoot("All process", m_id++, TreeItemType::FOLDER);
 
         // Set current model as tree view
         m_processId = ID::PROCESS_TREE;
         setModel(m_processList[m_processId].get());
 
-        // Create custom folder in process tree
-        createCustomTreeFolders();
-
-        // Fill database with processes and plugins
+        // Processes and plugins
         auto factory = m_registry.getTaskRegistrator()->getProcessFactory();
-        m_processCount = static_cast<int>(factory.getList().size());
+        auto list = factory.getList();
+        std::vector<TaskFactoryPtr> processes(list.begin(), list.end());
+        m_processCount = static_cast<int>(processes.size());
 
-        for(auto&& it : factory.getList())
+        // Library from the last launch: only changed processes are indexed again
+        makeCurrentDb();
+        m_libraryCache.setTreeName(m_currentTreeName);
+        auto fingerprints = m_libraryCache.computeFingerprints(processes);
+        auto structureKey = m_libraryCache.computeStructureKey(processes);
+        std::vector<std::string> changed;
+
+        bool bCache = m_libraryCache.attach(m_db);
+        bool bRestored = bCache && m_libraryCache.isValid(m_db, structureKey, fingerprints, changed) && restoreLibrary(processes, changed);
+
+        if(bRestored == false)
+            buildLibrary(processes);
+
+        if(bCache && (bRestored == false || changed.empty() == false))
         {
-            size_t lastFolderId = buildPath(it->getInfo().getPath());
-            addProcess(it, lastFolderId);
+            try
+            {
+                m_db.transaction();
+                m_libraryCache.save(m_db, structureKey, fingerprints);
+                m_db.commit();
+            }
+            catch(std::exception& e)
+            {
+                m_db.rollback();
+                qCWarning(logProcess).noquote() << tr("Process library cache can't be saved: %1").arg(QString::fromStdString(e.what()));
+            }
         }
-
-        //Fill database with folders information
-        addFoldersInfo();
+        m_libraryCache.detach(m_db);
 
         //Synchronise memory database with file database (main)
         synCTaskInfo();
 
+        // Search index and current searches, identifiers may have changed
+        m_searchIndex.build(m_db);
+        m_lastSearchText.clear();
+
+        for(auto&& it : m_searchStates)
+            updateSearch(it.first, it.second.m_text);
+
         // Fill all models from database
         for(const auto& id : m_viewIds)
         {
@@ -726,6 +736,82 @@ void CProcessManager::createModel()
     }
 }
 
+void CProcessManager::buildLibrary(const std::vector<TaskFactoryPtr> &processes)
+{
+    // Single transaction: tree and process rows are committed once
+    makeCurrentDb();
+    m_db.transaction();
+
+    try
+    {
+        setTreeRoot("All process", m_id++, TreeItemType::FOLDER);
+
+        // Create custom folder in process tree
+        createCustomTreeFolders();
+
+        // Fill database with processes and plugins
+        for(auto&& it : processes)
+        {
+            size_t lastFolderId = buildPath(it->getInfo().getPath());
+            addProcess(it, lastFolderId);
+        }
+        insertProcessInfo();
+
+        //Fill database with folders information
+        addFoldersInfo();
+        m_db.commit();
+    }
+    catch(std::exception& e)
+    {
+        m_db.rollback();
+        throw;
+    }
+}
+
+bool CProcessManager::restoreLibrary(const std::vector<TaskFactoryPtr> &processes, const std::vector<std::string> &changed)
+{
+    makeCurrentDb();
+    m_db.transaction();
+
+    try
+    {
+        // Root item: same identifier as the cached one, tree content is replaced
+        setTreeRoot("All process", m_id++, TreeItemType::FOLDER);
+        m_libraryCache.restore(m_db, changed);
+
+        for(auto&& name : changed)
+        {
+            auto it = std::find_if(processes.begin(), processes.end(), [&name](const TaskFactoryPtr& processPtr)
+            {
+                return processPtr->getInfo().getName() == name;
+            });
+
+            if(it != processes.end())
+            {
+                auto ids = m_libraryCache.getCachedIds(m_db, name);
+                addProcessInfo(*it, ids.first, ids.second);
+            }
+        }
+        insertProcessInfo();
+
+        QSqlQuery q(m_db);
+        if(!q.exec(QString("SELECT MAX(id) FROM %1;").arg(m_currentTreeName)) || !q.next())
+            throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+
+        m_id = q.value(0).toUInt() + 1;
+        m_db.commit();
+        return true;
+    }
+    catch(std::exception& e)
+    {
+        m_db.rollback();
+        m_processRows = CProcessRows();
+        m_id = 0;
+        qCWarning(logProcess).noquote() << tr("Process library cache can't be used: %1").arg(QString::fromStdString(e.what()));
+        return false;
+    }
+}
+
 size_t CProcessManager::buildPath(const std::string &path)
 {
     std::string pathTmp;
@@ -785,15 +871,10 @@ size_t CProcessManager::addProcess(const TaskFactoryPtr &process, size_t folderI
 
 void CProcessManager::addProcessInfo(const TaskFactoryPtr& process, size_t id, size_t folderId)
 {
-    makeCurrentDb();
-    QSqlQuery q(m_db);
-
     //Internal Process or plugin
     bool bInternal = process->getInfo().isInternal();
     //Get process language C++ or Python
     int language = process->getInfo().getLanguage();
-    //Get operating system
-    int os = process->getInfo().getOS();
 
     //Icon path
     QString iconPath = QString::fromStdString(process->getInfo().getIconPath());
@@ -803,37 +884,73 @@ void CProcessManager::addProcessInfo(const TaskFactoryPtr& process, size_t id, s
         iconPath = pluginDir + "/" + iconPath;
     }
 
-    auto name = QString::fromStdString(Utils::String::dbFormat(process->getInfo().getName()));
-    auto shortDescription = QString::fromStdString(Utils::String::dbFormat(process->getInfo().getShortDescription()));
-    auto description = QString::fromStdString(Utils::String::dbFormat(process->getInfo().getDescription()));
-    auto keywords = QString::fromStdString(Utils::String::dbFormat(process->getInfo().getKeywords()));
-    auto authors = QString::fromStdString(Utils::String::dbFormat(process->getInfo().getAuthors()));
-    auto article = QString::fromStdString(Utils::String::dbFormat(process->getInfo().getArticle()));
-    auto journal = QString::fromStdString(Utils::String::dbFormat(process->getInfo().getJournal()));
-    auto docLink = QString::fromStdString(Utils::String::dbFormat(process->getInfo().getDocumentationLink()));
-    auto version = QString::fromStdString(Utils::String::dbFormat(process->getInfo().getVersion()));
-    auto ikomiaVersion = QString::fromStdString(Utils::String::dbFormat(process->getInfo().getIkomiaVersion()));
-    auto license = QString::fromStdString(Utils::String::dbFormat(process->getInfo().getLicense()));
-    auto repo = QString::fromStdString(Utils::String::dbFormat(process->getInfo().getRepository()));
-
-    if (!q.exec(QString("INSERT INTO process"
-                        "(id, name, shortDescription, description, keywords, authors, article, journal, year, "
-                        "docLink, version, ikomiaVersion, language, os, isInternal, iconPath, folderId, license, repository) "
-                        "VALUES (%1, '%2', '%3', '%4', '%5', '%6', '%7', '%8', %9, '%10', '%11', '%12', %13, %14, %15, '%16', %17, '%18', '%19');")
-                .arg(id).arg(name).arg(shortDescription).arg(description).arg(keywords).arg(authors).arg(article).arg(journal)
-                .arg(process->getInfo().getYear()).arg(docLink).arg(version).arg(ikomiaVersion).arg(language).arg(os).arg(bInternal)
-                .arg(iconPath).arg(folderId).arg(license).arg(repo)))
+    //Inserted with the other pending rows by insertProcessInfo()
+    m_processRows.m_ids << (int)id;
+    m_processRows.m_names << QString::fromStdString(process->getInfo().getName());
+    m_processRows.m_shortDescriptions << QString::fromStdString(process->getInfo().getShortDescription());
+    m_processRows.m_descriptions << QString::fromStdString(process->getInfo().getDescription());
+    m_processRows.m_keywords << QString::fromStdString(process->getInfo().getKeywords());
+    m_processRows.m_authors << QString::fromStdString(process->getInfo().getAuthors());
+    m_processRows.m_articles << QString::fromStdString(process->getInfo().getArticle());
+    m_processRows.m_journals << QString::fromStdString(process->getInfo().getJournal());
+    m_processRows.m_years << process->getInfo().getYear();
+    m_processRows.m_docLinks << QString::fromStdString(process->getInfo().getDocumentationLink());
+    m_processRows.m_versions << QString::fromStdString(process->getInfo().getVersion());
+    m_processRows.m_ikomiaVersions << QString::fromStdString(process->getInfo().getIkomiaVersion());
+    m_processRows.m_languages << language;
+    m_processRows.m_os << process->getInfo().getOS();
+    m_processRows.m_internals << bInternal;
+    m_processRows.m_iconPaths << iconPath;
+    m_processRows.m_folderIds << (int)folderId;
+    m_processRows.m_licenses << QString::fromStdString(process->getInfo().getLicense());
+    m_processRows.m_repositories << QString::fromStdString(process->getInfo().getRepository());
+}
+
+void CProcessManager::insertProcessInfo()
+{
+    if(m_processRows.m_ids.isEmpty())
+        return;
+
+    makeCurrentDb();
+    QSqlQuery q(m_db);
+
+    if(!q.prepare("INSERT INTO process "
+                  "(id, name, shortDescription, description, keywords, authors, article, journal, year, "
+                  "docLink, version, ikomiaVersion, language, os, isInternal, iconPath, folderId, license, repository) "
+                  "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?);"))
     {
         throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
     }
 
-    if (!q.exec(QString("INSERT INTO processFTS "
-                        "(id, name, shortDescription, description, keywords, authors, article, journal) "
-                        "VALUES (%1, '%2', '%3', '%4', '%5', '%6', '%7', '%8');")
-                .arg(id).arg(name).arg(shortDescription).arg(description).arg(keywords).arg(authors).arg(article).arg(journal)))
+    for(auto&& values : {m_processRows.m_ids, m_processRows.m_names, m_processRows.m_shortDescriptions, m_processRows.m_descriptions,
+                         m_processRows.m_keywords, m_processRows.m_authors, m_processRows.m_articles, m_processRows.m_journals,
+                         m_processRows.m_years, m_processRows.m_docLinks, m_processRows.m_versions, m_processRows.m_ikomiaVersions,
+                         m_processRows.m_languages, m_processRows.m_os, m_processRows.m_internals, m_processRows.m_iconPaths,
+                         m_processRows.m_folderIds, m_processRows.m_licenses, m_processRows.m_repositories})
+    {
+        q.addBindValue(values);
+    }
+
+    if(!q.execBatch())
+        throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+
+    if(!q.prepare("INSERT INTO processFTS "
+                  "(id, name, shortDescription, description, keywords, authors, article, journal) "
+                  "VALUES (?, ?, ?, ?, ?, ?, ?, ?);"))
     {
         throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
     }
+
+    for(auto&& values : {m_processRows.m_ids, m_processRows.m_names, m_processRows.m_shortDescriptions, m_processRows.m_descriptions,
+                         m_processRows.m_keywords, m_processRows.m_authors, m_processRows.m_articles, m_processRows.m_journals})
+    {
+        q.addBindValue(values);
+    }
+
+    if(!q.execBatch())
+        throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+
+    m_processRows = CProcessRows();
 }
 
 void CProcessManager::addFoldersInfo()
@@ -22,8 +22,11 @@
 #define CPROCESSMANAGER_H
 
 #include <QObject>
+#include <tuple>
 #include "CProcessModel.hpp"
 #include "CTreeDbManager.hpp"
+#include "CProcessLibraryCache.h"
+#include "CProcessSearchIndex.h"
 #include "Core/CIkomiaRegistry.h"
 #include "Model/User/CUser.h"
 
@@ -61,6 +64,15 @@ class CProcessProxyModel: public QSortFilterProxyModel
 
         CProcessProxyModel(QObject *parent = nullptr) : QSortFilterProxyModel(parent){}
 
+        // Process ranks by database id: only ranked processes are shown while searching
+        void setSearchRanks(const QHash<int,int>& ranks, bool bSearch)
+        {
+            m_ranks = ranks;
+            m_bSearch = bSearch;
+            invalidateFilter();
+            sort(bSearch ? 0 : -1);
+        }
+
     protected:
 
         virtual bool filterAcceptsRow(int source_row, const QModelIndex & source_parent) const override
@@ -71,7 +83,7 @@ class CProcessProxyModel: public QSortFilterProxyModel
             auto pItem = static_cast<CProcessModel::TreeItem*>(currIndex.internalPointer());
             size_t typeId = pItem->getTypeId();
             if(typeId == TreeItemType::PROCESS)
-                result = true;
+                result = m_bSearch == false || m_ranks.contains(pItem->getDbId());
 
             if (sourceModel()->hasChildren(currIndex))
             {
@@ -84,6 +96,28 @@ class CProcessProxyModel: public QSortFilterProxyModel
             }
             return result;
         }
+
+        virtual bool lessThan(const QModelIndex& left, const QModelIndex& right) const override
+        {
+            // Processes first by rank, then folders in their order.
+            // Same key for every pair to keep a strict weak ordering.
+            return getSortKey(left) < getSortKey(right);
+        }
+
+    private:
+
+        std::tuple<bool,int,int> getSortKey(const QModelIndex& index) const
+        {
+            auto pItem = static_cast<CProcessModel::TreeItem*>(index.internalPointer());
+            bool bFolder = pItem->getTypeId() != TreeItemType::PROCESS;
+            int rank = bFolder ? 0 : m_ranks.value(pItem->getDbId());
+            return std::make_tuple(bFolder, rank, index.row());
+        }
+
+    private:
+
+        QHash<int,int>  m_ranks;
+        bool            m_bSearch = false;
 };
 
 class CProcessTableProxyModel: public QSortFilterProxyModel
@@ -341,6 +375,14 @@ class CProcessManager: public QObject, public CTreeDbManager<CProcessModel, std:
 
         void                    synCTaskInfo();
 
+        void                    buildLibrary(const std::vector<TaskFactoryPtr>& processes);
+        bool                    restoreLibrary(const std::vector<TaskFactoryPtr>& processes, const std::vector<std::string>& changed);
+        void                    insertProcessInfo();
+
+        bool                    searchProcess(const QString& text, CProcessSearchIndex::Results& results);
+        void                    updateSearch(ID id, const QString& text);
+        void                    applySearch(ID id);
+
     public:
 
         CIkomiaRegistry         m_registry;
@@ -350,6 +392,21 @@ class CProcessManager: public QObject, public CTreeDbManager<CProcessModel, std:
         using ProcessPathInfo = std::map<std::string, std::pair<size_t,size_t>>;
         using MapString = std::map<std::string, std::string>;
 
+        // Process ranks of the last search for a process model
+        struct CSearchState
+        {
+            QString         m_text;
+            QHash<int,int>  m_ranks;
+            bool            m_bActive = false;
+        };
+
+        // Column values of pending process rows, inserted by batch
+        struct CProcessRows
+        {
+            QVariantList    m_ids, m_names, m_shortDescriptions, m_descriptions, m_keywords, m_authors, m_articles, m_journals, m_years,
+                            m_docLinks, m_versions, m_ikomiaVersions, m_languages, m_os, m_internals, m_iconPaths, m_folderIds, m_licenses, m_repositories;
+        };
+
         QString                     m_dbType = "QSQLITE";
         QString                     m_dbName = ":memory:";
         ProcessModelList            m_processList;
@@ -367,6 +424,13 @@ class CProcessManager: public QObject, public CTreeDbManager<CProcessModel, std:
         QString                     m_searchReq;
         int                         m_processCount = 0;
         MapString                   m_iconMap;
+        CProcessRows                m_processRows;
+        CProcessLibraryCache        m_libraryCache;
+        CProcessSearchIndex         m_searchIndex;
+        std::map<ID, CSearchState>  m_searchStates;
+        QString                     m_lastSearchText;
+        CProcessSearchIndex::Results m_lastSearchResults;
+        bool                        m_bLastSearch = false;
 };
 
 #endif // CPROCESSMANAGER_H
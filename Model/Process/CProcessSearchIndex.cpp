@@ -0,0 +1,310 @@
+// Copyright (C) 2021 Ikomia SAS
+// Contact: https://www.ikomia.com
+//
+// This file is part of the IkomiaStudio software.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "CProcessSearchIndex.h"
+#include <algorithm>
+#include <limits>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QRegularExpression>
+
+namespace
+{
+    std::vector<int> intersect(const std::vector<int>& a, const std::vector<int>& b)
+    {
+        std::vector<int> result;
+        std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(result));
+        return result;
+    }
+
+    bool hasWordPrefix(const QStringList& words, const QString& term)
+    {
+        for(auto&& word : words)
+        {
+            if(word.startsWith(term))
+                return true;
+        }
+        return false;
+    }
+}
+
+CProcessSearchIndex::CProcessSearchIndex()
+{
+}
+
+void CProcessSearchIndex::build(QSqlDatabase &db)
+{
+    clear();
+
+    QSqlQuery q(db);
+    if(!q.exec("SELECT id, name, keywords, shortDescription, description FROM process ORDER BY id;"))
+        throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+
+    while(q.next())
+    {
+        CDocument doc;
+        doc.m_id = q.value(0).toInt();
+        doc.m_name = q.value(1).toString();
+        doc.m_keywords = q.value(2).toString();
+        doc.m_description = q.value(3).toString() + "\n" + q.value(4).toString();
+
+        int slot = static_cast<int>(m_docs.size());
+        m_docs.emplace_back();
+        m_slots.insert(doc.m_name, slot);
+        // Slots are increasing: postings stay sorted with push_back
+        addDocument(slot, std::move(doc), false);
+    }
+    std::sort(m_words.begin(), m_words.end());
+}
+
+void CProcessSearchIndex::update(QSqlDatabase &db, const QString &name)
+{
+    QSqlQuery q(db);
+    if(!q.prepare("SELECT id, name, keywords, shortDescription, description FROM process WHERE name = ?;"))
+        throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+
+    q.addBindValue(name);
+    if(!q.exec())
+        throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+
+    if(!q.next())
+        return;
+
+    CDocument doc;
+    doc.m_id = q.value(0).toInt();
+    doc.m_name = q.value(1).toString();
+    doc.m_keywords = q.value(2).toString();
+    doc.m_description = q.value(3).toString() + "\n" + q.value(4).toString();
+
+    auto it = m_slots.find(name);
+    if(it == m_slots.end())
+    {
+        int slot = static_cast<int>(m_docs.size());
+        m_docs.emplace_back();
+        m_slots.insert(name, slot);
+        addDocument(slot, std::move(doc), true);
+    }
+    else
+    {
+        removeDocument(it.value());
+        addDocument(it.value(), std::move(doc), true);
+    }
+}
+
+void CProcessSearchIndex::clear()
+{
+    m_docs.clear();
+    m_slots.clear();
+    m_trigrams.clear();
+    m_words.clear();
+}
+
+bool CProcessSearchIndex::search(const QString &text, Results &results) const
+{
+    results.clear();
+    QStringList terms = splitWords(text);
+
+    if(terms.isEmpty())
+        return false;
+
+    // Candidates matching all terms, rarest term first
+    Postings candidates;
+    bool bFirst = true;
+
+    for(auto&& term : terms)
+    {
+        Postings termCandidates = term.size() >= 3 ? getTrigramCandidates(term) : getPrefixCandidates(term);
+        candidates = bFirst ? std::move(termCandidates) : intersect(candidates, termCandidates);
+        bFirst = false;
+
+        if(candidates.empty())
+            return true;
+    }
+
+    // Trigrams may match across words: candidates are checked while scored
+    for(auto slot : candidates)
+    {
+        const CDocument& doc = m_docs[slot];
+        int score = getScore(doc, terms);
+
+        if(score > 0)
+            results.push_back({doc.m_id, doc.m_name, score});
+    }
+
+    std::sort(results.begin(), results.end(), [](const CResult& r1, const CResult& r2)
+    {
+        if(r1.m_score != r2.m_score)
+            return r1.m_score > r2.m_score;
+
+        return r1.m_name < r2.m_name;
+    });
+    return true;
+}
+
+void CProcessSearchIndex::addDocument(int slot, CDocument &&doc, bool bSorted)
+{
+    doc.m_nameLower = doc.m_name.toLower();
+    doc.m_keywords = doc.m_keywords.toLower();
+    doc.m_description = doc.m_description.toLower();
+    doc.m_nameWords = splitWords(doc.m_name);
+    doc.m_keywordWords = splitWords(doc.m_keywords);
+
+    for(auto key : getTrigrams(doc.m_nameLower + "\n" + doc.m_keywords + "\n" + doc.m_description))
+    {
+        Postings& postings = m_trigrams[key];
+        if(bSorted)
+            postings.insert(std::lower_bound(postings.begin(), postings.end(), slot), slot);
+        else
+            postings.push_back(slot);
+    }
+
+    for(auto&& words : {doc.m_nameWords, doc.m_keywordWords})
+    {
+        for(auto&& word : words)
+        {
+            WordEntry entry = std::make_pair(word, slot);
+            if(bSorted)
+                m_words.insert(std::lower_bound(m_words.begin(), m_words.end(), entry), entry);
+            else
+                m_words.push_back(entry);
+        }
+    }
+    m_docs[slot] = std::move(doc);
+}
+
+void CProcessSearchIndex::removeDocument(int slot)
+{
+    const CDocument& doc = m_docs[slot];
+
+    for(auto key : getTrigrams(doc.m_nameLower + "\n" + doc.m_keywords + "\n" + doc.m_description))
+    {
+        auto it = m_trigrams.find(key);
+        if(it == m_trigrams.end())
+            continue;
+
+        Postings& postings = it.value();
+        auto itSlot = std::lower_bound(postings.begin(), postings.end(), slot);
+
+        if(itSlot != postings.end() && *itSlot == slot)
+            postings.erase(itSlot);
+
+        if(postings.empty())
+            m_trigrams.erase(it);
+    }
+
+    m_words.erase(std::remove_if(m_words.begin(), m_words.end(), [slot](const WordEntry& entry)
+    {
+        return entry.second == slot;
+    }), m_words.end());
+}
+
+CProcessSearchIndex::Postings CProcessSearchIndex::getTrigramCandidates(const QString &term) const
+{
+    std::vector<const Postings*> lists;
+    for(auto key : getTrigrams(term))
+    {
+        auto it = m_trigrams.constFind(key);
+        if(it == m_trigrams.constEnd())
+            return Postings();
+
+        lists.push_back(&it.value());
+    }
+
+    if(lists.empty())
+        return Postings();
+
+    // Shortest lists first to keep intersections small
+    std::sort(lists.begin(), lists.end(), [](const Postings* p1, const Postings* p2)
+    {
+        return p1->size() < p2->size();
+    });
+
+    Postings candidates = *lists[0];
+    for(size_t i=1; i<lists.size() && candidates.empty() == false; ++i)
+        candidates = intersect(candidates, *lists[i]);
+
+    return candidates;
+}
+
+CProcessSearchIndex::Postings CProcessSearchIndex::getPrefixCandidates(const QString &term) const
+{
+    Postings candidates;
+    auto it = std::lower_bound(m_words.begin(), m_words.end(), std::make_pair(term, std::numeric_limits<int>::min()));
+
+    for(; it != m_words.end() && it->first.startsWith(term); ++it)
+        candidates.push_back(it->second);
+
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+    return candidates;
+}
+
+int CProcessSearchIndex::getScore(const CDocument &doc, const QStringList &terms) const
+{
+    int score = 0;
+    for(auto&& term : terms)
+    {
+        bool bLong = term.size() >= 3;
+        int termScore = 0;
+
+        if(doc.m_nameLower.startsWith(term))
+            termScore = 100;
+        else if(hasWordPrefix(doc.m_nameWords, term))
+            termScore = 60;
+        else if(bLong && doc.m_nameLower.contains(term))
+            termScore = 40;
+        else if(hasWordPrefix(doc.m_keywordWords, term))
+            termScore = 30;
+        else if(bLong && doc.m_keywords.contains(term))
+            termScore = 20;
+        else if(bLong && doc.m_description.contains(term))
+            termScore = 5;
+
+        // All terms must match
+        if(termScore == 0)
+            return 0;
+
+        score += termScore;
+    }
+    return score;
+}
+
+QStringList CProcessSearchIndex::splitWords(const QString &text)
+{
+    static const QRegularExpression separators("[^\\p{L}\\p{N}]+");
+    return text.toLower().split(separators, QString::SkipEmptyParts);
+}
+
+std::vector<quint64> CProcessSearchIndex::getTrigrams(const QString &text)
+{
+    std::vector<quint64> trigrams;
+    if(text.size() < 3)
+        return trigrams;
+
+    trigrams.reserve(static_cast<size_t>(text.size() - 2));
+    for(int i=0; i<text.size()-2; ++i)
+    {
+        quint64 key = (static_cast<quint64>(text[i].unicode()) << 32) |
+                      (static_cast<quint64>(text[i+1].unicode()) << 16) |
+                      static_cast<quint64>(text[i+2].unicode());
+        trigrams.push_back(key);
+    }
+    std::sort(trigrams.begin(), trigrams.end());
+    trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+    return trigrams;
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2021 Ikomia SAS
+ * Contact: https://www.ikomia.com
+ *
+ * This file is part of the IkomiaStudio software.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CPROCESSSEARCHINDEX_H
+#define CPROCESSSEARCHINDEX_H
+
+#include <QSqlDatabase>
+#include <QHash>
+
+// In-memory search index over process name, keywords and descriptions.
+// Terms of 3 characters or more are looked up by trigrams, shorter terms by word prefix.
+// All terms must match, results are ranked by where they match (name first).
+class CProcessSearchIndex
+{
+    public:
+
+        struct CResult
+        {
+            int     m_id = -1;
+            QString m_name;
+            int     m_score = 0;
+        };
+        using Results = std::vector<CResult>;
+
+        CProcessSearchIndex();
+
+        void        build(QSqlDatabase& db);
+        void        update(QSqlDatabase& db, const QString& name);
+        void        clear();
+
+        bool        search(const QString& text, Results& results) const;
+
+    private:
+
+        struct CDocument
+        {
+            int         m_id = -1;
+            QString     m_name;
+            QString     m_nameLower;
+            QString     m_keywords;
+            QString     m_description;
+            QStringList m_nameWords;
+            QStringList m_keywordWords;
+        };
+        using Postings = std::vector<int>;
+        using WordEntry = std::pair<QString, int>;
+
+        void        addDocument(int slot, CDocument&& doc, bool bSorted);
+        void        removeDocument(int slot);
+
+        Postings    getTrigramCandidates(const QString& term) const;
+        Postings    getPrefixCandidates(const QString& term) const;
+
+        int         getScore(const CDocument& doc, const QStringList& terms) const;
+
+        static QStringList          splitWords(const QString& text);
+        static std::vector<quint64> getTrigrams(const QString& text);
+
+    private:
+
+        std::vector<CDocument>      m_docs;
+        QHash<QString, int>         m_slots;
+        QHash<quint64, Postings>    m_trigrams;
+        std::vector<WordEntry>      m_words;
+};
+
+#endif // CPROCESSSEARCHINDEX_H
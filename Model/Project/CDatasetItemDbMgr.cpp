@@ -53,14 +53,11 @@ std::shared_ptr<CItem> CDatasetItemDbMgr::load(const QSqlQuery &q, QModelIndex &
 
 void CDatasetItemDbMgr::save(std::shared_ptr<ProjectTreeItem> itemPtr, int dbId)
 {
-    Q_UNUSED(dbId);
-
     createTables();
     auto pItem = itemPtr->getNode<std::shared_ptr<CDatasetItem<CMat>>>();
     auto dataset = pItem->getDataset();
-    auto id = itemPtr->getId();
     auto type = static_cast<int>(dataset->getType());
-    m_mapTypes.insert(id, type);
+    m_mapTypes.insert(dbId, type);
 }
 
 void CDatasetItemDbMgr::batchSave()
@@ -69,6 +66,9 @@ void CDatasetItemDbMgr::batchSave()
     if(db.isValid() == false)
         throw CException(DatabaseExCode::INVALID_QUERY, "Invalid database connection", __func__, __FILE__, __LINE__);
 
+    if(m_bIncremental == true)
+        removeItems(m_mapTypes.keys().toVector().toStdVector());
+
     QSqlQuery q(db);
     if(!q.prepare(QString("INSERT INTO dataset (itemId, datatype) values (?, ?)")))
         throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
@@ -83,6 +83,11 @@ void CDatasetItemDbMgr::batchSave()
         throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
 }
 
+void CDatasetItemDbMgr::removeItems(const std::vector<int>& dbIds)
+{
+    removeRows("dataset", "itemId", dbIds);
+}
+
 void CDatasetItemDbMgr::createTables()
 {
     if(m_bTablesCreated == false)
@@ -95,15 +100,18 @@ void CDatasetItemDbMgr::createTables()
         QSqlQuery q(db);
         QStringList tables = db.tables(QSql::Tables);
 
-        if(tables.contains("dataset"))
+        if(isTableReusable(tables, "dataset") == false)
         {
-            if(!q.exec(QString("DROP TABLE dataset")))
+            if(tables.contains("dataset"))
+            {
+                if(!q.exec(QString("DROP TABLE dataset")))
+                    throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+            }
+
+            if(!q.exec("CREATE TABLE dataset (id INTEGER PRIMARY KEY, itemId INTEGER, datatype INTEGER);"))
                 throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
         }
 
-        if(!q.exec("CREATE TABLE dataset (id INTEGER PRIMARY KEY, itemId INTEGER, datatype INTEGER);"))
-            throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
-
         m_bTablesCreated = true;
     }
 }
@@ -65,13 +65,10 @@ std::shared_ptr<CItem> CDimensionItemDbMgr::load(const QSqlQuery &q, QModelIndex
 
 void CDimensionItemDbMgr::save(std::shared_ptr<ProjectTreeItem> itemPtr, int dbId)
 {
-    Q_UNUSED(dbId);
-
     createTables();
     auto pItem = itemPtr->getNode<std::shared_ptr<CDimensionItem>>();
     auto dim = static_cast<int>(pItem->getDimension());
-    auto id = static_cast<int>(itemPtr->getId());
-    m_mapTypes.insert(id, dim);
+    m_mapTypes.insert(dbId, dim);
 }
 
 void CDimensionItemDbMgr::batchSave()
@@ -80,6 +77,9 @@ void CDimensionItemDbMgr::batchSave()
     if(db.isValid() == false)
         throw CException(DatabaseExCode::INVALID_QUERY, "Invalid database connection", __func__, __FILE__, __LINE__);
 
+    if(m_bIncremental == true)
+        removeItems(m_mapTypes.keys().toVector().toStdVector());
+
     QSqlQuery q(db);
     if(!q.prepare(QString("INSERT INTO dimension (itemId, datadimension) values (?, ?)")))
         throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
@@ -94,6 +94,11 @@ void CDimensionItemDbMgr::batchSave()
         throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
 }
 
+void CDimensionItemDbMgr::removeItems(const std::vector<int>& dbIds)
+{
+    removeRows("dimension", "itemId", dbIds);
+}
+
 void CDimensionItemDbMgr::createTables()
 {
     if(m_bTablesCreated == false)
@@ -106,15 +111,18 @@ void CDimensionItemDbMgr::createTables()
         QStringList tables = db.tables(QSql::Tables);
 
         //Table "dimension" to store dimension type
-        if(tables.contains("dimension"))
+        if(isTableReusable(tables, "dimension") == false)
         {
-            if(!q.exec(QString("DROP TABLE dimension")))
+            if(tables.contains("dimension"))
+            {
+                if(!q.exec(QString("DROP TABLE dimension")))
+                    throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+            }
+
+            if(!q.exec("CREATE TABLE dimension (id INTEGER PRIMARY KEY, itemId INTEGER, datadimension INTEGER);"))
                 throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
         }
 
-        if(!q.exec("CREATE TABLE dimension (id INTEGER PRIMARY KEY, itemId INTEGER, datadimension INTEGER);"))
-            throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
-
         m_bTablesCreated = true;
     }
 }
@@ -41,6 +41,8 @@ void CMultiProjectModel::removeItem(const QModelIndex& index)
                 pModel->removeItem(itemIndex);
                 // Remove item from parent childlist
                 pParentItem->eraseChild(pTreeItem->m_nRow);
+                // Wrapped items are deleted
+                pTreeItem->clearSource();
                 //pTreeItem->m_pParent->m_children.removeOne( pTreeItem );
                 // Remove all children
                 //pTreeItem->clearChildren();
@@ -143,6 +145,11 @@ QModelIndex CMultiProjectModel::findItemFromName(const std::string &name, QModel
     return QModelIndex();
 }
 
+QModelIndex CMultiProjectModel::createWrappedIndex(QAbstractItemModel *pModel, int row, int col, void *pSource) const
+{
+    return static_cast<CProjectModel*>(pModel)->createItemIndex(row, col, pSource);
+}
+
 int CMultiProjectModel::findProjectRow(const QModelIndex& index)
 {
     auto currentIndex = index;
@@ -51,6 +51,7 @@ class CMultiProjectModel : public CMultiModel
                 pTreeItem->m_children.push_back(pChildItem);
                 // Add item to model
                 pModel->emplace_back(itemIndex, std::forward<T>(t));
+                pChildItem->m_pSource = pModel->index(pChildItem->m_nRow, 0, itemIndex).internalPointer();
             endInsertRows();
 
             emit dataChanged(parentIndex, parentIndex);
@@ -100,6 +101,10 @@ class CMultiProjectModel : public CMultiModel
 
         QModelIndex     getWrappedIndex(const QModelIndex& index) const;
 
+    protected:
+
+        QModelIndex     createWrappedIndex(QAbstractItemModel* pModel, int row, int col, void* pSource) const override;
+
     private slots:
 
         void            onDataChanged(const QModelIndex& topLeft, const QModelIndex& bottomRight, const QVector<int>& roles);
@@ -65,7 +65,11 @@ class CProjectDbManager : public CTreeDbManager<CProjectModel, std::shared_ptr<C
                 m_db.transaction();
 
             //m_error = activatePragma();
+            m_nodes.clear();
             fillModelFromDatabase();
+            m_nodes.clear();
+            // Children insertion marks parents as modified: loaded items match the file
+            clearModified(m_pModel->getRoot());
 
             if(m_bHasTransaction)
                 m_db.commit();
@@ -83,6 +87,31 @@ class CProjectDbManager : public CTreeDbManager<CProjectModel, std::shared_ptr<C
             createPropertiesTable();
             saveProperties();
 
+            //Project already stored in this file: write only changed items if possible
+            if(prepareJournal() == true)
+            {
+                if(m_bHasTransaction)
+                    m_db.transaction();
+
+                try
+                {
+                    saveJournal();
+                }
+                catch(...)
+                {
+                    if(m_bHasTransaction)
+                        m_db.rollback();
+
+                    throw;
+                }
+
+                if(m_bHasTransaction)
+                    m_db.commit();
+
+                notifyJournalSaved();
+                return;
+            }
+
             if(m_bHasTransaction)
                 m_db.transaction();
 
@@ -104,56 +133,52 @@ class CProjectDbManager : public CTreeDbManager<CProjectModel, std::shared_ptr<C
         void    addProjectItem(QSqlQuery q, ProjectItemDbMgrPtr itemPtr)
         {
             assert(q.isValid());
-            int nodeLevel = q.record().value("level").toInt();
             int nodeId = q.record().value("id").toInt();
             int parentId = q.record().value("parentid").toInt();
             auto nodeItem = std::static_pointer_cast<T>(itemPtr->load(q, m_prevIndex));
             assert(nodeItem != nullptr);
+            nodeItem->setDbId(nodeId);
+            nodeItem->setModified(false);
+
+            // Parents are always loaded before their children: an unknown parent
+            // means a top-level item, attached directly to the root
+            auto parent = m_nodes.value(parentId, nullptr);
+            if(parent == nullptr)
+                parent = m_pModel->getRoot();
+
+            // Appended as last child: no need to search for its position
+            parent->emplace_back(nodeItem);
+            m_prevIndex = m_pModel->getLastChildIndex(parent);
+            m_nodes.insert(nodeId, parent->getLastChild());
+        }
 
-            // Liste des éléments de niveau immédiatement inférieur
-            itemMap listPreviousLevel = m_map.value(nodeLevel - 1);
+        ProjectItemDbMgrPtr getItemDbManager(TreeItemType typeId)
+        {
+            auto it = m_itemDbManagers.find(typeId);
+            if(it != m_itemDbManagers.end())
+                return it.value();
 
-            if (listPreviousLevel.isEmpty() == false)
-            {
-                auto parent = listPreviousLevel.value(parentId);
-                assert(parent != nullptr);
-                parent->emplace_back(nodeItem);
-                m_prevIndex = m_pModel->getIndexFrom(parent, nodeItem);
-                // Ajout de l'élément à la liste des éléments de même niveau
-                itemMap listCurrentLevel = m_map.value(nodeLevel);
-                listCurrentLevel.insert(nodeId, parent->getLastChild());
-                m_map.insert(nodeLevel, listCurrentLevel);
-            }
-            else
-            {
-                // Cet élément est le premier dans son niveau : on l'ajoute directement à la racine
-                auto root = m_pModel->getRoot();
-                root->emplace_back(nodeItem);
-                m_prevIndex = m_pModel->getIndexFrom(root, nodeItem);
-                listPreviousLevel.insert(nodeId, root->getLastChild());
-                m_map.insert(nodeLevel, listPreviousLevel);
-            }
+            auto dbMgrFactory = m_dbMgrRegistration.getFactory();
+            auto itemDbMgrPtr = dbMgrFactory.createObject(typeId, getPath(), getConnectionName());
+
+            if(itemDbMgrPtr == nullptr)
+                throw CException(CoreExCode::NULL_POINTER, "Fail to create project item database manager", __func__, __FILE__, __LINE__);
+
+            itemDbMgrPtr->setIncremental(m_bIncremental);
+            m_itemDbManagers.insert(typeId, itemDbMgrPtr);
+            return itemDbMgrPtr;
         }
 
         void    saveItem(std::shared_ptr<ProjectTreeItem> itemPtr)
         {
             assert(itemPtr);
 
-            ProjectItemDbMgrPtr itemDbMgrPtr;
             int itemDbId = addItem(QString::fromStdString(itemPtr->getName()), itemPtr->getTypeId(), itemPtr->getId(), itemPtr->getParent()->getId());
             auto typeId = static_cast<TreeItemType>(itemPtr->getTypeId());
-            auto it = m_itemDbManagers.find(typeId);
-
-            if(it == m_itemDbManagers.end())
-            {
-                auto dbMgrFactory = m_dbMgrRegistration.getFactory();
-                itemDbMgrPtr = dbMgrFactory.createObject(typeId, getPath(), getConnectionName());
-                m_itemDbManagers.insert(typeId, itemDbMgrPtr);
-            }
-            else
-                itemDbMgrPtr = it.value();
-
+            auto itemDbMgrPtr = getItemDbManager(typeId);
             itemDbMgrPtr->save(itemPtr, itemDbId);
+            itemPtr->setDbId(itemDbId);
+            itemPtr->setModified(false);
 
             for(int i = 0; i < itemPtr->getChildCount(); ++i)
             {
@@ -161,6 +186,345 @@ class CProjectDbManager : public CTreeDbManager<CProjectModel, std::shared_ptr<C
                 saveItem(childItemPtr);
             }
         }
+        // Incremental save: the journal lists tree rows to insert, rename or delete and items whose
+        // attributes have to be rewritten. Tree rows use the nested set representation of CTreeDbManager.
+        bool    prepareJournal()
+        {
+            m_journal = CSaveJournal();
+            m_rows.clear();
+
+            auto root = m_pModel->getRoot();
+            if(root == nullptr || root->getChildCount() == 0)
+                return false;
+
+            // Project has never been stored in this file
+            if(root->getChild(0)->getDbId() == -1 || m_db.tables().contains("project") == false)
+                return false;
+
+            // Only the columns handled here: otherwise rows can't be inserted safely
+            const QStringList columns = {"id", "name", "level", "typeid", "parentid", "left", "right"};
+            auto record = m_db.record("project");
+            if(record.count() != columns.size())
+                return false;
+
+            for(auto&& column : columns)
+            {
+                if(record.contains(column) == false)
+                    return false;
+            }
+
+            QSqlQuery q(m_db);
+            if(!q.exec("SELECT id, parentid, \"left\", \"right\", level, typeid, name FROM project;"))
+                throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+
+            while(q.next())
+            {
+                CTreeRow row;
+                int id = q.value(0).toInt();
+                row.m_parentId = q.value(1).toInt();
+                row.m_left = q.value(2).toInt();
+                row.m_right = q.value(3).toInt();
+                row.m_level = q.value(4).toInt();
+                row.m_typeId = static_cast<TreeItemType>(q.value(5).toInt());
+                row.m_name = q.value(6).toString();
+                m_rows.insert(id, row);
+                m_journal.m_nextId = std::max(m_journal.m_nextId, id + 1);
+            }
+
+            // Top level items are never journaled
+            QSet<int> visited;
+            for(int i=0; i<root->getChildCount(); ++i)
+            {
+                auto itemPtr = root->getChild(i);
+                auto it = m_rows.find(itemPtr->getDbId());
+
+                if(it == m_rows.end() || it.value().m_typeId != itemPtr->getTypeId())
+                    return false;
+
+                visited.insert(itemPtr->getDbId());
+                if(isJournalModified(itemPtr))
+                    m_journal.m_updates.push_back(itemPtr);
+
+                if(prepareJournal(itemPtr, visited) == false)
+                    return false;
+            }
+
+            // Rows without matching item: removed subtrees
+            for(auto it=m_rows.begin(); it!=m_rows.end(); ++it)
+            {
+                if(visited.contains(it.key()) == false)
+                {
+                    m_journal.m_deletes[it.value().m_typeId].push_back(it.key());
+                    if(visited.contains(it.value().m_parentId))
+                        m_journal.m_deletedRoots.push_back(it.key());
+                }
+            }
+
+            // Each subtree insertion or deletion shifts the whole tree:
+            // beyond a few of them, a full rewrite is cheaper
+            size_t shiftCount = m_journal.m_insertParents.size() + m_journal.m_deletedRoots.size();
+            return shiftCount <= m_maxJournalShifts;
+        }
+
+        bool    prepareJournal(const std::shared_ptr<ProjectTreeItem>& parentPtr, QSet<int>& visited)
+        {
+            bool bNewChild = false;
+            int prevLeft = -1;
+            const int parentDbId = parentPtr->getDbId();
+
+            for(int i=0; i<parentPtr->getChildCount(); ++i)
+            {
+                auto itemPtr = parentPtr->getChild(i);
+                auto it = m_rows.find(itemPtr->getDbId());
+
+                if(itemPtr->getDbId() == -1 || it == m_rows.end())
+                {
+                    // New items are appended after their existing siblings
+                    if(bNewChild == false)
+                        m_journal.m_insertParents.push_back(parentPtr);
+
+                    bNewChild = true;
+                    continue;
+                }
+
+                // Moved or reordered items: the tree has to be rebuilt
+                const CTreeRow& row = it.value();
+                if(bNewChild == true || row.m_parentId != parentDbId || row.m_left < prevLeft || row.m_typeId != itemPtr->getTypeId())
+                    return false;
+
+                prevLeft = row.m_left;
+                visited.insert(itemPtr->getDbId());
+
+                if(isJournalModified(itemPtr))
+                    m_journal.m_updates.push_back(itemPtr);
+
+                if(prepareJournal(itemPtr, visited) == false)
+                    return false;
+            }
+            return true;
+        }
+
+        void    saveJournal()
+        {
+            m_bIncremental = true;
+            QSqlQuery q(m_db);
+
+            // Removed subtrees
+            for(auto id : m_journal.m_deletedRoots)
+            {
+                auto it = m_rows.find(id);
+                if(it == m_rows.end())
+                    continue;
+
+                const int left = it.value().m_left;
+                const int right = it.value().m_right;
+                if(!q.exec(QString("DELETE FROM project WHERE \"left\" >= %1 AND \"right\" <= %2;").arg(left).arg(right)))
+                    throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+
+                for(auto itRow=m_rows.begin(); itRow!=m_rows.end();)
+                {
+                    if(itRow.value().m_left >= left && itRow.value().m_right <= right)
+                        itRow = m_rows.erase(itRow);
+                    else
+                        ++itRow;
+                }
+                shiftRows(right, left - right - 1);
+            }
+
+            for(auto it=m_journal.m_deletes.begin(); it!=m_journal.m_deletes.end(); ++it)
+                getItemDbManager(it.key())->removeItems(it.value());
+
+            // New subtrees: space is made at the end of the parent interval then filled in depth-first order
+            for(auto&& parentPtr : m_journal.m_insertParents)
+            {
+                int parentDbId = getJournalDbId(parentPtr);
+                int pos = m_rows[parentDbId].m_right;
+                int width = 0;
+
+                for(int i=0; i<parentPtr->getChildCount(); ++i)
+                {
+                    if(isJournalNewItem(parentPtr->getChild(i)))
+                        width += 2 * countItems(parentPtr->getChild(i));
+                }
+                shiftRows(pos - 1, width);
+
+                for(int i=0; i<parentPtr->getChildCount(); ++i)
+                {
+                    auto itemPtr = parentPtr->getChild(i);
+                    if(isJournalNewItem(itemPtr))
+                        pos = insertJournalItem(itemPtr, parentDbId, pos);
+                }
+            }
+
+            if(m_journal.m_inserts.empty() == false)
+            {
+                QVariantList ids, names, levels, typeIds, parentIds, lefts, rights;
+                for(auto&& itemPtr : m_journal.m_inserts)
+                {
+                    int id = m_journal.m_newIds.value(itemPtr.get());
+                    const CTreeRow& row = m_rows[id];
+                    ids << id;
+                    names << row.m_name;
+                    levels << row.m_level;
+                    typeIds << static_cast<int>(row.m_typeId);
+                    parentIds << row.m_parentId;
+                    lefts << row.m_left;
+                    rights << row.m_right;
+                }
+
+                if(!q.prepare("INSERT INTO project (id, name, level, typeid, parentid, \"left\", \"right\") VALUES (?, ?, ?, ?, ?, ?, ?);"))
+                    throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+
+                q.addBindValue(ids);
+                q.addBindValue(names);
+                q.addBindValue(levels);
+                q.addBindValue(typeIds);
+                q.addBindValue(parentIds);
+                q.addBindValue(lefts);
+                q.addBindValue(rights);
+
+                if(!q.execBatch())
+                    throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+            }
+
+            // Renamed items
+            QVariantList renamedIds, newNames;
+            for(auto&& itemPtr : m_journal.m_updates)
+            {
+                auto name = QString::fromStdString(itemPtr->getName());
+                if(m_rows[itemPtr->getDbId()].m_name != name)
+                {
+                    renamedIds << itemPtr->getDbId();
+                    newNames << name;
+                }
+            }
+
+            if(renamedIds.empty() == false)
+            {
+                if(!q.prepare("UPDATE project SET name = ? WHERE id = ?;"))
+                    throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+
+                q.addBindValue(newNames);
+                q.addBindValue(renamedIds);
+
+                if(!q.execBatch())
+                    throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+            }
+
+            // Item attributes: only new and modified items
+            for(auto&& itemPtr : m_journal.m_inserts)
+                getItemDbManager(static_cast<TreeItemType>(itemPtr->getTypeId()))->save(itemPtr, m_journal.m_newIds.value(itemPtr.get()));
+
+            for(auto&& itemPtr : m_journal.m_updates)
+                getItemDbManager(static_cast<TreeItemType>(itemPtr->getTypeId()))->save(itemPtr, itemPtr->getDbId());
+
+            batchSave();
+        }
+
+        void    notifyJournalSaved()
+        {
+            for(auto&& itemPtr : m_journal.m_inserts)
+            {
+                itemPtr->setDbId(m_journal.m_newIds.value(itemPtr.get()));
+                itemPtr->setModified(false);
+            }
+
+            for(auto&& itemPtr : m_journal.m_updates)
+                itemPtr->setModified(false);
+
+            m_journal = CSaveJournal();
+            m_rows.clear();
+        }
+
+        int     insertJournalItem(const std::shared_ptr<ProjectTreeItem>& itemPtr, int parentDbId, int pos)
+        {
+            CTreeRow row;
+            int id = m_journal.m_nextId++;
+            row.m_parentId = parentDbId;
+            row.m_left = pos++;
+            row.m_level = m_rows[parentDbId].m_level + 1;
+            row.m_typeId = static_cast<TreeItemType>(itemPtr->getTypeId());
+            row.m_name = QString::fromStdString(itemPtr->getName());
+            m_rows.insert(id, row);
+            m_journal.m_newIds.insert(itemPtr.get(), id);
+            m_journal.m_inserts.push_back(itemPtr);
+
+            for(int i=0; i<itemPtr->getChildCount(); ++i)
+                pos = insertJournalItem(itemPtr->getChild(i), id, pos);
+
+            m_rows[id].m_right = pos++;
+            return pos;
+        }
+
+        // Shift interval bounds located after position, in database and in cached rows
+        void    shiftRows(int position, int offset)
+        {
+            if(offset == 0)
+                return;
+
+            QSqlQuery q(m_db);
+            if(!q.exec(QString("UPDATE project SET \"right\" = \"right\" + %1 WHERE \"right\" > %2;").arg(offset).arg(position)))
+                throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+
+            if(!q.exec(QString("UPDATE project SET \"left\" = \"left\" + %1 WHERE \"left\" > %2;").arg(offset).arg(position)))
+                throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+
+            for(auto&& row : m_rows)
+            {
+                if(row.m_right > position)
+                    row.m_right += offset;
+                if(row.m_left > position)
+                    row.m_left += offset;
+            }
+        }
+
+        // Datasets and loaded graphics layers are edited through objects that don't
+        // notify their item: they are always rewritten
+        bool    isJournalModified(const std::shared_ptr<ProjectTreeItem>& itemPtr) const
+        {
+            if(itemPtr->isModified())
+                return true;
+
+            switch(static_cast<TreeItemType>(itemPtr->getTypeId()))
+            {
+                case TreeItemType::DATASET:
+                    return true;
+                case TreeItemType::GRAPHICS_LAYER:
+                    return itemPtr->getNode<std::shared_ptr<CGraphicsLayerItem>>()->isLoaded();
+                default:
+                    return false;
+            }
+        }
+
+        void    clearModified(const std::shared_ptr<ProjectTreeItem>& itemPtr)
+        {
+            if(itemPtr == nullptr)
+                return;
+
+            itemPtr->setModified(false);
+            for(int i=0; i<itemPtr->getChildCount(); ++i)
+                clearModified(itemPtr->getChild(i));
+        }
+
+        bool    isJournalNewItem(const std::shared_ptr<ProjectTreeItem>& itemPtr) const
+        {
+            return m_journal.m_newIds.contains(itemPtr.get()) || itemPtr->getDbId() == -1 || m_rows.contains(itemPtr->getDbId()) == false;
+        }
+
+        int     getJournalDbId(const std::shared_ptr<ProjectTreeItem>& itemPtr) const
+        {
+            return m_journal.m_newIds.value(itemPtr.get(), itemPtr->getDbId());
+        }
+
+        int     countItems(const std::shared_ptr<ProjectTreeItem>& itemPtr) const
+        {
+            int count = 1;
+            for(int i=0; i<itemPtr->getChildCount(); ++i)
+                count += countItems(itemPtr->getChild(i));
+
+            return count;
+        }
+
         void    saveProperties()
         {
             QString path = QString::fromStdString(Utils::String::dbFormat(m_pModel->getOriginalPath().toStdString()));
@@ -278,9 +642,37 @@ class CProjectDbManager : public CTreeDbManager<CProjectModel, std::shared_ptr<C
 
     private:
 
+        struct CTreeRow
+        {
+            int             m_parentId = -1;
+            int             m_left = 0;
+            int             m_right = 0;
+            int             m_level = 0;
+            TreeItemType    m_typeId = TreeItemType::NONE;
+            QString         m_name;
+        };
+
+        struct CSaveJournal
+        {
+            int                                             m_nextId = 0;
+            std::vector<std::shared_ptr<ProjectTreeItem>>   m_insertParents;
+            std::vector<std::shared_ptr<ProjectTreeItem>>   m_inserts;
+            std::vector<std::shared_ptr<ProjectTreeItem>>   m_updates;
+            std::vector<int>                                m_deletedRoots;
+            QMap<TreeItemType, std::vector<int>>            m_deletes;
+            QHash<ProjectTreeItem*, int>                    m_newIds;
+        };
+
+        const size_t                            m_maxJournalShifts = 32;
+        bool                                    m_bIncremental = false;
+        CSaveJournal                            m_journal;
+        // Database id -> tree row, only valid during incremental save
+        QHash<int, CTreeRow>                    m_rows;
         QString                                 m_projectName = "Project";
         QString                                 m_projectFileName = ":memory:";
         QMap<TreeItemType, ProjectItemDbMgrPtr> m_itemDbManagers;
+        // Database id -> tree node, only valid while loading
+        QHash<int, std::shared_ptr<ProjectTreeItem>>    m_nodes;
         CProjectDbMgrRegistration               m_dbMgrRegistration;
 };
 
@@ -19,7 +19,10 @@
 #ifndef CPROJECTITEMDBMANAGER_HPP
 #define CPROJECTITEMDBMANAGER_HPP
 
+#include <QSqlQuery>
+#include <QSqlError>
 #include "DesignPattern/CAbstractFactory.hpp"
+#include "UtilsTools.hpp"
 #include "Model/Project/CProjectModel.h"
 
 class CItem;
@@ -44,6 +47,17 @@ class CProjectItemBaseDbMgr
         virtual void                    save(std::shared_ptr<ProjectTreeItem> itemPtr, int dbId) = 0;
         //Method use to save full set of attributes of item list filled in the save function (optional - optimization)
         virtual void                    batchSave() = 0;
+        //Method to delete attributes of removed items (incremental save only)
+        virtual void                    removeItems(const std::vector<int>& dbIds)
+        {
+            Q_UNUSED(dbIds);
+        }
+
+        //Incremental save: existing tables are kept and only rows of given items are replaced
+        void                            setIncremental(bool bIncremental)
+        {
+            m_bIncremental = bIncremental;
+        }
 
         //Method to store project properties: current path, original path and export state
         void                            setProjectProperties(const QString& path, const QString& originalPath, bool bExported)
@@ -58,11 +72,44 @@ class CProjectItemBaseDbMgr
             return (m_bProjectExported == true && m_projectPath != m_projectOriginalPath);
         }
 
+    protected:
+
+        bool                            isTableReusable(const QStringList& tables, const QString& name) const
+        {
+            return m_bIncremental == true && tables.contains(name);
+        }
+
+        void                            removeRows(const QString& table, const QString& column, const std::vector<int>& dbIds)
+        {
+            if(dbIds.empty())
+                return;
+
+            auto db = Utils::Database::connect(m_dbPath, m_connection);
+            if(db.isValid() == false)
+                throw CException(DatabaseExCode::INVALID_QUERY, "Invalid database connection", __func__, __FILE__, __LINE__);
+
+            if(db.tables(QSql::Tables).contains(table) == false)
+                return;
+
+            QSqlQuery q(db);
+            if(!q.prepare(QString("DELETE FROM %1 WHERE %2 = ?;").arg(table).arg(column)))
+                throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+
+            QVariantList ids;
+            for(auto id : dbIds)
+                ids << id;
+
+            q.addBindValue(ids);
+            if(!q.execBatch())
+                throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+        }
+
     protected:
 
         QString m_connection = "ProjectMemoryDB";
         QString m_dbPath = ":memory:";
         bool    m_bTablesCreated = false;
+        bool    m_bIncremental = false;
         QString m_projectPath;
         QString m_projectOriginalPath;
         bool    m_bProjectExported = false;
@@ -19,6 +19,7 @@
 #include "CProjectManager.h"
 #include <iostream>
 #include <QtConcurrent>
+#include <QTimer>
 #include <boost/filesystem.hpp>
 #include <unordered_map>
 #include "Main/LogCategory.h"
@@ -778,6 +779,12 @@ void CProjectManager::onShowLocation(const QModelIndex &index)
 void CProjectManager::initConnections()
 {
     connect(&m_multiProject, &CMultiProjectModel::dataChanged, this, &CProjectManager::onDataChanged);
+
+    // Any structural change of the project tree invalidates folder data maps
+    connect(&m_multiProject, &CMultiProjectModel::rowsInserted, this, &CProjectManager::clearFolderDataMaps);
+    connect(&m_multiProject, &CMultiProjectModel::rowsRemoved, this, &CProjectManager::clearFolderDataMaps);
+    connect(&m_multiProject, &CMultiProjectModel::rowsMoved, this, &CProjectManager::clearFolderDataMaps);
+    connect(&m_multiProject, &CMultiProjectModel::modelReset, this, &CProjectManager::clearFolderDataMaps);
 }
 
 QModelIndex CProjectManager::getImageIndexFromSubItem(const QModelIndex &index)
@@ -944,14 +951,16 @@ void CProjectManager::removeImage(const QModelIndex &itemIndex)
     //Notify others managers that image will be removed from project
     notifyBeforeDataDeleted(itemIndex);
 
+    //Dataset position must be retrieved while the image item exists
+    auto pDataset = CProjectUtils::getDataset<CMat>(wrapIndex(itemIndex));
+    size_t index = pDataset ? CProjectUtils::getIndexInDataset(wrapIndex(itemIndex)) : SIZE_MAX;
+
     //Remove image from project -> to do before removing from dataset
     m_multiProject.removeItem(itemIndex);
 
     //Remove from dataset
-    auto pDataset = CProjectUtils::getDataset<CMat>(wrapIndex(itemIndex));
     if(pDataset)
     {
-        size_t index = CProjectUtils::getIndexInDataset(wrapIndex(itemIndex));
         // Clear subset bounds to avoid displaying the removed image
         pDataset->subset().bounds().clear();
         if(index != SIZE_MAX)
@@ -1357,33 +1366,8 @@ ProjectTreeItem *CProjectManager::getItem(const QModelIndex &index) const
 
 size_t CProjectManager::getFolderDataItemCount(const QModelIndex &index) const
 {
-    size_t count = 0;
-    auto pItem = static_cast<ProjectTreeItem*>(wrapIndex(index).internalPointer());
-    TreeItemType type = static_cast<TreeItemType>(pItem->getTypeId());
-
-    if(type != TreeItemType::FOLDER)
-        return 0;
-
-    int childCount = m_multiProject.rowCount(index);
-    for(int i=0; i<childCount; ++i)
-    {
-        auto childIndex = m_multiProject.index(i, 0, index);
-        auto wrapChildIndex = wrapIndex(childIndex);
-        auto pChild = static_cast<ProjectTreeItem*>(wrapChildIndex.internalPointer());
-        auto childType = static_cast<TreeItemType>(pChild->getTypeId());
-
-        if(childType == TreeItemType::FOLDER)
-            count += getFolderDataItemCount(childIndex);
-        else if(childType == TreeItemType::DATASET)
-        {
-            auto pDataset = CProjectUtils::getDataset<CMat>(wrapChildIndex);
-            if(pDataset->hasDimension(DataDimension::VOLUME) || pDataset->hasDimension(DataDimension::TIME))
-                count += 1;
-            else
-                count += pDataset->size();
-        }
-    }
-    return count;
+    std::lock_guard<std::mutex> lock(m_folderDataMutex);
+    return getFolderDataMap(index).m_offsets.back();
 }
 
 QModelIndex CProjectManager::getDatasetDataIndex(const QModelIndex& datasetIndex, size_t dataIndex) const
@@ -1407,13 +1391,61 @@ QModelIndex CProjectManager::getDatasetDataIndex(const QModelIndex& datasetIndex
 
 QModelIndex CProjectManager::getFolderDataIndex(const QModelIndex &folderIndex, size_t& dataIndex) const
 {
-    QModelIndex dataModelIndex;
+    QPersistentModelIndex datasetIndex;
+    bool bSingleItem = false;
+    {
+        std::lock_guard<std::mutex> lock(m_folderDataMutex);
+        const CFolderDataMap& dataMap = getFolderDataMap(folderIndex);
+
+        if(dataIndex >= dataMap.m_offsets.back())
+            return QModelIndex();
+
+        // Binary search on prefix sums: first dataset whose end is beyond dataIndex
+        auto it = std::upper_bound(dataMap.m_offsets.begin(), dataMap.m_offsets.end(), dataIndex);
+        size_t pos = std::distance(dataMap.m_offsets.begin(), it) - 1;
+        dataIndex -= dataMap.m_offsets[pos];
+        datasetIndex = dataMap.m_datasets[pos];
+        bSingleItem = dataMap.m_singleItems[pos];
+    }
+
+    if(bSingleItem)
+        return getDatasetDataIndex(datasetIndex, 0);
+    else
+        return getDatasetDataIndex(datasetIndex, dataIndex);
+}
+
+const CProjectManager::CFolderDataMap &CProjectManager::getFolderDataMap(const QModelIndex &folderIndex) const
+{
+    // Caller must hold m_folderDataMutex
+    auto it = m_folderDataMaps.find(folderIndex);
+    if(it != m_folderDataMaps.end())
+        return it.value();
+
+    // Maps hold persistent indexes on the project model: they are only built in the main thread.
+    // Batch runs build them when counting items, worker threads only read them.
+    if(QThread::currentThread() != thread())
+    {
+        static const CFolderDataMap emptyMap = {{}, {0}, {}};
+        qCWarning(logProject).noquote() << tr("Folder data map requested from a worker thread before being built");
+        return emptyMap;
+    }
+    return m_folderDataMaps.insert(folderIndex, buildFolderDataMap(folderIndex)).value();
+}
+
+CProjectManager::CFolderDataMap CProjectManager::buildFolderDataMap(const QModelIndex &folderIndex) const
+{
+    CFolderDataMap dataMap;
+    dataMap.m_offsets.push_back(0);
+
     auto pItem = static_cast<ProjectTreeItem*>(wrapIndex(folderIndex).internalPointer());
-    TreeItemType type = static_cast<TreeItemType>(pItem->getTypeId());
+    if(pItem && static_cast<TreeItemType>(pItem->getTypeId()) == TreeItemType::FOLDER)
+        fillFolderDataMap(folderIndex, dataMap);
 
-    if(type != TreeItemType::FOLDER)
-        return QModelIndex();
+    return dataMap;
+}
 
+void CProjectManager::fillFolderDataMap(const QModelIndex &folderIndex, CFolderDataMap &dataMap) const
+{
     int childCount = m_multiProject.rowCount(folderIndex);
     for(int i=0; i<childCount; ++i)
     {
@@ -1423,31 +1455,53 @@ QModelIndex CProjectManager::getFolderDataIndex(const QModelIndex &folderIndex,
         auto childType = static_cast<TreeItemType>(pChild->getTypeId());
 
         if(childType == TreeItemType::FOLDER)
-        {
-            dataModelIndex = getFolderDataIndex(childIndex, dataIndex);
-            if(dataModelIndex.isValid())
-                return dataModelIndex;
-        }
+            fillFolderDataMap(childIndex, dataMap);
         else if(childType == TreeItemType::DATASET)
         {
+            // Volume and time datasets are processed as a single item
             auto pDataset = CProjectUtils::getDataset<CMat>(wrapChildIndex);
-            if(pDataset->hasDimension(DataDimension::VOLUME) || pDataset->hasDimension(DataDimension::TIME))
-            {
-                if(dataIndex == 0)
-                    return getDatasetDataIndex(childIndex, dataIndex);
-
-                dataIndex--;
-            }
-            else
-            {
-                if(dataIndex < pDataset->size())
-                    return getDatasetDataIndex(childIndex, dataIndex);
+            bool bSingleItem = pDataset->hasDimension(DataDimension::VOLUME) || pDataset->hasDimension(DataDimension::TIME);
+            size_t size = bSingleItem ? 1 : pDataset->size();
 
-                dataIndex -= pDataset->size();
-            }
+            dataMap.m_datasets.push_back(childIndex);
+            dataMap.m_singleItems.push_back(bSingleItem);
+            dataMap.m_offsets.push_back(dataMap.m_offsets.back() + size);
         }
     }
-    return QModelIndex();
+}
+
+void CProjectManager::clearFolderDataMaps()
+{
+    // Maps in use (batch run) are rebuilt once in the main thread after a burst of changes,
+    // readers keep the previous version meanwhile
+    {
+        std::lock_guard<std::mutex> lock(m_folderDataMutex);
+        if(m_folderDataMaps.empty() || m_bFolderDataRebuild)
+            return;
+
+        m_bFolderDataRebuild = true;
+    }
+    QTimer::singleShot(0, this, [this]{ rebuildFolderDataMaps(); });
+}
+
+void CProjectManager::rebuildFolderDataMaps()
+{
+    QList<QPersistentModelIndex> folders;
+    {
+        std::lock_guard<std::mutex> lock(m_folderDataMutex);
+        m_bFolderDataRebuild = false;
+        folders = m_folderDataMaps.keys();
+    }
+
+    QHash<QPersistentModelIndex, CFolderDataMap> dataMaps;
+    for(auto&& folderIndex : folders)
+    {
+        if(folderIndex.isValid())
+            dataMaps.insert(folderIndex, buildFolderDataMap(folderIndex));
+    }
+
+    std::lock_guard<std::mutex> lock(m_folderDataMutex);
+    m_folderDataMaps.swap(dataMaps);
 }
 
 bool CProjectManager::isTimeDataItem(const QModelIndex &index) const
@@ -1599,6 +1653,7 @@ QModelIndex CProjectManager::addVideos(const QModelIndex& itemIndex, const QStri
     QModelIndex index;
     if(itemIndex.isValid())
     {
+        std::vector<std::string> paths;
         for(int i=0; i<files.size(); ++i)
         {
             boost::filesystem::path path(files[i].toStdString());
@@ -1616,7 +1671,10 @@ QModelIndex CProjectManager::addVideos(const QModelIndex& itemIndex, const QStri
             pSet->appendFile(files[i].toStdString());
 
             index = m_multiProject.addItem(dimIndex, std::make_shared<CVideoItem>(path.stem().string(), path.string()));
+            paths.push_back(path.string());
         }
+        // Build video index (frame count...) in background
+        m_pDataMgr->getVideoMgr()->indexVideos(paths);
     }
     return index;
 }
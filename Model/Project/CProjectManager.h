@@ -160,8 +160,23 @@ class CProjectManager : public QObject
 
     private:
 
+        // Flattened view of the data items under a folder: dataset k holds
+        // folder items [m_offsets[k], m_offsets[k+1])
+        struct CFolderDataMap
+        {
+            std::vector<QPersistentModelIndex>  m_datasets;
+            std::vector<size_t>                 m_offsets;
+            std::vector<bool>                   m_singleItems;
+        };
+
         void                initConnections();
 
+        const CFolderDataMap&   getFolderDataMap(const QModelIndex& folderIndex) const;
+        CFolderDataMap          buildFolderDataMap(const QModelIndex& folderIndex) const;
+        void                    fillFolderDataMap(const QModelIndex& folderIndex, CFolderDataMap& dataMap) const;
+        void                    clearFolderDataMaps();
+        void                    rebuildFolderDataMaps();
+
         QModelIndex         getImageIndexFromSubItem(const QModelIndex& index);
 
         QModelIndex         addImagesToDimension(const QModelIndex &itemIndex, const QStringList &files);
@@ -218,6 +233,9 @@ class CProjectManager : public QObject
         CProgressBarManager*                m_pProgressMgr = nullptr;
         CMainDataManager*                   m_pDataMgr = nullptr;
         CProgressSignalHandler              m_progressSignal;
+        mutable QHash<QPersistentModelIndex, CFolderDataMap>    m_folderDataMaps;
+        mutable std::mutex                  m_folderDataMutex;
+        bool                                m_bFolderDataRebuild = false;
         int                                 m_loadWatcherCount = 0;
         bool                                m_bVideoChanged = true;
 };
@@ -93,13 +93,20 @@ bool CProjectModel::setData(const QModelIndex &index, const QVariant &value, int
                 else
                     item->setChecked(false);
 
+                item->setModified(true);
                 QVector<int> roles = {Qt::CheckStateRole};
                 emit dataChanged(index, index, roles);
                 return true;
             }
         }
     }
-    return CTreeModel::setData(index, value, role);
+
+    //Any edit from views has to be written on next incremental save
+    bool bDone = CTreeModel::setData(index, value, role);
+    if(bDone && item)
+        item->setModified(true);
+
+    return bDone;
 }
 
 void CProjectModel::setOriginalPath(const QString &path)
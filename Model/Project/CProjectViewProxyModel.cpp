@@ -25,46 +25,19 @@
  */
 
 #include "CProjectViewProxyModel.h"
-#include <QtConcurrent>
 #include "Main/LogCategory.h"
 #include "Main/AppTools.hpp"
 #include "Model/Project/CMultiProjectModel.h"
 #include "Model/Project/CProjectModel.h"
 #include "Model/Project/CProjectUtils.hpp"
+#include "Model/Data/Image/CThumbnailStore.h"
 
 
-static void createIcon(const QPersistentModelIndex& itemIndex, const QSize& size)
-{
-    assert(itemIndex.isValid());
-    auto pModel = static_cast<const CMultiProjectModel*>(itemIndex.model());
-    assert(pModel);
-    auto pTreeItem = static_cast<CMultiProjectModel::TreeItem*>(itemIndex.internalPointer());
-    assert(pTreeItem);
-    auto wrapIndex = pModel->wrappedIndex(pTreeItem, pTreeItem->m_pModel, itemIndex);
-
-    ProjectTreeItem* pItem = static_cast<ProjectTreeItem*>(wrapIndex.internalPointer());
-    if(pItem && pItem->getTypeId() == TreeItemType::IMAGE)
-    {
-        auto pDataset = CProjectUtils::getDataset<CMat>(wrapIndex);
-        if(pDataset)
-        {
-            size_t index = CProjectUtils::getIndexInDataset(wrapIndex);
-            QString path = QString::fromStdString(pDataset->at(index)->getFileName());
-            QPixmap pixmap = Utils::Image::loadPixmap(path, size);
-
-            // creating a new transparent pixmap with equal sides
-            auto rounded = Utils::Image::createRoundedPixmap(pixmap);
-
-            auto pImageItem = pItem->getNode<std::shared_ptr<CImageItem>>();
-            if(pImageItem)
-                pImageItem->setIconPixmap(rounded);
-        }
-    }
-}
-
 CProjectViewProxyModel::CProjectViewProxyModel(QObject* parent) : QSortFilterProxyModel{parent}
 {
+    m_pThumbnails = new CThumbnailStore(QSize(150,150), this);
     connect(this, &CProjectViewProxyModel::doCreateIcon, this, &CProjectViewProxyModel::onCreateIcon);
+    connect(m_pThumbnails, &CThumbnailStore::doThumbnailReady, this, &CProjectViewProxyModel::onThumbnailReady);
 }
 
 QVariant CProjectViewProxyModel::data(const QModelIndex& index, int role) const
@@ -82,13 +55,19 @@ QVariant CProjectViewProxyModel::data(const QModelIndex& index, int role) const
         if(pItem)
         {
             auto ic = QIcon(pItem->getIconPixmap());
-            if(ic.isNull())
+            if(ic.isNull() == false)
+                return ic;
+
+            if(pItem->getTypeId() == TreeItemType::IMAGE)
+            {
+                //Default icon as placeholder until the thumbnail is ready
+                requestThumbnail(srcIndex, wrapIndex);
+            }
+            else
             {
                 QPersistentModelIndex pIndex{srcIndex};
                 emit doCreateIcon(pIndex, QSize(150,150));
             }
-            else
-                return ic;
         }
     }
     return QSortFilterProxyModel::data(index, role);
@@ -106,25 +85,9 @@ void CProjectViewProxyModel::onCreateIcon(const QPersistentModelIndex& index, QS
     auto wrapIndex = pModel->wrappedIndex(pTreeItem, pTreeItem->m_pModel, index);
     ProjectTreeItem* pItem = static_cast<ProjectTreeItem*>(wrapIndex.internalPointer());
 
-    // To avoid reentrant thread, we set the imageItem default icon with the chosen default icon
+    // Items without thumbnail: rounded default icon of their type
     switch(pItem->getTypeId())
     {
-        case TreeItemType::IMAGE:
-        {
-            auto pImageItem = pItem->getNode<std::shared_ptr<CImageItem>>();
-            assert(pImageItem != nullptr);
-            QIcon icon = qvariant_cast<QIcon>(wrapIndex.data(Qt::DecorationRole));
-
-            if(!icon.isNull())
-            {
-                QIcon ic = qvariant_cast<QIcon>(wrapIndex.data(Qt::DecorationRole));
-                QPixmap pixmap =  ic.pixmap(size);
-                // creating a new transparent pixmap with equal sides
-                auto rounded = Utils::Image::createRoundedPixmap(pixmap);
-                pImageItem->setIconPixmap(rounded);
-            }
-            break;
-        }
         case TreeItemType::PROJECT:
         {
             auto pProjectItem = pItem->getNode<std::shared_ptr<CProjectItem>>();
@@ -186,20 +149,62 @@ void CProjectViewProxyModel::onCreateIcon(const QPersistentModelIndex& index, QS
             break;
         }
     }
-    QtConcurrent::run([this, index, size]
-    //Utils::async([this, index, size]
+}
+
+void CProjectViewProxyModel::onThumbnailReady(const QString &path, const QImage &thumbnail)
+{
+    auto indexes = m_pendingThumbnails.values(path);
+    m_pendingThumbnails.remove(path);
+
+    // creating a new transparent pixmap with equal sides
+    auto rounded = Utils::Image::createRoundedPixmap(QPixmap::fromImage(thumbnail));
+
+    for(auto&& index : indexes)
     {
-        try
+        if(!index.isValid())
+            continue;
+
+        auto pModel = static_cast<const CMultiProjectModel*>(index.model());
+        auto pTreeItem = static_cast<CMultiProjectModel::TreeItem*>(index.internalPointer());
+        auto wrapIndex = pModel->wrappedIndex(pTreeItem, pTreeItem->m_pModel, index);
+        ProjectTreeItem* pItem = static_cast<ProjectTreeItem*>(wrapIndex.internalPointer());
+
+        if(pItem && pItem->getTypeId() == TreeItemType::IMAGE)
         {
-            createIcon(index, size);
-            emit dataChanged(index, index, QVector<int>{Qt::DecorationRole});
+            auto pImageItem = pItem->getNode<std::shared_ptr<CImageItem>>();
+            if(pImageItem)
+                pImageItem->setIconPixmap(rounded);
+
+            auto proxyIndex = mapFromSource(index);
+            if(proxyIndex.isValid())
+                emit dataChanged(proxyIndex, proxyIndex, QVector<int>{Qt::DecorationRole});
         }
-        catch(std::exception& e)
+    }
+}
+
+void CProjectViewProxyModel::requestThumbnail(const QModelIndex &srcIndex, const QModelIndex &wrapIndex) const
+{
+    try
+    {
+        auto pDataset = CProjectUtils::getDataset<CMat>(wrapIndex);
+        if(pDataset)
         {
-            //Nothing has to be done if icon is not created
-            qCWarning(logProject).noquote() << QString::fromStdString(e.what());
+            size_t index = CProjectUtils::getIndexInDataset(wrapIndex);
+            QString path = QString::fromStdString(pDataset->at(index)->getFileName());
+            QPersistentModelIndex persistentIndex(srcIndex);
+
+            if(m_pendingThumbnails.contains(path, persistentIndex) == false)
+                m_pendingThumbnails.insert(path, persistentIndex);
+
+            //Called on each paint of visible items: they are served first
+            m_pThumbnails->request(path);
         }
-    });
+    }
+    catch(std::exception& e)
+    {
+        //Nothing has to be done if icon is not created
+        qCWarning(logProject).noquote() << QString::fromStdString(e.what());
+    }
 }
 
 #include "moc_CProjectViewProxyModel.cpp"
@@ -31,6 +31,8 @@
 
 #include <QSortFilterProxyModel>
 
+class CThumbnailStore;
+
 /**
  * @brief
  *
@@ -63,10 +65,18 @@ class CProjectViewProxyModel : public QSortFilterProxyModel
     public slots:
 
         void        onCreateIcon(const QPersistentModelIndex& index, QSize size);
+        void        onThumbnailReady(const QString& path, const QImage& thumbnail);
+
+    private:
+
+        void        requestThumbnail(const QModelIndex& srcIndex, const QModelIndex& wrapIndex) const;
 
     private:
 
         QMap<QString, QIcon> m_iconMap; /**< TODO: describe */
+        CThumbnailStore*    m_pThumbnails = nullptr;
+        //Source indexes waiting for their thumbnail, by image path
+        mutable QMultiHash<QString, QPersistentModelIndex>  m_pendingThumbnails;
 };
 
 #endif // CDATALISTVIEWPROXYMODEL_H
@@ -0,0 +1,205 @@
+// Copyright (C) 2021 Ikomia SAS
+// Contact: https://www.ikomia.com
+//
+// This file is part of the IkomiaStudio software.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#include "CMeasureColumns.h"
+#include <QDataStream>
+#include <algorithm>
+#include <map>
+
+CMeasureColumns::CMeasureColumns()
+{
+}
+
+CMeasureColumns CMeasureColumns::fromMeasures(const ObjectsMeasures &measures)
+{
+    CMeasureColumns columns;
+    const size_t objectCount = measures.size();
+
+    // Column order: first appearance of each measure name
+    std::map<std::string, size_t> columnIndices;
+    std::vector<std::vector<const CObjectMeasure*>> cells;
+
+    std::vector<quint64> objectIds(objectCount, 0);
+    for(size_t i=0; i<objectCount; ++i)
+    {
+        for(size_t j=0; j<measures[i].size(); ++j)
+        {
+            const CObjectMeasure& objMeasure = measures[i][j];
+            std::string name = objMeasure.m_measure.m_name.empty() ? CMeasure::getName(objMeasure.m_measure.m_id) : objMeasure.m_measure.m_name;
+            auto it = columnIndices.find(name);
+
+            if(it == columnIndices.end())
+            {
+                it = columnIndices.insert(std::make_pair(name, columns.m_columns.size())).first;
+                Column column;
+                column.m_measureId = static_cast<int>(objMeasure.m_measure.m_id);
+                column.m_name = QString::fromStdString(name);
+                columns.m_columns.push_back(column);
+                cells.push_back(std::vector<const CObjectMeasure*>(objectCount, nullptr));
+            }
+            cells[it->second][i] = &objMeasure;
+
+            if(j == 0)
+            {
+                objectIds[i] = static_cast<quint64>(objMeasure.m_graphicsId);
+                columns.m_labels.push_back(QString::fromStdString(objMeasure.m_label));
+            }
+        }
+
+        if(measures[i].empty())
+            columns.m_labels.push_back(QString());
+    }
+    columns.m_objectIds = QByteArray(reinterpret_cast<const char*>(objectIds.data()), static_cast<int>(objectCount * sizeof(quint64)));
+
+    for(size_t c=0; c<columns.m_columns.size(); ++c)
+    {
+        // Offsets are only needed if at least one object has not exactly one value
+        bool bSingleValue = std::all_of(cells[c].begin(), cells[c].end(), [](const CObjectMeasure* pCell){ return pCell && pCell->m_values.size() == 1; });
+        std::vector<double> values;
+        std::vector<quint32> offsets;
+        values.reserve(objectCount);
+
+        if(bSingleValue == false)
+            offsets.push_back(0);
+
+        for(size_t i=0; i<objectCount; ++i)
+        {
+            if(cells[c][i])
+                values.insert(values.end(), cells[c][i]->m_values.begin(), cells[c][i]->m_values.end());
+
+            if(bSingleValue == false)
+                offsets.push_back(static_cast<quint32>(values.size()));
+        }
+        columns.m_columns[c].m_values = QByteArray(reinterpret_cast<const char*>(values.data()), static_cast<int>(values.size() * sizeof(double)));
+
+        if(bSingleValue == false)
+            columns.m_columns[c].m_offsets = QByteArray(reinterpret_cast<const char*>(offsets.data()), static_cast<int>(offsets.size() * sizeof(quint32)));
+    }
+    return columns;
+}
+
+ObjectsMeasures CMeasureColumns::toMeasures() const
+{
+    const size_t objectCount = getObjectCount();
+    ObjectsMeasures measures(objectCount);
+
+    for(size_t i=0; i<objectCount; ++i)
+    {
+        const size_t objectId = static_cast<size_t>(getObjectId(i));
+        const std::string label = getLabel(i).toStdString();
+        measures[i].reserve(m_columns.size());
+
+        for(size_t c=0; c<m_columns.size(); ++c)
+        {
+            size_t count = 0;
+            const double* pValues = getValues(c, i, count);
+            if(count == 0)
+                continue;
+
+            CObjectMeasure objMeasure;
+            objMeasure.m_measure.m_id = static_cast<CMeasure::Id>(m_columns[c].m_measureId);
+            objMeasure.m_measure.m_name = m_columns[c].m_name.toStdString();
+            objMeasure.m_values.assign(pValues, pValues + count);
+            objMeasure.m_graphicsId = objectId;
+            objMeasure.m_label = label;
+            measures[i].push_back(std::move(objMeasure));
+        }
+    }
+    return measures;
+}
+
+size_t CMeasureColumns::getObjectCount() const
+{
+    return static_cast<size_t>(m_objectIds.size()) / sizeof(quint64);
+}
+
+size_t CMeasureColumns::getColumnCount() const
+{
+    return m_columns.size();
+}
+
+const CMeasureColumns::Column &CMeasureColumns::getColumn(size_t index) const
+{
+    assert(index < m_columns.size());
+    return m_columns[index];
+}
+
+quint64 CMeasureColumns::getObjectId(size_t row) const
+{
+    assert(row < getObjectCount());
+    return reinterpret_cast<const quint64*>(m_objectIds.constData())[row];
+}
+
+QString CMeasureColumns::getLabel(size_t row) const
+{
+    if(row < static_cast<size_t>(m_labels.size()))
+        return m_labels[static_cast<int>(row)];
+    else
+        return QString();
+}
+
+const double *CMeasureColumns::getValues(size_t col, size_t row, size_t &count) const
+{
+    assert(col < m_columns.size());
+    const Column& column = m_columns[col];
+    const double* pValues = reinterpret_cast<const double*>(column.m_values.constData());
+
+    const size_t valueCount = static_cast<size_t>(column.m_values.size()) / sizeof(double);
+
+    if(column.m_offsets.isEmpty())
+    {
+        count = row < valueCount ? 1 : 0;
+        return pValues + row;
+    }
+
+    const quint32* pOffsets = reinterpret_cast<const quint32*>(column.m_offsets.constData());
+    const size_t offsetCount = static_cast<size_t>(column.m_offsets.size()) / sizeof(quint32);
+
+    if(row + 1 >= offsetCount || pOffsets[row + 1] > valueCount || pOffsets[row] > pOffsets[row + 1])
+    {
+        count = 0;
+        return pValues;
+    }
+    count = pOffsets[row + 1] - pOffsets[row];
+    return pValues + pOffsets[row];
+}
+
+QByteArray CMeasureColumns::getObjectIds() const
+{
+    return m_objectIds;
+}
+
+QByteArray CMeasureColumns::getLabels() const
+{
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream << m_labels;
+    return data;
+}
+
+void CMeasureColumns::setObjects(const QByteArray &objectIds, const QByteArray &labels)
+{
+    m_objectIds = objectIds;
+    m_labels.clear();
+    QDataStream stream(labels);
+    stream >> m_labels;
+}
+
+void CMeasureColumns::addColumn(const Column &column)
+{
+    m_columns.push_back(column);
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2021 Ikomia SAS
+ * Contact: https://www.ikomia.com
+ *
+ * This file is part of the IkomiaStudio software.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef CMEASURECOLUMNS_H
+#define CMEASURECOLUMNS_H
+
+#include <QByteArray>
+#include <QStringList>
+#include "IO/CBlobMeasureIO.h"
+
+//----------------------------------//
+//----- Class CMeasureColumns -----//
+//----------------------------------//
+/**
+ * @brief Columnar layout of blob measures: one object column (graphics ids and labels)
+ * and one typed column per measure. Values are stored as raw double arrays, with an optional offset
+ * array (n+1 uint32) when objects have several values for a measure. This is the layout stored in the
+ * project database and read directly by CMeasuresTableModel.
+ */
+class CMeasureColumns
+{
+    public:
+
+        struct Column
+        {
+            int         m_measureId = 0;
+            QString     m_name;
+            QByteArray  m_values;
+            QByteArray  m_offsets;
+        };
+
+        CMeasureColumns();
+
+        static CMeasureColumns  fromMeasures(const ObjectsMeasures& measures);
+
+        ObjectsMeasures         toMeasures() const;
+
+        size_t                  getObjectCount() const;
+        size_t                  getColumnCount() const;
+        const Column&           getColumn(size_t index) const;
+        quint64                 getObjectId(size_t row) const;
+        QString                 getLabel(size_t row) const;
+        const double*           getValues(size_t col, size_t row, size_t& count) const;
+        QByteArray              getObjectIds() const;
+        QByteArray              getLabels() const;
+
+        void                    setObjects(const QByteArray& objectIds, const QByteArray& labels);
+
+        void                    addColumn(const Column& column);
+
+    private:
+
+        QByteArray              m_objectIds;
+        QStringList             m_labels;
+        std::vector<Column>     m_columns;
+};
+
+#endif // CMEASURECOLUMNS_H
@@ -70,7 +70,7 @@ void CResultDbManager::save(std::shared_ptr<ProjectTreeItem> itemPtr, int dbId)
             updateProjectId(currentDbId, dbId);
         }
         auto type = static_cast<int>(pResultItem->getNodeType());
-        m_mapTypes.insert(itemPtr->getId(), type);
+        m_mapTypes.insert(dbId, type);
         pResultItem->notifyItemSaved(dbId);
     }
 }
@@ -81,6 +81,9 @@ void CResultDbManager::batchSave()
     if(db.isValid() == false)
         throw CException(DatabaseExCode::INVALID_QUERY, "Invalid database connection", __func__, __FILE__, __LINE__);
 
+    if(m_bIncremental == true)
+        removeRows("result", "itemId", m_mapTypes.keys().toVector().toStdVector());
+
     QSqlQuery q(db);
     if(!q.prepare(QString("INSERT INTO result (itemId, resultType) values (?, ?)")))
         throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
@@ -101,44 +104,49 @@ void CResultDbManager::setMeasures(const ObjectsMeasures &measures, int resultDb
     if(db.isValid() == false)
         throw CException(DatabaseExCode::INVALID_QUERY, "Invalid database connection", __func__, __FILE__, __LINE__);
 
+    // One row for the object column and one binary row per measure column
+    auto columns = CMeasureColumns::fromMeasures(measures);
+
     QSqlQuery q(db);
-    QVariantList measureIds, measureNames, values, valuesList, blobIds, labels, projectResIds;
-    q.prepare("INSERT INTO measures (measureId, measureName, value, valueList, blobId, label, projectResultId) VALUES (?, ?, ?, ?, ?, ?, ?);");
+    if(!q.prepare("INSERT INTO measureObjects (projectResultId, objectCount, objectIds, labels) VALUES (?, ?, ?, ?);"))
+        throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
 
-    for(size_t i=0; i<measures.size(); ++i)
-    {
-        for(size_t j=0; j<measures[i].size(); ++j)
-        {
-            measureIds << static_cast<int>(measures[i][j].m_measure.m_id);
+    q.addBindValue(resultDbId);
+    q.addBindValue(static_cast<int>(columns.getObjectCount()));
+    q.addBindValue(columns.getObjectIds());
+    q.addBindValue(columns.getLabels());
 
-            if(measures[i][j].m_measure.m_name.empty() == true)
-                measureNames << QString::fromStdString(CMeasure::getName(measures[i][j].m_measure.m_id));
-            else
-                measureNames << QString::fromStdString(measures[i][j].m_measure.m_name);
+    if(!q.exec())
+        throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
 
-            if(measures[i][j].m_values.size() == 1)
-            {
-                values << measures[i][j].m_values[0];
-                valuesList << QVariant(QVariant::String);
-            }
-            else
-            {
-                values << QVariant(QVariant::Double);
-                valuesList << encodeValues(measures[i][j].m_values);
-            }
-            blobIds << static_cast<int>(measures[i][j].m_graphicsId);
-            labels << QString::fromStdString(measures[i][j].m_label);
-            projectResIds << static_cast<int>(resultDbId);
-        }
+    if(columns.getColumnCount() == 0)
+        return;
+
+    if(!q.prepare("INSERT INTO measureColumns (projectResultId, columnIndex, measureId, measureName, valueData, offsetData) VALUES (?, ?, ?, ?, ?, ?);"))
+        throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+
+    QVariantList projectResIds, columnIndices, measureIds, measureNames, valueData, offsetData;
+    for(size_t i=0; i<columns.getColumnCount(); ++i)
+    {
+        const auto& column = columns.getColumn(i);
+        projectResIds << resultDbId;
+        columnIndices << static_cast<int>(i);
+        measureIds << column.m_measureId;
+        measureNames << column.m_name;
+        valueData << column.m_values;
+
+        if(column.m_offsets.isEmpty())
+            offsetData << QVariant(QVariant::ByteArray);
+        else
+            offsetData << column.m_offsets;
     }
 
+    q.addBindValue(projectResIds);
+    q.addBindValue(columnIndices);
     q.addBindValue(measureIds);
     q.addBindValue(measureNames);
-    q.addBindValue(values);
-    q.addBindValue(valuesList);
-    q.addBindValue(blobIds);
-    q.addBindValue(labels);
-    q.addBindValue(projectResIds);
+    q.addBindValue(valueData);
+    q.addBindValue(offsetData);
 
     if(!q.execBatch())
         throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
@@ -146,64 +154,24 @@ void CResultDbManager::setMeasures(const ObjectsMeasures &measures, int resultDb
 
 ObjectsMeasures CResultDbManager::getMeasures(int resultId)
 {
-    auto db = connectDB();
-    if(db.isValid() == false)
-        throw CException(DatabaseExCode::INVALID_QUERY, "Invalid database connection", __func__, __FILE__, __LINE__);
-
-    QSqlQuery q(db);
-    if(!q.exec(QString("SELECT measureId, measureName, value, valueList, blobId, label FROM measures WHERE projectResultId=%1 ORDER BY blobId;").arg(resultId)))
-        throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
-
-    ObjectsMeasures measures;
-    if(q.first())
-    {
-        auto nbMeasures = getMeasureCount(db, resultId);
-        auto nbObjects = Utils::Database::getQuerySize(q) / nbMeasures;
-
-        for(int i=0; i<nbObjects; ++i)
-        {
-            ObjectMeasures objMeasures;
-            for(int j=0; j<nbMeasures; ++j)
-            {
-                CObjectMeasure objMeasure;
-                objMeasure.m_measure.m_id = static_cast<CMeasure::Id>(q.value("measureId").toInt());
-                objMeasure.m_measure.m_name = q.value("measureName").toString().toStdString();
-                objMeasure.m_graphicsId = static_cast<size_t>(q.value("blobId").toInt());
-                objMeasure.m_label = q.value("label").toString().toStdString();
-
-                auto singleValue = q.value("value");
-                if(singleValue.isNull() == false)
-                    objMeasure.m_values.push_back(singleValue.toDouble());
-                else
-                    objMeasure.m_values = decodeValues(q.value("valueList").toString());
-
-                objMeasures.push_back(objMeasure);
-                q.next();
-            }
-            measures.push_back(objMeasures);
-        }
-    }
-    return measures;
+    return getMeasureColumns(resultId).toMeasures();
 }
 
 CMeasuresTableModel *CResultDbManager::createMeasureModel(int resultId)
 {
-    auto db = connectDB();
-    if(!db.isValid())
-        throw CException(DatabaseExCode::INVALID_QUERY, "Invalid database connection", __func__, __FILE__, __LINE__);
-
-    auto names = getMeasureNames(db, resultId);
-    auto strQuery = buildMeasureQuery(resultId, names);
-    auto pModel = new CMeasuresTableModel(nullptr);
-    pModel->setQuery(strQuery, db);
-    pModel->setHeaderData(0, Qt::Horizontal, QObject::tr("Id"));
-    pModel->setHeaderData(1, Qt::Horizontal, QObject::tr("Object"));
-    pModel->setHeaderData(2, Qt::Horizontal, QObject::tr("Category"));
+    return createMeasureModel(getMeasureColumns(resultId));
+}
 
-    int index = 3;
-    for(int i=0; i<names.size(); ++i)
-        pModel->setHeaderData(index++, Qt::Horizontal, names[i]);
+CMeasuresTableModel *CResultDbManager::createMeasureModel(const ObjectsMeasures &measures)
+{
+    return createMeasureModel(CMeasureColumns::fromMeasures(measures));
+}
 
+CMeasuresTableModel *CResultDbManager::createMeasureModel(const CMeasureColumns &columns)
+{
+    //Table view reads values directly from column buffers
+    auto pModel = new CMeasuresTableModel(nullptr);
+    pModel->setColumns(columns);
     return pModel;
 }
 
@@ -217,29 +185,30 @@ void CResultDbManager::updateProjectId(int oldId, int newId)
     if(!q.exec(QString("UPDATE result SET itemId=%1 WHERE itemId=%2").arg(newId).arg(oldId)))
         throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
 
-    if(!q.exec(QString("UPDATE measures SET projectResultId=%1 WHERE projectResultId=%2").arg(newId).arg(oldId)))
-       throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+    QStringList measureTables = {"measureObjects", "measureColumns", "measures"};
+    QStringList tables = db.tables(QSql::Tables);
+
+    for(int i=0; i<measureTables.size(); ++i)
+    {
+        if(tables.contains(measureTables[i]) == false)
+            continue;
+
+        if(!q.exec(QString("UPDATE %1 SET projectResultId=%2 WHERE projectResultId=%3").arg(measureTables[i]).arg(newId).arg(oldId)))
+           throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+    }
 }
 
 void CResultDbManager::remove(std::vector<int> resultIds)
 {
-    auto db = connectDB();
-    if(!db.isValid())
-        throw CException(DatabaseExCode::INVALID_QUERY, "Invalid database connection", __func__, __FILE__, __LINE__);
-
-    //Delete result items which id is in vector resultIds in table "results"
-    QString whereCondition;
-    for(size_t i=0; i<resultIds.size(); ++i)
-    {
-        if(i == resultIds.size() - 1)
-            whereCondition += QString("projectResultId=%1;").arg(resultIds[i]);
-        else
-            whereCondition += QString("projectResultId=%1 OR ").arg(resultIds[i]);
-    }
+    removeRows("measureObjects", "projectResultId", resultIds);
+    removeRows("measureColumns", "projectResultId", resultIds);
+    removeRows("measures", "projectResultId", resultIds);
+}
 
-    QSqlQuery q(db);
-    if(!q.exec(QString("DELETE FROM measures WHERE ") + whereCondition))
-       throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+void CResultDbManager::removeItems(const std::vector<int>& dbIds)
+{
+    removeRows("result", "itemId", dbIds);
+    remove(dbIds);
 }
 
 void CResultDbManager::initMemoryDB()
@@ -253,21 +222,17 @@ void CResultDbManager::initMemoryDB()
 
     QSqlQuery q(db);
     QStringList tables = db.tables(QSql::Tables);
+    QStringList measureTables = {"measureObjects", "measureColumns"};
 
-    //Table results -> contient toutes les mesures calculées par une tâche d'un protocole
-    if(tables.contains("measures") == false)
-    {
-        if(!q.exec("CREATE TABLE measures (id INTEGER PRIMARY KEY, measureId INTEGER, measureName TEXT, value REAL, valueList TEXT, blobId INTEGER, label TEXT, projectResultId INTEGER);"))
-            throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
-    }
-    else
+    for(int i=0; i<measureTables.size(); ++i)
     {
-        if(!q.exec("DROP TABLE measures;"))
-            throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
-
-        if(!q.exec("CREATE TABLE measures (id INTEGER PRIMARY KEY, measureId INTEGER, measureName TEXT, value REAL, valueList TEXT, blobId INTEGER, label TEXT, projectResultId INTEGER);"))
-            throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+        if(tables.contains(measureTables[i]))
+        {
+            if(!q.exec(QString("DROP TABLE %1;").arg(measureTables[i])))
+                throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+        }
     }
+    createMeasureTables(q, QStringList());
 }
 
 QSqlDatabase CResultDbManager::connectDB()
@@ -286,86 +251,122 @@ void CResultDbManager::createTables()
         QSqlQuery q(db);
         QStringList tables = db.tables(QSql::Tables);
 
-        if(tables.contains("result"))
+        if(isTableReusable(tables, "result") == false)
         {
-           if(!q.exec(QString("DROP TABLE result")))
-               throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
-        }
-
-        if(!q.exec("CREATE TABLE result (id INTEGER PRIMARY KEY, itemId INTEGER, resultType INTEGER);"))
-           throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+            if(tables.contains("result"))
+            {
+               if(!q.exec(QString("DROP TABLE result")))
+                   throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+            }
 
-        //Table results -> contient toutes les mesures calculées par une tâche d'un protocole
-        if(tables.contains("measures") == false)
-        {
-           if(!q.exec("CREATE TABLE measures (id INTEGER PRIMARY KEY, measureId INTEGER, measureName TEXT, value REAL, valueList TEXT, blobId INTEGER, label TEXT, projectResultId INTEGER);"))
+            if(!q.exec("CREATE TABLE result (id INTEGER PRIMARY KEY, itemId INTEGER, resultType INTEGER);"))
                throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
         }
 
+        createMeasureTables(q, tables);
         m_bTablesCreated = true;
     }
 }
 
-int CResultDbManager::getMeasureCount(const QSqlDatabase &db, int resultId)
+void CResultDbManager::createMeasureTables(QSqlQuery &q, const QStringList &tables)
 {
-    if(!db.isValid())
-        return 0;
+    //Measures computed by a workflow task, stored by column:
+    //- measureObjects: graphics ids and labels of objects (one row per result)
+    //- measureColumns: one binary array of values per measure (one row per result and measure)
+    if(tables.contains("measureObjects") == false)
+    {
+        if(!q.exec("CREATE TABLE measureObjects (id INTEGER PRIMARY KEY, projectResultId INTEGER, objectCount INTEGER, objectIds BLOB, labels BLOB);"))
+            throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
 
-    QSqlQuery q(db);
-    if(!q.exec(QString("SELECT COUNT(measureName) FROM measures WHERE projectResultId=%1;").arg(resultId)))
-        throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+        if(!q.exec("CREATE INDEX measureObjectsIndex ON measureObjects (projectResultId);"))
+            throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+    }
 
-    if(q.first())
-        return q.value(0).toInt();
-    else
-        return 0;
+    if(tables.contains("measureColumns") == false)
+    {
+        if(!q.exec("CREATE TABLE measureColumns (id INTEGER PRIMARY KEY, projectResultId INTEGER, columnIndex INTEGER, measureId INTEGER, measureName TEXT, valueData BLOB, offsetData BLOB);"))
+            throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+
+        if(!q.exec("CREATE INDEX measureColumnsIndex ON measureColumns (projectResultId);"))
+            throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+    }
 }
 
-QVector<QString> CResultDbManager::getMeasureNames(const QSqlDatabase &db, int resultId)
+CMeasureColumns CResultDbManager::getMeasureColumns(int resultId)
 {
-    if(!db.isValid())
-        return QVector<QString>();
+    auto db = connectDB();
+    if(db.isValid() == false)
+        throw CException(DatabaseExCode::INVALID_QUERY, "Invalid database connection", __func__, __FILE__, __LINE__);
 
+    CMeasureColumns columns;
+    QStringList tables = db.tables(QSql::Tables);
     QSqlQuery q(db);
-    if(!q.exec(QString("SELECT DISTINCT measureName FROM measures WHERE projectResultId=%1;").arg(resultId)))
-        throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
 
-    QVector<QString> names;
-    while(q.next())
-        names.push_back(q.value(0).toString());
+    bool bColumnar = tables.contains("measureObjects");
+    if(bColumnar)
+    {
+        if(!q.exec(QString("SELECT objectIds, labels FROM measureObjects WHERE projectResultId=%1;").arg(resultId)))
+            throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
 
-    return names;
-}
+        bColumnar = q.first();
+    }
 
-QString CResultDbManager::buildMeasureQuery(int resultId, const QVector<QString> &measureNames)
-{
-    QString strQuery = "SELECT id, blobId, label";
+    if(bColumnar == false)
+    {
+        //Results saved with the previous row layout (one row per object and measure)
+        if(tables.contains("measures"))
+            columns = CMeasureColumns::fromMeasures(getLegacyMeasures(db, resultId));
 
-    for(int i=0; i<measureNames.size(); ++i)
+        return columns;
+    }
+    columns.setObjects(q.value(0).toByteArray(), q.value(1).toByteArray());
+
+    if(!q.exec(QString("SELECT measureId, measureName, valueData, offsetData FROM measureColumns WHERE projectResultId=%1 ORDER BY columnIndex;").arg(resultId)))
+        throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+
+    while(q.next())
     {
-        strQuery += ",";
-        QString measureNameNoSpace = measureNames[i];
-        measureNameNoSpace.remove(' ');
-        strQuery += QString("MAX(CASE WHEN (measureName='%1' AND value is not null) THEN value\
-                                      WHEN (measureName='%1' AND valueList is not null) THEN valueList\
-                                 END) AS %2").arg(measureNames[i]).arg(measureNameNoSpace);
+        CMeasureColumns::Column column;
+        column.m_measureId = q.value(0).toInt();
+        column.m_name = q.value(1).toString();
+        column.m_values = q.value(2).toByteArray();
+        column.m_offsets = q.value(3).toByteArray();
+        columns.addColumn(column);
     }
-    strQuery += QString(" FROM measures WHERE projectResultId=%1 GROUP BY blobId;").arg(resultId);
-    return strQuery;
+    return columns;
 }
 
-QString CResultDbManager::encodeValues(const std::vector<double> &values)
+ObjectsMeasures CResultDbManager::getLegacyMeasures(const QSqlDatabase &db, int resultId)
 {
-    QString strValues;
+    QSqlQuery q(db);
+    if(!q.exec(QString("SELECT measureId, measureName, value, valueList, blobId, label FROM measures WHERE projectResultId=%1 ORDER BY blobId, id;").arg(resultId)))
+        throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
 
-    for(size_t i=0; i<values.size(); ++i)
+    ObjectsMeasures measures;
+    int currentBlobId = -1;
+
+    while(q.next())
     {
-        if(strValues.isEmpty() == false)
-            strValues += ";";
+        CObjectMeasure objMeasure;
+        objMeasure.m_measure.m_id = static_cast<CMeasure::Id>(q.value(0).toInt());
+        objMeasure.m_measure.m_name = q.value(1).toString().toStdString();
+        objMeasure.m_graphicsId = static_cast<size_t>(q.value(4).toInt());
+        objMeasure.m_label = q.value(5).toString().toStdString();
+
+        auto singleValue = q.value(2);
+        if(singleValue.isNull() == false)
+            objMeasure.m_values.push_back(singleValue.toDouble());
+        else
+            objMeasure.m_values = decodeValues(q.value(3).toString());
 
-        strValues += QString::number(values[i]);
+        if(measures.empty() || q.value(4).toInt() != currentBlobId)
+        {
+            currentBlobId = q.value(4).toInt();
+            measures.push_back(ObjectMeasures());
+        }
+        measures.back().push_back(objMeasure);
     }
-    return strValues;
+    return measures;
 }
 
 std::vector<double> CResultDbManager::decodeValues(const QString& strValues)
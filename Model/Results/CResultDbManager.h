@@ -26,6 +26,7 @@
 #include "Model/Data/CMeasuresTableModel.h"
 #include "Main/CoreDefine.hpp"
 #include "IO/CBlobMeasureIO.h"
+#include "CMeasureColumns.h"
 
 //----------------------------------//
 //----- Class CResultDBManager -----//
@@ -42,13 +43,18 @@ class CResultDbManager : public CProjectItemBaseDbMgr
         std::shared_ptr<CItem>  load(const QSqlQuery& q, QModelIndex& previousIndex) override;
         void                    save(std::shared_ptr<ProjectTreeItem> itemPtr, int dbId) override;
         void                    batchSave() override;
+        void                    removeItems(const std::vector<int>& dbIds) override;
 
         void                    setMeasures(const ObjectsMeasures& measures, int resultDbId=-1);
 
         ObjectsMeasures         getMeasures(int resultId=-1);
+        CMeasureColumns         getMeasureColumns(int resultId=-1);
 
         CMeasuresTableModel*    createMeasureModel(int resultId=-1);
 
+        static CMeasuresTableModel* createMeasureModel(const ObjectsMeasures& measures);
+        static CMeasuresTableModel* createMeasureModel(const CMeasureColumns& columns);
+
         void                    remove(std::vector<int> resultIds);
 
     private:
@@ -58,15 +64,12 @@ class CResultDbManager : public CProjectItemBaseDbMgr
         QSqlDatabase            connectDB();
 
         void                    createTables();
+        void                    createMeasureTables(QSqlQuery& q, const QStringList& tables);
 
-        int                     getMeasureCount(const QSqlDatabase& db, int resultId);
-        QVector<QString>        getMeasureNames(const QSqlDatabase& db, int resultId);
+        ObjectsMeasures         getLegacyMeasures(const QSqlDatabase& db, int resultId);
 
         void                    updateProjectId(int oldId, int newId);
 
-        QString                 buildMeasureQuery(int resultId, const QVector<QString> &measureNames);
-
-        QString                 encodeValues(const std::vector<double>& values);
         std::vector<double>     decodeValues(const QString &strValues);
 
         void                    loadTypes();
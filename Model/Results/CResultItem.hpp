@@ -59,11 +59,13 @@ class CResultItem : public CItem
         void            setNodeType(NodeType type)
         {
             m_nodeType = type;
+            m_bModified = true;
         }
         void            setMeasures(const ObjectsMeasures& measures)
         {
             m_measures = measures;
             m_bLoaded = true;
+            m_bModified = true;
         }
 
         TreeItemType    getTypeId() const override
@@ -32,11 +32,13 @@
 #include "Model/Project/CProjectManager.h"
 #include "Model/Workflow/CWorkflowManager.h"
 #include "Model/Graphics/CGraphicsManager.h"
+#include "Model/Graphics/CGraphicsBurner.h"
 #include "Model/Results/CResultItem.hpp"
 #include "Model/Render/CRenderManager.h"
 #include "Model/Data/CMainDataManager.h"
 #include "Model/Data/CFeaturesTableModel.h"
 #include "Model/Data/CMultiImageModel.h"
+#include "Model/Data/Image/CDisplayConversion.h"
 #include <QMessageBox>
 #include "Graphics/CPoint.hpp"
 
@@ -110,7 +112,7 @@ void CResultManager::setCurrentOutputImage(const QModelIndex& index)
             {
                 pOut->setCurrentImage(currentImgIndex);
                 //Emit signal to display result
-                emit doDisplayImage(volumeIndex++, CDataConversion::CMatToQImage(pOut->getImage()), QString::fromStdString(pTask->getName()), pTask->getOutputViewProperty(i));
+                emit doDisplayImage(volumeIndex++, CDisplayConversion::toQImage(pOut->getImage()), QString::fromStdString(pTask->getName()), pTask->getOutputViewProperty(i));
             }
         }
     }
@@ -989,12 +991,12 @@ void CResultManager::manageImageOutput(const WorkflowTaskIOPtr &pOutput, const s
         image = pOut->getImage();
 
     //Emit signal to display result
-    emit doDisplayImage(index, CDataConversion::CMatToQImage(image), QString::fromStdString(taskName), pViewProp);
+    emit doDisplayImage(index, CDisplayConversion::toQImage(image), QString::fromStdString(taskName), pViewProp);
 
     //Emit signal to display overlay binary
     if(pOut->isOverlayAvailable() == true)
     {
-        emit doDisplayOverlay(CDataConversion::CMatToQImage(pOut->getOverlayMask()), index, DisplayType::IMAGE_DISPLAY);
+        emit doDisplayOverlay(CDisplayConversion::toQImage(pOut->getOverlayMask()), index, DisplayType::IMAGE_DISPLAY);
         m_bImageOverlay = true;
     }
 }
@@ -1024,7 +1026,7 @@ void CResultManager::manageVolumeOutput(const WorkflowTaskIOPtr &outputPtr, cons
         pOut->setCurrentImage(currentImgIndex);
 
         //Emit signal to display result
-        emit doDisplayImage(index, CDataConversion::CMatToQImage(pOut->getImage()), QString::fromStdString(taskName), pViewProp);
+        emit doDisplayImage(index, CDisplayConversion::toQImage(pOut->getImage()), QString::fromStdString(taskName), pViewProp);
 
         //Update 3D scene rendering, only for first 3D output
         if(index == 0)
@@ -1076,9 +1078,7 @@ void CResultManager::manageBlobOutput(const WorkflowTaskIOPtr &pOutput, const st
 
     try
     {
-        CResultDbManager resultDb;
-        resultDb.setMeasures(pOut->getMeasures());
-        auto pModel = resultDb.createMeasureModel();
+        auto pModel = CResultDbManager::createMeasureModel(pOut->getMeasures());
         m_tableModels.push_back(pModel);
         emit doDisplayMeasuresTable(index, QString::fromStdString(taskName), pModel, pViewProp);
     }
@@ -1159,8 +1159,8 @@ void CResultManager::manageVideoOutput(const WorkflowTaskPtr &taskPtr, const Wor
         qCCritical(logVideo).noquote() << QString::fromStdString(e.what());
     }
 
-    //Emit signal to display result
-    emit doDisplayVideo(index, CDataConversion::CMatToQImage(image), QString::fromStdString(taskPtr->getName()), videoInputIndices, pViewProp);
+    //Emit signal to display result: frame buffers are reused by the workflow, display needs a copy
+    emit doDisplayVideo(index, CDisplayConversion::toQImage(image, false), QString::fromStdString(taskPtr->getName()), videoInputIndices, pViewProp);
     //Get source video info
     auto videoInfoPtr = m_pDataMgr->getVideoMgr()->getVideoInfo(m_pWorkflowMgr->getCurrentVideoInputModelIndex());
     auto srcType = m_pDataMgr->getVideoMgr()->getSourceType(m_pWorkflowMgr->getCurrentVideoInputModelIndex());
@@ -1183,7 +1183,7 @@ void CResultManager::manageVideoOutput(const WorkflowTaskPtr &taskPtr, const Wor
     //Emit signal to display overlay binary
     if(pOut->isOverlayAvailable() == true)
     {
-        emit doDisplayOverlay(CDataConversion::CMatToQImage(pOut->getOverlayMask()), index, DisplayType::VIDEO_DISPLAY);
+        emit doDisplayOverlay(CDisplayConversion::toQImage(pOut->getOverlayMask(), false), index, DisplayType::VIDEO_DISPLAY);
         m_bImageOverlay = true;
     }
 }
@@ -1229,9 +1229,11 @@ void CResultManager::manageVideoRecord(const WorkflowTaskPtr &taskPtr, size_t in
                 auto graphicsOutPtr = std::static_pointer_cast<CGraphicsOutput>(graphicsOutputs[i]);
                 if(graphicsOutPtr->getImageIndex() == (int)index)
                 {
-                    CGraphicsConversion graphicsConv((int)tmp.getNbCols(), (int)tmp.getNbRows());
+                    CGraphicsBurner burner;
                     for(auto it : graphicsOutPtr->getItems())
-                        it->insertToImage(tmp, graphicsConv, false, false, true);
+                        burner.add(it);
+
+                    burner.burn(tmp, true);
                 }
             }
         }
@@ -1632,16 +1634,17 @@ void CResultManager::loadResults(const QModelIndex &index)
     {
         if(pResultItem->isLoaded())
         {
-            CResultDbManager resultDB;
-            resultDB.setMeasures(pResultItem->getMeasures());
-            m_tableModels.push_back(resultDB.createMeasureModel());
+            m_tableModels.push_back(CResultDbManager::createMeasureModel(pResultItem->getMeasures()));
         }
         else
         {
             CProjectDbManager projectDB(m_pProjectMgr->getModel(index));
             CResultDbManager resultDB(projectDB.getPath(), projectDB.getConnectionName());
-            pResultItem->setMeasures(resultDB.getMeasures(pResultItem->getDbId()));
-            m_tableModels.push_back(resultDB.createMeasureModel(pResultItem->getDbId()));
+            auto columns = resultDB.getMeasureColumns(pResultItem->getDbId());
+            pResultItem->setMeasures(columns.toMeasures());
+            //Measures come from the project file: nothing to write back
+            pResultItem->setModified(false);
+            m_tableModels.push_back(CResultDbManager::createMeasureModel(columns));
         }
 
         //Prepare view according to output data types
@@ -39,6 +39,9 @@ void CSettingsManager::notifyViewShow()
     initTutorialHelperOption();
     initNativeDialogOption();
     initWorkflowOption();
+    initBatchOption();
+    initWorkflowCacheOption();
+    initImageCacheOption();
 }
 
 std::string CSettingsManager::getWorkflowSaveFolder() const
@@ -46,6 +49,31 @@ std::string CSettingsManager::getWorkflowSaveFolder() const
     return m_protocolSaveFolder;
 }
 
+size_t CSettingsManager::getBatchWorkerCount() const
+{
+    return m_batchWorkerCount;
+}
+
+size_t CSettingsManager::getBatchPrefetchDepth() const
+{
+    return m_batchPrefetchDepth;
+}
+
+size_t CSettingsManager::getBatchPrefetchMemory() const
+{
+    return m_batchPrefetchMemory;
+}
+
+size_t CSettingsManager::getWorkflowCacheMemory() const
+{
+    return m_workflowCacheMemory;
+}
+
+size_t CSettingsManager::getImageCacheMemory() const
+{
+    return m_imageCacheMemory;
+}
+
 void CSettingsManager::initNativeDialogOption()
 {
     QJsonObject json = getSettings("useNative");
@@ -82,6 +110,42 @@ void CSettingsManager::initWorkflowOption()
     emit doSetWorkflowSaveFolder(QString::fromStdString(m_protocolSaveFolder));
 }
 
+void CSettingsManager::initBatchOption()
+{
+    QJsonObject json = getSettings("batch");
+    if(!json.empty())
+    {
+        m_batchWorkerCount = (size_t)std::max(0, json["workers"].toInt());
+
+        if(json.contains("prefetchDepth"))
+            m_batchPrefetchDepth = (size_t)std::max(0, json["prefetchDepth"].toInt());
+
+        if(json.contains("prefetchMemory"))
+            m_batchPrefetchMemory = (size_t)std::max(0, json["prefetchMemory"].toInt());
+    }
+
+    emit doSetBatchWorkerCount((int)m_batchWorkerCount);
+    emit doSetBatchPrefetch((int)m_batchPrefetchDepth, (int)m_batchPrefetchMemory);
+}
+
+void CSettingsManager::initWorkflowCacheOption()
+{
+    QJsonObject json = getSettings("workflowCache");
+    if(!json.empty())
+        m_workflowCacheMemory = (size_t)std::max(0, json["memory"].toInt());
+
+    emit doSetWorkflowCacheMemory((int)m_workflowCacheMemory);
+}
+
+void CSettingsManager::initImageCacheOption()
+{
+    QJsonObject json = getSettings("imageCache");
+    if(!json.empty())
+        m_imageCacheMemory = (size_t)std::max(0, json["memory"].toInt());
+
+    emit doSetImageCacheMemory((int)m_imageCacheMemory);
+}
+
 void CSettingsManager::setSettings(const QString &category, const QJsonObject& jsonData)
 {
     QJsonDocument jsonDoc(jsonData);
@@ -205,3 +269,43 @@ void CSettingsManager::onSetWorkflowSaveFolder(const QString &path)
     json["saveFolder"] = path;
     setSettings("protocol", json);
 }
+
+void CSettingsManager::saveBatchSettings()
+{
+    QJsonObject json;
+    json["workers"] = (int)m_batchWorkerCount;
+    json["prefetchDepth"] = (int)m_batchPrefetchDepth;
+    json["prefetchMemory"] = (int)m_batchPrefetchMemory;
+    setSettings("batch", json);
+}
+
+void CSettingsManager::onSetBatchWorkerCount(int count)
+{
+    m_batchWorkerCount = (size_t)std::max(0, count);
+    saveBatchSettings();
+}
+
+void CSettingsManager::onSetBatchPrefetch(int depth, int memory)
+{
+    m_batchPrefetchDepth = (size_t)std::max(0, depth);
+    m_batchPrefetchMemory = (size_t)std::max(0, memory);
+    saveBatchSettings();
+}
+
+void CSettingsManager::onSetWorkflowCacheMemory(int memory)
+{
+    m_workflowCacheMemory = (size_t)std::max(0, memory);
+
+    QJsonObject json;
+    json["memory"] = memory;
+    setSettings("workflowCache", json);
+}
+
+void CSettingsManager::onSetImageCacheMemory(int memory)
+{
+    m_imageCacheMemory = (size_t)std::max(0, memory);
+
+    QJsonObject json;
+    json["memory"] = memory;
+    setSettings("imageCache", json);
+}
@@ -39,6 +39,11 @@ class CSettingsManager : public QObject
         void        notifyViewShow();
 
         std::string getWorkflowSaveFolder() const;
+        size_t      getBatchWorkerCount() const;
+        size_t      getBatchPrefetchDepth() const;
+        size_t      getBatchPrefetchMemory() const;
+        size_t      getWorkflowCacheMemory() const;
+        size_t      getImageCacheMemory() const;
 
         bool        isNativeDlgEnabled() const;
         bool        isTutorialEnabled() const;
@@ -52,12 +57,20 @@ class CSettingsManager : public QObject
         void        doEnableNativeDialog(bool bEnable);
         void        doEnableTutorialHelper(bool bEnable);
         void        doSetWorkflowSaveFolder(const QString& path);
+        void        doSetBatchWorkerCount(int count);
+        void        doSetBatchPrefetch(int depth, int memory);
+        void        doSetWorkflowCacheMemory(int memory);
+        void        doSetImageCacheMemory(int memory);
 
     public slots:
 
         void        onUseNativeDlg(bool bEnable);
         void        onEnableTutorialHelper(bool bEnable);
         void        onSetWorkflowSaveFolder(const QString& path);
+        void        onSetBatchWorkerCount(int count);
+        void        onSetBatchPrefetch(int depth, int memory);
+        void        onSetWorkflowCacheMemory(int memory);
+        void        onSetImageCacheMemory(int memory);
 
     private:
 
@@ -65,10 +78,14 @@ class CSettingsManager : public QObject
         void        initNativeDialogOption();
         void        initTutorialHelperOption();
         void        initWorkflowOption();
+        void        initBatchOption();
+        void        initWorkflowCacheOption();
+        void        initImageCacheOption();
 
         void        setSettings(const QString& category, const QJsonObject &jsonData);
         void        setUseNativeDlg(bool bEnable);
         void        setTutoEnabled(bool bEnable);
+        void        saveBatchSettings();
 
         static void setDialogOptions(QFileDialog::Options options);
 
@@ -82,6 +99,15 @@ class CSettingsManager : public QObject
         bool            m_bUseNativeDlg = false;
         bool            m_bShowTuto = true;
         std::string     m_protocolSaveFolder;
+        // 0 means one worker per core
+        size_t          m_batchWorkerCount = 0;
+        // Read-ahead in batch items (0 disables prefetch) and memory cap in MB (0: no cap)
+        size_t          m_batchPrefetchDepth = 4;
+        size_t          m_batchPrefetchMemory = 1024;
+        // Task output cache of interactive runs in MB (0 disables it)
+        size_t          m_workflowCacheMemory = 1024;
+        // Decoded image cache in MB (0 disables it)
+        size_t          m_imageCacheMemory = 1024;
 };
 
 #endif // CSETTINGSMANAGER_H
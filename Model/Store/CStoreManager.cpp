@@ -28,7 +28,7 @@
 #include "Model/Process/CProcessManager.h"
 #include "Model/Plugin/CPluginManager.h"
 #include "Model/ProgressBar/CProgressBarManager.h"
-#include "JlCompress.h"
+#include "CZipArchive.h"
 #include "Core/CIkomiaRegistry.h"
 
 CStoreManager::CStoreManager()
@@ -43,6 +43,15 @@ CStoreManager::CStoreManager()
     }
 }
 
+CStoreManager::~CStoreManager()
+{
+    //Stop pending compression/extraction
+    if(m_archivePtr)
+        m_archivePtr->cancel();
+
+    m_archiveFuture.waitForFinished();
+}
+
 void CStoreManager::setManagers(QNetworkAccessManager *pNetworkMgr, CProcessManager *pProcessMgr, CPluginManager *pPluginMgr, CProgressBarManager *pProgressMgr)
 {
     m_pNetworkMgr = pNetworkMgr;
@@ -222,8 +231,6 @@ void CStoreManager::onPublishPluginDone()
 
 void CStoreManager::onPluginCompressionDone(const QString& zipFile)
 {
-    m_pProgressMgr->endInfiniteProgress();
-
     try
     {
         if(zipFile.isEmpty())
@@ -813,7 +820,17 @@ void CStoreManager::checkPendingUpdates()
         }
 
         //Extract new plugin content
-        auto extractedFiles = JlCompress::extractDir(zipPath, QString::fromStdString(destDir));
+        QStringList extractedFiles;
+        try
+        {
+            CZipArchive archive;
+            extractedFiles = archive.extractDir(zipPath, QString::fromStdString(destDir));
+        }
+        catch(std::exception& e)
+        {
+            qCCritical(logStore).noquote() << QString::fromStdString(e.what());
+        }
+
         if(extractedFiles.size() == 0)
             qCCritical(logStore).noquote() << tr("Archive extraction failed: installation of %1 aborted").arg(QString::fromStdString(dirName));
 
@@ -989,27 +1006,42 @@ void CStoreManager::generateZipFile()
         return;
     }
 
-    m_pProgressMgr->launchInfiniteProgress(tr("Plugin compression..."), false);
+    m_pProgressMgr->launchProgress(&m_progressSignal, 100, tr("Plugin compression..."), false);
+    m_archivePtr = createArchive(tr("Compressing plugin"));
+    auto archivePtr = m_archivePtr;
 
-    QFutureWatcher<bool>* pWatcher = new QFutureWatcher<bool>;
+    QFutureWatcher<bool>* pWatcher = new QFutureWatcher<bool>(this);
     connect(pWatcher, &QFutureWatcher<bool>::finished, [this, pWatcher, zipFilePath]
     {
+        emit m_progressSignal.doFinish();
         bool bCompress = pWatcher->result();
         QString zipFile = (bCompress == true ? zipFilePath : QString());
+        pWatcher->deleteLater();
         onPluginCompressionDone(zipFile);
     });
 
-    //Compress plugin into separate thread
-    auto future = QtConcurrent::run([zipFilePath, pluginDir]
+    //Compress plugin into separate threads
+    auto future = QtConcurrent::run([archivePtr, zipFilePath, pluginDir]
     {
-        return JlCompress::compressDir(zipFilePath, pluginDir, true);
+        try
+        {
+            return archivePtr->compressDir(zipFilePath, pluginDir);
+        }
+        catch(std::exception& e)
+        {
+            qCCritical(logStore).noquote() << QString::fromStdString(e.what());
+            return false;
+        }
     });
+    m_archiveFuture = future;
     pWatcher->setFuture(future);
 }
 
 void CStoreManager::extractZipFile(const QString& src, const QString& dstDir)
 {
-    m_pProgressMgr->launchInfiniteProgress(tr("Plugin extraction..."), false);
+    m_pProgressMgr->launchProgress(&m_progressSignal, 100, tr("Plugin extraction..."), false);
+    m_archivePtr = createArchive(tr("Extracting plugin"));
+    auto archivePtr = m_archivePtr;
 
     QFutureWatcher<QStringList>* pWatcher = new QFutureWatcher<QStringList>(this);
     connect(pWatcher, &QFutureWatcher<bool>::finished, [this, pWatcher, src, dstDir]
@@ -1018,19 +1050,54 @@ void CStoreManager::extractZipFile(const QString& src, const QString& dstDir)
         QFile file(src);
         file.remove();
 
-        m_pProgressMgr->endInfiniteProgress();
+        emit m_progressSignal.doFinish();
         QStringList files = pWatcher->result();
+        pWatcher->deleteLater();
         onPluginExtractionDone(files, dstDir);
     });
 
-    //Extract plugin into separate thread
-    auto future = QtConcurrent::run([src, dstDir]
+    //Extract plugin into separate threads
+    auto future = QtConcurrent::run([archivePtr, src, dstDir]
     {
-        return JlCompress::extractDir(src, dstDir);
+        try
+        {
+            return archivePtr->extractDir(src, dstDir);
+        }
+        catch(std::exception& e)
+        {
+            qCCritical(logStore).noquote() << QString::fromStdString(e.what());
+            return QStringList();
+        }
     });
+    m_archiveFuture = future;
     pWatcher->setFuture(future);
 }
 
+void CStoreManager::onCancelArchive()
+{
+    //Pending compression or extraction stops at the next chunk
+    if(m_archivePtr)
+        m_archivePtr->cancel();
+}
+
+std::shared_ptr<CZipArchive> CStoreManager::createArchive(const QString& msg)
+{
+    auto archivePtr = std::make_shared<CZipArchive>();
+    archivePtr->setProgressCallback([this, msg](qint64 done, qint64 total)
+    {
+        if(total <= 0)
+            return;
+
+        //Progress ends with doFinish
+        const float factor = 1024.0*1024.0;
+        QString doneMb = QString::number(done / factor, 'f', 1);
+        QString totalMb = QString::number(total / factor, 'f', 1);
+        emit m_progressSignal.doSetMessage(QString("%1: %2 Mb / %3 Mb").arg(msg).arg(doneMb).arg(totalMb));
+        emit m_progressSignal.doSetValue(std::min(99, (int)(done * 100 / total)));
+    });
+    return archivePtr;
+}
+
 void CStoreManager::publishPluginToServer()
 {
     assert(m_pNetworkMgr);
@@ -22,6 +22,7 @@
 #define CSTOREMANAGER_H
 
 #include <QObject>
+#include <QFuture>
 #include <QtNetwork/QNetworkAccessManager>
 #include "CStoreDbManager.h"
 #include "Model/Store/CStoreQueryModel.h"
@@ -31,6 +32,7 @@ class QNetworkAccessManager;
 class CProcessManager;
 class CPluginManager;
 class CProgressBarManager;
+class CZipArchive;
 
 class CStoreManager : public QObject
 {
@@ -49,6 +51,7 @@ class CStoreManager : public QObject
     public:
 
         CStoreManager();
+        ~CStoreManager();
 
         void            setManagers(QNetworkAccessManager *pNetworkMgr, CProcessManager* pProcessMgr, CPluginManager* pPluginMgr, CProgressBarManager *pProgressMgr);
         void            setCurrentUser(const CUser& user);
@@ -69,6 +72,7 @@ class CStoreManager : public QObject
         void            onUpdatePluginInfo(bool bFullEdit, const CTaskInfo& info);
         void            onServerSearchChanged(const QString& text);
         void            onLocalSearchChanged(const QString& text);
+        void            onCancelArchive();
 
     private slots:
 
@@ -108,6 +112,8 @@ class CStoreManager : public QObject
         void            generateZipFile();
         void            extractZipFile(const QString &src, const QString &dstDir);
 
+        std::shared_ptr<CZipArchive> createArchive(const QString& msg);
+
         void            publishPluginToServer();
 
         void            uploadPluginPackage();
@@ -138,6 +144,8 @@ class CStoreManager : public QObject
         CStoreQueryModel*           m_pServerPluginModel = nullptr;
         CStoreQueryModel*           m_pLocalPluginModel = nullptr;
         QFile*                      m_pTranferFile = nullptr;
+        std::shared_ptr<CZipArchive> m_archivePtr;
+        QFuture<void>               m_archiveFuture;
         QModelIndex                 m_currentServerIndex = QModelIndex();
         QModelIndex                 m_currentLocalIndex = QModelIndex();
         CUser                       m_currentUser;
@@ -0,0 +1,410 @@
+// Copyright (C) 2021 Ikomia SAS
+// Contact: https://www.ikomia.com
+//
+// This file is part of the IkomiaStudio software.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "CZipArchive.h"
+#include <QDir>
+#include <QDirIterator>
+#include <QDateTime>
+#include <QThread>
+#include <QtConcurrent/QtConcurrent>
+#include <mutex>
+#include <numeric>
+#include "quazip.h"
+#include "quazipfile.h"
+
+CZipArchive::CZipArchive()
+{
+}
+
+void CZipArchive::setProgressCallback(const CZipArchive::ProgressCallback &callback)
+{
+    m_progressCallback = callback;
+}
+
+void CZipArchive::cancel()
+{
+    m_bCancel = true;
+}
+
+bool CZipArchive::isCancelled() const
+{
+    return m_bCancel;
+}
+
+bool CZipArchive::compressDir(const QString &zipPath, const QString &dir)
+{
+    QDir rootDir(dir);
+    if(rootDir.exists() == false)
+        throw CException(CoreExCode::INVALID_FILE, QObject::tr("Folder %1 does not exist").arg(dir).toStdString(), __func__, __FILE__, __LINE__);
+
+    //Entries relative to the root folder
+    QStringList dirs, files;
+    std::vector<QFileInfo> fileInfos;
+    m_total = 0;
+    m_done = 0;
+
+    //Hidden entries (.git, .env, .venv...) are not packaged
+    QDirIterator itEntry(dir, QDir::AllEntries | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+    while(itEntry.hasNext())
+    {
+        itEntry.next();
+        QFileInfo info = itEntry.fileInfo();
+
+        if(info.isDir())
+            dirs << rootDir.relativeFilePath(info.absoluteFilePath()) + "/";
+        else if(info.isFile())
+        {
+            files << rootDir.relativeFilePath(info.absoluteFilePath());
+            fileInfos.push_back(info);
+            m_total += info.size();
+        }
+    }
+
+    QuaZip zip(zipPath);
+    if(!zip.open(QuaZip::mdCreate))
+        throw CException(CoreExCode::CREATE_FAILED, QObject::tr("Unable to create archive %1").arg(zipPath).toStdString(), __func__, __FILE__, __LINE__);
+
+    zipFile zf = zip.getZipFile();
+    QTextCodec* pCodec = zip.getFileNameCodec();
+
+    auto openEntry = [&](const QString& name, const QDateTime& date, int method, int level, bool bRaw, bool bZip64)
+    {
+        zip_fileinfo zi;
+        memset(&zi, 0, sizeof(zi));
+        zi.tmz_date.tm_sec = date.time().second();
+        zi.tmz_date.tm_min = date.time().minute();
+        zi.tmz_date.tm_hour = date.time().hour();
+        zi.tmz_date.tm_mday = date.date().day();
+        zi.tmz_date.tm_mon = date.date().month() - 1;
+        zi.tmz_date.tm_year = date.date().year();
+
+        QByteArray encodedName = pCodec->fromUnicode(name);
+        if(zipOpenNewFileInZip3_64(zf, encodedName.constData(), &zi, nullptr, 0, nullptr, 0, nullptr,
+                                   method, level, bRaw ? 1 : 0, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY, nullptr, 0, bZip64 ? 1 : 0) != ZIP_OK)
+        {
+            throw CException(CoreExCode::CREATE_FAILED, QObject::tr("Unable to add %1 to archive").arg(name).toStdString(), __func__, __FILE__, __LINE__);
+        }
+    };
+
+    try
+    {
+        for(auto&& dirName : dirs)
+        {
+            openEntry(dirName, QFileInfo(rootDir.absoluteFilePath(dirName)).lastModified(), 0, 0, false, false);
+            zipCloseFileInZip(zf);
+        }
+
+        //Chunks of several files are read then deflated in parallel, and written in order
+        const int maxWindowChunks = std::max(1, QThread::idealThreadCount()) * 4;
+        const qint64 maxWindowBytes = (qint64)maxWindowChunks * m_chunkSize;
+        int fileIndex = 0;
+        int entryIndex = -1;
+        quint32 entryCrc = 0;
+        qint64 entrySize = 0;
+        QFile file;
+        QByteArray dictionary;
+
+        while(fileIndex < files.size())
+        {
+            if(isCancelled())
+            {
+                zip.close();
+                QFile::remove(zipPath);
+                return false;
+            }
+
+            std::vector<CChunk> window;
+            qint64 windowBytes = 0;
+
+            while((int)window.size() < maxWindowChunks && windowBytes < maxWindowBytes && fileIndex < files.size())
+            {
+                if(file.isOpen() == false)
+                {
+                    file.setFileName(fileInfos[fileIndex].absoluteFilePath());
+                    if(!file.open(QIODevice::ReadOnly))
+                        throw CException(CoreExCode::INVALID_FILE, QObject::tr("Unable to read %1").arg(file.fileName()).toStdString(), __func__, __FILE__, __LINE__);
+
+                    dictionary.clear();
+                }
+
+                CChunk chunk;
+                chunk.m_fileIndex = fileIndex;
+                chunk.m_data = file.read(m_chunkSize);
+
+                if(file.error() != QFileDevice::NoError)
+                    throw CException(CoreExCode::INVALID_FILE, file.errorString().toStdString(), __func__, __FILE__, __LINE__);
+
+                //Previous chunk as dictionary: same compression ratio as a single stream
+                chunk.m_dictionary = dictionary;
+                chunk.m_bLast = file.atEnd();
+                dictionary = chunk.m_data.right(32768);
+                windowBytes += chunk.m_data.size();
+                window.push_back(std::move(chunk));
+
+                if(window.back().m_bLast)
+                {
+                    file.close();
+                    fileIndex++;
+                }
+            }
+
+            QtConcurrent::blockingMap(window, [this](CChunk& chunk){ deflateChunk(chunk); });
+
+            for(auto&& chunk : window)
+            {
+                if(chunk.m_bValid == false)
+                    throw CException(CoreExCode::CREATE_FAILED, QObject::tr("Compression of %1 failed").arg(files[chunk.m_fileIndex]).toStdString(), __func__, __FILE__, __LINE__);
+
+                if(chunk.m_fileIndex != entryIndex)
+                {
+                    const QFileInfo& info = fileInfos[chunk.m_fileIndex];
+                    openEntry(files[chunk.m_fileIndex], info.lastModified(), Z_DEFLATED, m_level, true, info.size() >= 0xffffffff);
+                    entryIndex = chunk.m_fileIndex;
+                    entryCrc = 0;
+                    entrySize = 0;
+                }
+
+                if(zipWriteInFileInZip(zf, chunk.m_compressed.constData(), (unsigned int)chunk.m_compressed.size()) != ZIP_OK)
+                    throw CException(CoreExCode::CREATE_FAILED, QObject::tr("Unable to write archive %1").arg(zipPath).toStdString(), __func__, __FILE__, __LINE__);
+
+                entryCrc = crc32_combine(entryCrc, chunk.m_crc, chunk.m_data.size());
+                entrySize += chunk.m_data.size();
+                m_done += chunk.m_data.size();
+
+                if(chunk.m_bLast)
+                {
+                    zipCloseFileInZipRaw64(zf, (ZPOS64_T)entrySize, entryCrc);
+                    entryIndex = -1;
+                }
+            }
+            notifyProgress();
+        }
+
+        zip.close();
+        if(zip.getZipError() != ZIP_OK)
+            throw CException(CoreExCode::CREATE_FAILED, QObject::tr("Unable to write archive %1").arg(zipPath).toStdString(), __func__, __FILE__, __LINE__);
+    }
+    catch(std::exception& e)
+    {
+        zip.close();
+        QFile::remove(zipPath);
+        throw;
+    }
+    return true;
+}
+
+QStringList CZipArchive::extractDir(const QString &zipPath, const QString &dstDir)
+{
+    QuaZip zip(zipPath);
+    if(!zip.open(QuaZip::mdUnzip))
+        throw CException(CoreExCode::INVALID_FILE, QObject::tr("Unable to open archive %1").arg(zipPath).toStdString(), __func__, __FILE__, __LINE__);
+
+    QList<QuaZipFileInfo64> infos = zip.getFileInfoList64();
+    zip.close();
+
+    QDir dir(dstDir);
+    dir.mkpath(".");
+    QString rootPath = QDir::cleanPath(dir.absolutePath()) + "/";
+    m_total = 0;
+    m_done = 0;
+
+    //Folders are created first, entries can't be written outside the destination folder
+    for(auto&& info : infos)
+    {
+        QString path = QDir::cleanPath(dir.absoluteFilePath(info.name));
+        if((path + "/").startsWith(rootPath) == false)
+            throw CException(CoreExCode::INVALID_FILE, QObject::tr("Invalid archive entry: %1").arg(info.name).toStdString(), __func__, __FILE__, __LINE__);
+
+        if(info.name.endsWith("/"))
+            dir.mkpath(path);
+        else
+            dir.mkpath(QFileInfo(path).absolutePath());
+
+        m_total += (qint64)info.uncompressedSize;
+    }
+
+    //Largest entries first, each one to the least loaded reader
+    int threadCount = std::max(1, std::min(QThread::idealThreadCount(), infos.size()));
+    std::vector<int> order(infos.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&infos](int i1, int i2)
+    {
+        return infos[i1].uncompressedSize > infos[i2].uncompressedSize;
+    });
+
+    std::vector<std::vector<char>> masks(threadCount, std::vector<char>(infos.size(), 0));
+    std::vector<qint64> loads(threadCount, 0);
+
+    for(auto index : order)
+    {
+        auto itMin = std::min_element(loads.begin(), loads.end());
+        masks[itMin - loads.begin()][index] = 1;
+        *itMin += (qint64)infos[index].uncompressedSize;
+    }
+
+    std::vector<QStringList> fileLists(threadCount);
+    std::vector<QFuture<void>> futures;
+    std::mutex mutex;
+    QString error;
+
+    //Dedicated readers: caller may itself run in the global pool
+    QThreadPool pool;
+    pool.setMaxThreadCount(threadCount);
+
+    for(int worker=0; worker<threadCount; ++worker)
+    {
+        futures.push_back(QtConcurrent::run(&pool, [&, worker]
+        {
+            try
+            {
+                extractEntries(zipPath, dstDir, masks[worker], fileLists[worker]);
+            }
+            catch(std::exception& e)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                error = QString::fromStdString(e.what());
+                //Stop other readers
+                m_bCancel = true;
+            }
+        }));
+    }
+
+    while(pool.waitForDone(100) == false)
+        notifyProgress();
+
+    notifyProgress();
+
+    QStringList files;
+    for(auto&& fileList : fileLists)
+        files << fileList;
+
+    if(error.isEmpty() == false || isCancelled())
+    {
+        for(auto&& file : files)
+            QFile::remove(file);
+
+        if(error.isEmpty() == false)
+            throw CException(CoreExCode::INVALID_FILE, error.toStdString(), __func__, __FILE__, __LINE__);
+
+        return QStringList();
+    }
+    return files;
+}
+
+void CZipArchive::deflateChunk(CZipArchive::CChunk &chunk) const
+{
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+
+    if(deflateInit2(&stream, m_level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+        return;
+
+    if(chunk.m_dictionary.isEmpty() == false)
+        deflateSetDictionary(&stream, (const Bytef*)chunk.m_dictionary.constData(), (uInt)chunk.m_dictionary.size());
+
+    //Sync flush block included
+    uLong bound = deflateBound(&stream, (uLong)chunk.m_data.size()) + 16;
+    chunk.m_compressed.resize((int)bound);
+
+    stream.next_in = (Bytef*)chunk.m_data.data();
+    stream.avail_in = (uInt)chunk.m_data.size();
+    stream.next_out = (Bytef*)chunk.m_compressed.data();
+    stream.avail_out = (uInt)bound;
+
+    //Sync flush: byte-aligned end without final block, chunks of a file can be concatenated
+    int ret = deflate(&stream, chunk.m_bLast ? Z_FINISH : Z_SYNC_FLUSH);
+
+    if(chunk.m_bLast)
+        chunk.m_bValid = (ret == Z_STREAM_END);
+    else
+        chunk.m_bValid = (ret == Z_OK && stream.avail_in == 0 && stream.avail_out > 0);
+
+    chunk.m_compressed.resize((int)(bound - stream.avail_out));
+    chunk.m_crc = crc32(0L, (const Bytef*)chunk.m_data.constData(), (uInt)chunk.m_data.size());
+    chunk.m_dictionary.clear();
+    deflateEnd(&stream);
+}
+
+void CZipArchive::extractEntries(const QString &zipPath, const QString &dstDir, const std::vector<char> &mask, QStringList &files)
+{
+    //One reader per thread
+    QuaZip zip(zipPath);
+    if(!zip.open(QuaZip::mdUnzip))
+        throw CException(CoreExCode::INVALID_FILE, QObject::tr("Unable to open archive %1").arg(zipPath).toStdString(), __func__, __FILE__, __LINE__);
+
+    QDir dir(dstDir);
+    QByteArray buffer(m_chunkSize, 0);
+    size_t index = 0;
+
+    for(bool bMore=zip.goToFirstFile(); bMore && isCancelled() == false; bMore=zip.goToNextFile(), ++index)
+    {
+        if(index >= mask.size() || mask[index] == 0)
+            continue;
+
+        QuaZipFileInfo64 info;
+        if(!zip.getCurrentFileInfo(&info))
+            throw CException(CoreExCode::INVALID_FILE, QObject::tr("Invalid archive %1").arg(zipPath).toStdString(), __func__, __FILE__, __LINE__);
+
+        QString path = QDir::cleanPath(dir.absoluteFilePath(info.name));
+        if(info.name.endsWith("/"))
+        {
+            files << path;
+            continue;
+        }
+
+        QuaZipFile in(&zip);
+        if(!in.open(QIODevice::ReadOnly))
+            throw CException(CoreExCode::INVALID_FILE, QObject::tr("Unable to read %1 from archive").arg(info.name).toStdString(), __func__, __FILE__, __LINE__);
+
+        QFile out(path);
+        if(!out.open(QIODevice::WriteOnly))
+            throw CException(CoreExCode::CREATE_FAILED, QObject::tr("Unable to write %1").arg(path).toStdString(), __func__, __FILE__, __LINE__);
+
+        files << path;
+        while(isCancelled() == false)
+        {
+            qint64 size = in.read(buffer.data(), buffer.size());
+            if(size < 0)
+                throw CException(CoreExCode::INVALID_FILE, QObject::tr("Unable to read %1 from archive").arg(info.name).toStdString(), __func__, __FILE__, __LINE__);
+
+            if(size == 0)
+                break;
+
+            if(out.write(buffer.constData(), size) != size)
+                throw CException(CoreExCode::CREATE_FAILED, QObject::tr("Unable to write %1").arg(path).toStdString(), __func__, __FILE__, __LINE__);
+
+            m_done += size;
+        }
+        out.close();
+
+        //CRC is checked when the entry is closed
+        in.close();
+        if(isCancelled() == false && in.getZipError() != UNZ_OK)
+            throw CException(CoreExCode::INVALID_FILE, QObject::tr("Corrupted archive entry: %1").arg(info.name).toStdString(), __func__, __FILE__, __LINE__);
+
+        QFile::Permissions permissions = info.getPermissions();
+        if(permissions != 0)
+            out.setPermissions(permissions);
+    }
+}
+
+void CZipArchive::notifyProgress()
+{
+    if(m_progressCallback)
+        m_progressCallback(m_done, m_total);
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2021 Ikomia SAS
+ * Contact: https://www.ikomia.com
+ *
+ * This file is part of the IkomiaStudio software.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CZIPARCHIVE_H
+#define CZIPARCHIVE_H
+
+#include <QString>
+#include <QStringList>
+#include <atomic>
+#include <functional>
+
+// Zip archive engine for plugin packages.
+// Files are streamed by chunks: compression deflates chunks in parallel (chunks of a file
+// are chained with sync flush) and extraction writes entries directly to their destination,
+// one archive reader per thread. Progress is reported in uncompressed bytes and both
+// operations stop at the next chunk when cancelled.
+class CZipArchive
+{
+    public:
+
+        // Called from worker threads
+        using ProgressCallback = std::function<void(qint64 done, qint64 total)>;
+
+        CZipArchive();
+
+        void        setProgressCallback(const ProgressCallback& callback);
+
+        // Thread-safe
+        void        cancel();
+        bool        isCancelled() const;
+
+        // Return false if cancelled, throw on error
+        bool        compressDir(const QString& zipPath, const QString& dir);
+        // Return extracted files (empty if cancelled), throw on error
+        QStringList extractDir(const QString& zipPath, const QString& dstDir);
+
+    private:
+
+        struct CChunk
+        {
+            int         m_fileIndex = -1;
+            QByteArray  m_data;
+            QByteArray  m_dictionary;
+            QByteArray  m_compressed;
+            quint32     m_crc = 0;
+            bool        m_bLast = false;
+            bool        m_bValid = false;
+        };
+
+        void        deflateChunk(CChunk& chunk) const;
+        void        extractEntries(const QString& zipPath, const QString& dstDir, const std::vector<char>& mask, QStringList& files);
+        void        notifyProgress();
+
+    private:
+
+        const int               m_chunkSize = 1024 * 1024;
+        const int               m_level = 6;
+        ProgressCallback        m_progressCallback;
+        std::atomic<bool>       m_bCancel{false};
+        std::atomic<qint64>     m_done{0};
+        qint64                  m_total = 0;
+};
+
+#endif // CZIPARCHIVE_H
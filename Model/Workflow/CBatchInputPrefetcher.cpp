@@ -0,0 +1,166 @@
+// Copyright (C) 2021 Ikomia SAS
+// Contact: https://www.ikomia.com
+//
+// This file is part of the IkomiaStudio software.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "CBatchInputPrefetcher.h"
+#include <QtConcurrent/QtConcurrent>
+#include "IO/CImageIO.h"
+
+CBatchInputPrefetcher::CBatchInputPrefetcher()
+{
+    m_pool.setMaxThreadCount(1);
+}
+
+CBatchInputPrefetcher::~CBatchInputPrefetcher()
+{
+    stop();
+}
+
+bool CBatchInputPrefetcher::isActive() const
+{
+    return m_state == State::ACTIVE;
+}
+
+bool CBatchInputPrefetcher::isStopped() const
+{
+    return m_state == State::STOPPED;
+}
+
+void CBatchInputPrefetcher::start(const LoadFunc &loadFunc, size_t count, size_t depth, size_t maxMemory)
+{
+    stop();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_loadFunc = loadFunc;
+    m_count = count;
+    m_depth = std::max<size_t>(depth, 1);
+    m_maxMemory = maxMemory;
+    m_memory = 0;
+    m_lowestPending = 0;
+    m_items.clear();
+    m_taken.assign(count, false);
+    m_state = State::ACTIVE;
+    m_future = QtConcurrent::run(&m_pool, [this]{ run(); });
+}
+
+void CBatchInputPrefetcher::cancel()
+{
+    // Not started: nothing to cancel, callers keep loading inline
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        State state = State::ACTIVE;
+        m_state.compare_exchange_strong(state, State::STOPPED);
+    }
+    m_cond.notify_all();
+}
+
+void CBatchInputPrefetcher::stop()
+{
+    cancel();
+    m_future.waitForFinished();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_items.clear();
+    m_taken.clear();
+    m_memory = 0;
+    m_state = State::IDLE;
+}
+
+bool CBatchInputPrefetcher::take(size_t index, BatchInputs &inputs)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cond.wait(lock, [this, index]{ return m_state != State::ACTIVE || m_items.find(index) != m_items.end(); });
+
+    if(m_state != State::ACTIVE)
+        return false;
+
+    auto it = m_items.find(index);
+    CBatchItem item = std::move(it->second);
+    m_items.erase(it);
+    m_memory -= item.m_memory;
+    m_taken[index] = true;
+
+    while(m_lowestPending < m_count && m_taken[m_lowestPending])
+        m_lowestPending++;
+
+    lock.unlock();
+    m_cond.notify_all();
+
+    if(item.m_error)
+        std::rethrow_exception(item.m_error);
+
+    inputs = std::move(item.m_inputs);
+    return true;
+}
+
+void CBatchInputPrefetcher::run()
+{
+    for(size_t i=0; i<m_count && m_state == State::ACTIVE; ++i)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cond.wait(lock, [this, i]{ return m_state != State::ACTIVE || canLoad(i); });
+        }
+
+        if(m_state != State::ACTIVE)
+            break;
+
+        CBatchItem item;
+        try
+        {
+            item.m_inputs = m_loadFunc(i);
+            item.m_memory = getMemorySize(item.m_inputs);
+        }
+        catch(...)
+        {
+            item.m_error = std::current_exception();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_memory += item.m_memory;
+            m_items.insert(std::make_pair(i, std::move(item)));
+        }
+        m_cond.notify_all();
+    }
+}
+
+bool CBatchInputPrefetcher::canLoad(size_t index) const
+{
+    if(index == m_lowestPending)
+        return true;
+
+    if(index >= m_lowestPending + m_depth)
+        return false;
+
+    return m_maxMemory == 0 || m_memory < m_maxMemory;
+}
+
+size_t CBatchInputPrefetcher::getMemorySize(const BatchInputs &inputs) const
+{
+    size_t size = 0;
+    for(auto&& inputPtr : inputs)
+    {
+        auto imageIOPtr = std::dynamic_pointer_cast<CImageIO>(inputPtr);
+        if(imageIOPtr)
+        {
+            CMat image = imageIOPtr->getImage();
+            size += image.total() * image.elemSize();
+        }
+    }
+    return size;
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2021 Ikomia SAS
+ * Contact: https://www.ikomia.com
+ *
+ * This file is part of the IkomiaStudio software.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CBATCHINPUTPREFETCHER_H
+#define CBATCHINPUTPREFETCHER_H
+
+#include <QFuture>
+#include <QThreadPool>
+#include <mutex>
+#include <condition_variable>
+#include "Core/CWorkflow.h"
+
+class CBatchInputPrefetcher
+{
+    public:
+
+        using BatchInputs = std::vector<WorkflowTaskIOPtr>;
+        using LoadFunc = std::function<BatchInputs(size_t)>;
+
+        CBatchInputPrefetcher();
+        ~CBatchInputPrefetcher();
+
+        // Active: started and not stopped. Stopped: cancelled while active,
+        // until the next start() or stop(): take() fails and callers must not load inline.
+        bool        isActive() const;
+        bool        isStopped() const;
+
+        void        start(const LoadFunc& loadFunc, size_t count, size_t depth, size_t maxMemory);
+        void        cancel();
+        void        stop();
+
+        bool        take(size_t index, BatchInputs& inputs);
+
+    private:
+
+        enum class State : int
+        {
+            IDLE,
+            ACTIVE,
+            STOPPED
+        };
+
+        struct CBatchItem
+        {
+            BatchInputs         m_inputs;
+            std::exception_ptr  m_error = nullptr;
+            size_t              m_memory = 0;
+        };
+
+        void        run();
+
+        bool        canLoad(size_t index) const;
+
+        size_t      getMemorySize(const BatchInputs& inputs) const;
+
+    private:
+
+        LoadFunc                        m_loadFunc;
+        // Private pool: the consumer blocks in take() on a global pool thread,
+        // the loader must not wait for a slot in that same pool
+        QThreadPool                     m_pool;
+        QFuture<void>                   m_future;
+        mutable std::mutex              m_mutex;
+        std::condition_variable         m_cond;
+        std::map<size_t, CBatchItem>    m_items;
+        std::vector<bool>               m_taken;
+        std::atomic<State>              m_state{State::IDLE};
+        size_t                          m_count = 0;
+        size_t                          m_depth = 0;
+        size_t                          m_maxMemory = 0;
+        size_t                          m_memory = 0;
+        // Lowest batch index not taken yet: always allowed to load to guarantee progress
+        size_t                          m_lowestPending = 0;
+};
+
+#endif // CBATCHINPUTPREFETCHER_H
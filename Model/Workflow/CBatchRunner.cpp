@@ -0,0 +1,462 @@
+// Copyright (C) 2021 Ikomia SAS
+// Contact: https://www.ikomia.com
+//
+// This file is part of the IkomiaStudio software.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "CBatchRunner.h"
+#include <QCommandLineParser>
+#include <QDirIterator>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QtConcurrent/QtConcurrent>
+#include <cstring>
+#include <map>
+#include <iostream>
+#include "Main/LogCategory.h"
+#include "Main/AppTools.hpp"
+#include "Graphics/CGraphicsContext.h"
+#include "IO/CImageIO.h"
+#include "CImageDataManager.h"
+#include "CWorkflowDBManager.h"
+#include "Model/CMainModel.h"
+
+CBatchRunner::CBatchRunner()
+{
+    m_graphicsContextPtr = std::make_shared<CGraphicsContext>();
+    m_pluginMgr.setRegistry(&m_registry);
+}
+
+CBatchRunner::~CBatchRunner()
+{
+    CPyEnsureGIL gil;
+    m_workers.clear();
+}
+
+bool CBatchRunner::isBatchCommand(int argc, char *argv[])
+{
+    return argc > 1 && std::strcmp(argv[1], "batch") == 0;
+}
+
+int CBatchRunner::exec(const QStringList &args)
+{
+    m_timer.start();
+
+    if(!parseArguments(args))
+        return m_bHelp ? 0 : 1;
+
+    try
+    {
+        if(!collectInputs())
+            return 1;
+
+        CMainModel::initPythonInterpreter();
+        loadPlugins();
+        createWorkers();
+    }
+    catch(std::exception& e)
+    {
+        qCCritical(logWorkflow).noquote() << QString::fromStdString(e.what());
+        return 1;
+    }
+
+    QJsonObject startEvent;
+    startEvent["event"] = "start";
+    startEvent["workflow"] = m_workflowPath;
+    startEvent["items"] = (qint64)m_batchCount;
+    startEvent["workers"] = (qint64)m_workers.size();
+    startEvent["startup_ms"] = (double)m_timer.nsecsElapsed() / 1e6;
+    printEvent(startEvent);
+
+    m_profiler.setEnabled(m_tracePath.isEmpty() == false);
+    m_profiler.beginRun(CWorkflowProfiler::BATCH);
+
+    QElapsedTimer runTimer;
+    runTimer.start();
+
+    // Workers pull items in input order from a shared counter, each one decodes its own inputs
+    QThreadPool pool;
+    pool.setMaxThreadCount((int)m_workers.size());
+    pool.setStackSize(QThreadPool::globalInstance()->stackSize());
+    QFutureSynchronizer<void> sync;
+
+    for(size_t i=0; i<m_workers.size(); ++i)
+        sync.addFuture(QtConcurrent::run(&pool, [this, i]{ runWorker(i); }));
+
+    sync.waitForFinished();
+
+    if(m_profiler.isEnabled())
+        m_profiler.exportChromeTrace(m_tracePath);
+
+    double runTime = (double)runTimer.nsecsElapsed() / 1e6;
+    QJsonObject finishEvent;
+    finishEvent["event"] = "finish";
+    finishEvent["items"] = (qint64)m_batchCount;
+    finishEvent["done"] = (qint64)(m_doneCount - m_failedCount);
+    finishEvent["failed"] = (qint64)m_failedCount;
+    finishEvent["run_ms"] = runTime;
+    finishEvent["items_per_s"] = runTime > 0 ? (double)m_batchCount * 1000.0 / runTime : 0.0;
+    finishEvent["total_ms"] = (double)m_timer.nsecsElapsed() / 1e6;
+    printEvent(finishEvent);
+
+    return m_failedCount > 0 ? 2 : 0;
+}
+
+bool CBatchRunner::parseArguments(const QStringList &args)
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QObject::tr("Run a saved workflow on a batch of images without graphical interface."));
+    parser.addHelpOption();
+    parser.addPositionalArgument("batch", QObject::tr("Batch command."));
+
+    QCommandLineOption workflowOption({"w", "workflow"}, QObject::tr("Saved workflow file."), "file");
+    QCommandLineOption inputOption({"i", "input"}, QObject::tr("Image folder, image file or text file listing images, one per workflow input."), "path");
+    QCommandLineOption outputOption({"o", "output"}, QObject::tr("Output folder."), "folder");
+    QCommandLineOption jobsOption({"j", "jobs"}, QObject::tr("Number of parallel workflow instances (default: ideal thread count)."), "count");
+    QCommandLineOption saveAllOption("save-all", QObject::tr("Save outputs of every task instead of final tasks only."));
+    QCommandLineOption traceOption("trace", QObject::tr("Write task executions to a Chrome trace file."), "file");
+    parser.addOptions({workflowOption, inputOption, outputOption, jobsOption, saveAllOption, traceOption});
+
+    if(!parser.parse(args))
+    {
+        qCCritical(logWorkflow).noquote() << parser.errorText();
+        return false;
+    }
+
+    if(parser.isSet("help"))
+    {
+        std::cout << parser.helpText().toStdString();
+        m_bHelp = true;
+        return false;
+    }
+
+    m_workflowPath = parser.value(workflowOption);
+    m_inputPaths = parser.values(inputOption);
+    m_outputFolder = parser.value(outputOption);
+    m_bSaveAll = parser.isSet(saveAllOption);
+    m_tracePath = parser.value(traceOption);
+
+    if(m_workflowPath.isEmpty() || m_inputPaths.isEmpty() || m_outputFolder.isEmpty())
+    {
+        qCCritical(logWorkflow).noquote() << QObject::tr("Workflow, input and output are mandatory.");
+        std::cout << parser.helpText().toStdString();
+        return false;
+    }
+
+    if(!QFileInfo::exists(m_workflowPath))
+    {
+        qCCritical(logWorkflow).noquote() << QObject::tr("Workflow file not found: %1").arg(m_workflowPath);
+        return false;
+    }
+
+    if(parser.isSet(jobsOption))
+    {
+        bool bOk = false;
+        int count = parser.value(jobsOption).toInt(&bOk);
+        if(!bOk || count < 1)
+        {
+            qCCritical(logWorkflow).noquote() << QObject::tr("Invalid number of jobs: %1").arg(parser.value(jobsOption));
+            return false;
+        }
+        m_workerCount = (size_t)count;
+    }
+    else
+        m_workerCount = (size_t)std::max(1, QThread::idealThreadCount());
+
+    m_outputFolder = QDir(m_outputFolder).absolutePath();
+    if(!QDir().mkpath(m_outputFolder))
+    {
+        qCCritical(logWorkflow).noquote() << QObject::tr("Unable to create output folder: %1").arg(m_outputFolder);
+        return false;
+    }
+    return true;
+}
+
+bool CBatchRunner::isImageFile(const QString &path) const
+{
+    return CDataImageIO::isImageFormat(Utils::File::extension(path.toStdString()));
+}
+
+QStringList CBatchRunner::collectFiles(const QString &path, QStringList& subDirs) const
+{
+    QStringList files;
+    QFileInfo info(path);
+
+    if(info.isDir())
+    {
+        QDirIterator it(info.absoluteFilePath(), QDir::Files|QDir::NoSymLinks, QDirIterator::Subdirectories);
+        while(it.hasNext())
+        {
+            QString file = it.next();
+            if(isImageFile(file))
+                files.append(file);
+        }
+        // Directory order is file system dependent
+        files.sort();
+
+        QDir rootDir(info.absoluteFilePath());
+        for(auto&& file : files)
+        {
+            QString subDir = rootDir.relativeFilePath(QFileInfo(file).absolutePath());
+            subDirs.append(subDir == "." ? QString() : subDir);
+        }
+        return files;
+    }
+    else if(isImageFile(path))
+        files.append(info.absoluteFilePath());
+    else if(info.isFile())
+    {
+        // List file: one image per line, relative paths are resolved from the list location
+        QFile file(path);
+        if(!file.open(QIODevice::ReadOnly | QIODevice::Text))
+            throw CException(CoreExCode::INVALID_FILE, QObject::tr("Unable to open input list %1").arg(path).toStdString(), __func__, __FILE__, __LINE__);
+
+        QTextStream stream(&file);
+        while(!stream.atEnd())
+        {
+            QString line = stream.readLine().trimmed();
+            if(!line.isEmpty() && !line.startsWith('#'))
+                files.append(info.dir().absoluteFilePath(line));
+        }
+    }
+
+    // Images and lists: outputs are written flat in the output folder
+    for(int i=0; i<files.size(); ++i)
+        subDirs.append(QString());
+
+    return files;
+}
+
+bool CBatchRunner::collectInputs()
+{
+    m_inputFiles.clear();
+    m_itemSubDirs.clear();
+
+    for(auto&& path : m_inputPaths)
+    {
+        if(!QFileInfo::exists(path))
+        {
+            qCCritical(logWorkflow).noquote() << QObject::tr("Input not found: %1").arg(path);
+            return false;
+        }
+
+        QStringList subDirs;
+        m_inputFiles.push_back(collectFiles(path, subDirs));
+
+        if(m_inputFiles.size() == 1)
+            m_itemSubDirs = subDirs;
+    }
+
+    m_batchCount = m_inputFiles[0].size();
+    for(size_t i=1; i<m_inputFiles.size(); ++i)
+    {
+        if((size_t)m_inputFiles[i].size() != m_batchCount)
+        {
+            qCCritical(logWorkflow).noquote() << QObject::tr("Inputs must have the same number of images: %1 has %2, %3 has %4.")
+                                                 .arg(m_inputPaths[0]).arg(m_batchCount)
+                                                 .arg(m_inputPaths[(int)i]).arg(m_inputFiles[i].size());
+            return false;
+        }
+    }
+
+    if(m_batchCount == 0)
+    {
+        qCCritical(logWorkflow).noquote() << QObject::tr("No image found in inputs.");
+        return false;
+    }
+    return checkOutputNames();
+}
+
+bool CBatchRunner::checkOutputNames() const
+{
+    // Outputs are named after the first input file: two items must not map to the same output name
+    std::map<QString, QString> names;
+    for(int i=0; i<m_inputFiles[0].size(); ++i)
+    {
+        const QString& file = m_inputFiles[0][i];
+        QString name = QDir::cleanPath(m_itemSubDirs[i] + "/" + QFileInfo(file).completeBaseName());
+        auto it = names.find(name);
+
+        if(it != names.end())
+        {
+            qCCritical(logWorkflow).noquote() << QObject::tr("Outputs of %1 and %2 would overwrite each other, rename one of them.").arg(it->second).arg(file);
+            return false;
+        }
+        names.insert(std::make_pair(name, file));
+    }
+    return true;
+}
+
+void CBatchRunner::loadPlugins()
+{
+    QElapsedTimer timer;
+    timer.start();
+    m_pluginMgr.loadProcessPlugins();
+    qCInfo(logPlugin).noquote() << QObject::tr("Plugins loaded in %1 ms").arg(timer.elapsed());
+}
+
+void CBatchRunner::createWorkers()
+{
+    // Each worker owns an independent workflow instance loaded from the same file
+    CWorkflowDBManager dbMgr;
+    size_t count = std::min(m_workerCount, m_batchCount);
+
+    for(size_t i=0; i<count; ++i)
+    {
+        WorkflowPtr workflowPtr = dbMgr.load(m_workflowPath, &m_registry, m_graphicsContextPtr);
+        if(workflowPtr == nullptr)
+            throw CException(CoreExCode::INVALID_FILE, QObject::tr("Unable to load workflow %1").arg(m_workflowPath).toStdString(), __func__, __FILE__, __LINE__);
+
+        if(workflowPtr->getInputCount() != m_inputFiles.size())
+        {
+            auto msg = QObject::tr("Workflow %1 has %2 input(s), %3 given.")
+                    .arg(QString::fromStdString(workflowPtr->getName()))
+                    .arg(workflowPtr->getInputCount())
+                    .arg(m_inputFiles.size());
+            throw CException(CoreExCode::INVALID_PARAMETER, msg.toStdString(), __func__, __FILE__, __LINE__);
+        }
+        prepareWorkflow(workflowPtr);
+        m_profiler.attach(workflowPtr);
+        m_workers.push_back(workflowPtr);
+    }
+}
+
+void CBatchRunner::prepareWorkflow(const WorkflowPtr &workflowPtr) const
+{
+    std::string outputFolder = m_outputFolder.toStdString() + "/";
+    workflowPtr->setOutputFolder(outputFolder);
+
+    for(size_t i=0; i<workflowPtr->getInputCount(); ++i)
+        workflowPtr->setInputBatchState(i, true);
+
+    // Outputs are exported to <output>/<task name>/, named after the input file
+    auto vertexIt = workflowPtr->getVertices();
+    for(auto it=vertexIt.first; it!=vertexIt.second; ++it)
+    {
+        if(workflowPtr->isRoot(*it))
+            continue;
+
+        auto taskPtr = workflowPtr->getTask(*it);
+        auto outEdges = workflowPtr->getOutEdges(*it);
+        bool bSave = m_bSaveAll || outEdges.first == outEdges.second;
+        taskPtr->setOutputFolder(outputFolder + taskPtr->getName() + "/");
+
+        for(size_t i=0; i<taskPtr->getOutputCount(); ++i)
+            taskPtr->getOutput(i)->setAutoSave(bSave);
+    }
+}
+
+void CBatchRunner::setItemOutputFolder(const WorkflowPtr &workflowPtr, const QString &subDir) const
+{
+    // Input folder tree is mirrored under <output>/<task name>/
+    auto vertexIt = workflowPtr->getVertices();
+    for(auto it=vertexIt.first; it!=vertexIt.second; ++it)
+    {
+        if(workflowPtr->isRoot(*it))
+            continue;
+
+        auto taskPtr = workflowPtr->getTask(*it);
+        QString folder = m_outputFolder + "/" + QString::fromStdString(taskPtr->getName()) + "/";
+
+        if(subDir.isEmpty() == false)
+        {
+            folder += subDir + "/";
+            QDir().mkpath(folder);
+        }
+        taskPtr->setOutputFolder(folder.toStdString());
+    }
+}
+
+std::vector<WorkflowTaskIOPtr> CBatchRunner::loadInputs(size_t index) const
+{
+    std::vector<WorkflowTaskIOPtr> inputs;
+    for(auto&& files : m_inputFiles)
+    {
+        std::string path = files[(int)index].toStdString();
+        CImageDataIO io(path);
+        CMat image = io.read();
+
+        if(!image.data)
+            throw CException(CoreExCode::INVALID_IMAGE, "Invalid image: " + path, __func__, __FILE__, __LINE__);
+
+        auto inputPtr = std::make_shared<CImageIO>(IODataType::IMAGE, image);
+        inputPtr->setName(Utils::File::getFileName(path));
+        CDataInfoPtr infoPtr = inputPtr->getDataInfo();
+
+        if(infoPtr)
+            infoPtr->setFileName(path);
+
+        inputs.push_back(inputPtr);
+    }
+    return inputs;
+}
+
+void CBatchRunner::runWorker(size_t workerIndex)
+{
+    const WorkflowPtr& workflowPtr = m_workers[workerIndex];
+    workflowPtr->updateStartTime();
+    workflowPtr->workflowStarted();
+
+    for(size_t i=m_nextIndex++; i<m_batchCount; i=m_nextIndex++)
+    {
+        QElapsedTimer timer;
+        timer.start();
+
+        QJsonArray inputFiles;
+        for(auto&& files : m_inputFiles)
+            inputFiles.append(files[(int)i]);
+
+        QJsonObject event;
+        event["event"] = "item";
+        event["index"] = (qint64)i;
+        event["worker"] = (qint64)workerIndex;
+        event["inputs"] = inputFiles;
+
+        try
+        {
+            auto inputs = loadInputs(i);
+            event["load_ms"] = (double)timer.nsecsElapsed() / 1e6;
+
+            for(size_t j=0; j<inputs.size(); ++j)
+                workflowPtr->setInput(inputs[j], j, true);
+
+            setItemOutputFolder(workflowPtr, m_itemSubDirs[(int)i]);
+
+            CWorkflowProfiler::setCurrentItem((int)i);
+            workflowPtr->clearAllOutputData();
+            workflowPtr->run();
+            event["status"] = "done";
+        }
+        catch(std::exception& e)
+        {
+            m_failedCount++;
+            event["status"] = "failed";
+            event["error"] = QString::fromStdString(e.what());
+        }
+
+        event["ms"] = (double)timer.nsecsElapsed() / 1e6;
+        event["done"] = (qint64)++m_doneCount;
+        event["total"] = (qint64)m_batchCount;
+        printEvent(event);
+    }
+    workflowPtr->workflowFinished();
+}
+
+void CBatchRunner::printEvent(const QJsonObject &event)
+{
+    QByteArray line = QJsonDocument(event).toJson(QJsonDocument::Compact);
+    std::lock_guard<std::mutex> lock(m_printMutex);
+    std::cout << line.constData() << std::endl;
+}
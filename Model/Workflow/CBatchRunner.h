@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2021 Ikomia SAS
+ * Contact: https://www.ikomia.com
+ *
+ * This file is part of the IkomiaStudio software.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CBATCHRUNNER_H
+#define CBATCHRUNNER_H
+
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include "Core/CWorkflow.h"
+#include "Core/CIkomiaRegistry.h"
+#include "Model/Plugin/CPluginManager.h"
+#include "CWorkflowProfiler.h"
+
+class CGraphicsContext;
+using GraphicsContextPtr = std::shared_ptr<CGraphicsContext>;
+
+// Headless batch execution of a saved workflow: no widget, OpenGL or project model.
+// Usage: Ikomia batch --workflow <file> --input <folder|image|list> --output <folder> [--jobs N] [--trace <file>]
+// Outputs go to <output>/<task name>/, mirroring the sub-folders of the first input folder.
+// One JSON object per line is printed on stdout for progress and timing, logs go to stderr.
+class CBatchRunner
+{
+    public:
+
+        CBatchRunner();
+        ~CBatchRunner();
+
+        static bool             isBatchCommand(int argc, char *argv[]);
+
+        int                     exec(const QStringList& args);
+
+    private:
+
+        bool                    parseArguments(const QStringList& args);
+
+        bool                    isImageFile(const QString& path) const;
+
+        QStringList             collectFiles(const QString& path, QStringList& subDirs) const;
+
+        bool                    collectInputs();
+        bool                    checkOutputNames() const;
+
+        void                    loadPlugins();
+        void                    createWorkers();
+
+        void                    prepareWorkflow(const WorkflowPtr& workflowPtr) const;
+        void                    setItemOutputFolder(const WorkflowPtr& workflowPtr, const QString& subDir) const;
+
+        std::vector<WorkflowTaskIOPtr>  loadInputs(size_t index) const;
+
+        void                    runWorker(size_t workerIndex);
+
+        void                    printEvent(const QJsonObject& event);
+
+    private:
+
+        CIkomiaRegistry             m_registry;
+        CPluginManager              m_pluginMgr;
+        GraphicsContextPtr          m_graphicsContextPtr = nullptr;
+        CWorkflowProfiler           m_profiler;
+        QString                     m_workflowPath;
+        QString                     m_outputFolder;
+        QString                     m_tracePath;
+        QStringList                 m_inputPaths;
+        // Files bound to each workflow input, same count for all inputs
+        std::vector<QStringList>    m_inputFiles;
+        // Folder of each item relative to the first input folder, mirrored in the output folder
+        QStringList                 m_itemSubDirs;
+        std::vector<WorkflowPtr>    m_workers;
+        size_t                      m_workerCount = 1;
+        size_t                      m_batchCount = 0;
+        bool                        m_bSaveAll = false;
+        bool                        m_bHelp = false;
+        std::atomic_size_t          m_nextIndex{0};
+        std::atomic_size_t          m_doneCount{0};
+        std::atomic_size_t          m_failedCount{0};
+        std::mutex                  m_printMutex;
+        QElapsedTimer               m_timer;
+};
+
+#endif // CBATCHRUNNER_H
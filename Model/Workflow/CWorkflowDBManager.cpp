@@ -20,8 +20,13 @@
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QSqlDriver>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
 #include "Main/AppTools.hpp"
+#include "Main/LogCategory.h"
 #include "Model/Process/CProcessManager.h"
+#include "Core/CIkomiaRegistry.h"
 
 CWorkflowDBManager::CWorkflowDBManager()
 {
@@ -122,117 +127,116 @@ int CWorkflowDBManager::save(QSqlDatabase& db, const WorkflowPtr &pWorkflow)
        throw CException(DatabaseExCode::INVALID_QUERY, db.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
 
     QSqlQuery q(db);
-    std::unordered_map<WorkflowVertex, int> mapVertexToDbId;
 
     bool bTransaction = db.driver()->hasFeature(QSqlDriver::Transactions);
     if(bTransaction)
        db.transaction();
 
-    //Ajout du protocol
-    QString name = QString::fromStdString(Utils::String::dbFormat(pWorkflow->getName()));
-    QString keywords = QString::fromStdString(Utils::String::dbFormat(pWorkflow->getKeywords()));
-    QString description = QString::fromStdString(Utils::String::dbFormat(pWorkflow->getDescription()));
+    try
+    {
+        //Ajout du protocol
+        QString name = QString::fromStdString(pWorkflow->getName());
+        QString keywords = QString::fromStdString(pWorkflow->getKeywords());
+        QString description = QString::fromStdString(pWorkflow->getDescription());
 
-    if(!q.exec(QString("INSERT INTO protocol (name, keywords, description) VALUES ('%1', '%2', '%3');").arg(name, keywords, description)))
-       throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+        if(!q.prepare("INSERT INTO protocol (name, keywords, description) VALUES (?, ?, ?);"))
+           throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
 
-    int protocolId = q.lastInsertId().toInt();
-    if(!q.exec(QString("INSERT INTO protocolFTS (id, name, keywords, description) VALUES (%1, '%2', '%3', '%4');")
-               .arg(protocolId)
-               .arg(name, keywords, description)))
-    {
-       throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
-    }
+        q.addBindValue(name);
+        q.addBindValue(keywords);
+        q.addBindValue(description);
 
-    //Ajout des taches
-    auto vertexIt = pWorkflow->getVertices();
-    if(vertexIt.first != vertexIt.second)
-    {
-       QSqlQuery q2(db);
-       q.prepare("INSERT INTO protocolTask (name, protocolId) VALUES (?, ?);");
-       q2.prepare("INSERT INTO protocolParameter (name, value, taskId) VALUES (? , ?, ?);");
-
-       for(auto it=vertexIt.first; it!=vertexIt.second; ++it)
-       {
-           if(pWorkflow->isRoot(*it) == false)
-           {
-               auto pTask = pWorkflow->getTask(*it);
-               //Nom de la tache
-               q.addBindValue(QString::fromStdString(pTask->getName()));
-               //Foreign key : protocole
-               q.addBindValue(protocolId);
-
-               if(!q.exec())
-                   throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
-
-               int taskId = q.lastInsertId().toInt();
-               mapVertexToDbId.insert(std::make_pair(*it, taskId));
-
-               //Sauvegarde des paramètres associés
-               auto paramMap = pTask->getParam()->getParamMap();
-               for(auto it=paramMap.begin(); it!=paramMap.end(); ++it)
-               {
-                   q2.addBindValue(QString::fromStdString(it->first));
-                   q2.addBindValue(QString::fromStdString(it->second));
-                   q2.addBindValue(taskId);
-
-                   if(!q2.exec())
-                       throw CException(DatabaseExCode::INVALID_QUERY, q2.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
-               }
-           }
-       }
-    }
+        if(!q.exec())
+           throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
 
-    //Ajout des arcs
-    auto edgeIt = pWorkflow->getEdges();
-    if(edgeIt.first != edgeIt.second)
-    {
-       q.prepare("INSERT INTO protocolEdge (srcIndex, targetIndex, protocolId, srcTaskId, targetTaskId) VALUES (?, ?, ?, ?, ?);");
-       for(auto it=edgeIt.first; it!=edgeIt.second; ++it)
-       {
-           auto pEdge = pWorkflow->getEdge(*it);
-           //Indices des ports I/O
-           q.addBindValue((int)pEdge->getSourceIndex());
-           q.addBindValue((int)pEdge->getTargetIndex());
-           //Foreign key : protocole
-           q.addBindValue(protocolId);
-
-           //Foreign key : tâche source
-           auto srcId = pWorkflow->getEdgeSource(*it);
-           auto srcFk = mapVertexToDbId.find(srcId);
-
-           if(srcFk != mapVertexToDbId.end())
-               q.addBindValue(srcFk->second);
-           else
-               q.addBindValue(-1);
-
-           //Foreign key : tâche cible
-           auto targetId = pWorkflow->getEdgeTarget(*it);
-           auto targetFk = mapVertexToDbId.find(targetId);
-
-           if(targetFk != mapVertexToDbId.end())
-               q.addBindValue(targetFk->second);
-           else
-               q.addBindValue(-1);
-
-           if(!q.exec())
-               throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
-       }
-    }
+        int protocolId = q.lastInsertId().toInt();
+        if(!q.prepare("INSERT INTO protocolFTS (id, name, keywords, description) VALUES (?, ?, ?, ?);"))
+           throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
 
-    if(bTransaction)
-        db.commit();
+        q.addBindValue(protocolId);
+        q.addBindValue(name);
+        q.addBindValue(keywords);
+        q.addBindValue(description);
 
-    return protocolId;
+        if(!q.exec())
+           throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+
+        //Task identifiers are set here so that tasks, parameters and edges are inserted by batch
+        if(!q.exec("SELECT IFNULL(MAX(id), 0) FROM protocolTask;") || !q.next())
+           throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+
+        TaskRecords tasks;
+        EdgeRecords edges;
+        getRecords(pWorkflow, q.value(0).toInt() + 1, tasks, edges);
+
+        //Ajout des taches et des paramètres associés
+        QVector<QVariantList> taskValues(3), paramValues(3);
+        for(auto&& task : tasks)
+        {
+            taskValues[0] << task.m_id;
+            taskValues[1] << QString::fromStdString(task.m_name);
+            taskValues[2] << protocolId;
+
+            for(auto&& param : task.m_params)
+            {
+                paramValues[0] << QString::fromStdString(param.first);
+                paramValues[1] << QString::fromStdString(param.second);
+                paramValues[2] << task.m_id;
+            }
+        }
+        execBatch(q, "INSERT INTO protocolTask (id, name, protocolId) VALUES (?, ?, ?);", taskValues);
+        execBatch(q, "INSERT INTO protocolParameter (name, value, taskId) VALUES (?, ?, ?);", paramValues);
+
+        //Ajout des arcs
+        QVector<QVariantList> edgeValues(5);
+        for(auto&& edge : edges)
+        {
+            edgeValues[0] << edge.m_srcIndex;
+            edgeValues[1] << edge.m_targetIndex;
+            edgeValues[2] << protocolId;
+            edgeValues[3] << edge.m_srcId;
+            edgeValues[4] << edge.m_targetId;
+        }
+        execBatch(q, "INSERT INTO protocolEdge (srcIndex, targetIndex, protocolId, srcTaskId, targetTaskId) VALUES (?, ?, ?, ?, ?);", edgeValues);
+
+        //Compact representation loaded in one query
+        if(!q.prepare("INSERT INTO protocolBlob (protocolId, data) VALUES (?, ?);"))
+           throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+
+        q.addBindValue(protocolId);
+        q.addBindValue(toBlob(tasks, edges));
+
+        if(!q.exec())
+           throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+
+        if(bTransaction)
+            db.commit();
+
+        return protocolId;
+    }
+    catch(std::exception& e)
+    {
+        if(bTransaction)
+            db.rollback();
+
+        throw;
+    }
 }
 
 std::unique_ptr<CWorkflow> CWorkflowDBManager::load(int protocolId, CProcessManager *pProcessMgr, const GraphicsContextPtr &graphicsContextPtr)
 {
+    assert(pProcessMgr);
     auto db = initDB(m_path, Utils::Database::getMainConnectionName());
-    return load(db, protocolId, pProcessMgr, graphicsContextPtr);
+    return load(db, protocolId, &pProcessMgr->m_registry, graphicsContextPtr);
 }
 
 std::unique_ptr<CWorkflow> CWorkflowDBManager::load(QString path, CProcessManager *pProcessMgr, const GraphicsContextPtr &graphicsContextPtr)
+{
+    assert(pProcessMgr);
+    return load(path, &pProcessMgr->m_registry, graphicsContextPtr);
+}
+
+std::unique_ptr<CWorkflow> CWorkflowDBManager::load(QString path, CIkomiaRegistry *pRegistry, const GraphicsContextPtr &graphicsContextPtr)
 {
     std::unique_ptr<CWorkflow> pWorkflow = nullptr;
     auto db = initDB(path, "WorkflowConnectionTmp");
@@ -242,91 +246,99 @@ std::unique_ptr<CWorkflow> CWorkflowDBManager::load(QString path, CProcessManage
         throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
 
     if(q.first())
-        pWorkflow = load(db, q.value(0).toInt(), pProcessMgr, graphicsContextPtr);
+        pWorkflow = load(db, q.value(0).toInt(), pRegistry, graphicsContextPtr);
 
     db.close();
     return pWorkflow;
 }
 
-std::unique_ptr<CWorkflow> CWorkflowDBManager::load(QSqlDatabase& db, int protocolId, CProcessManager *pProcessMgr, const GraphicsContextPtr& graphicsContextPtr)
+std::unique_ptr<CWorkflow> CWorkflowDBManager::load(QSqlDatabase& db, int protocolId, CIkomiaRegistry *pRegistry, const GraphicsContextPtr& graphicsContextPtr)
 {
-    assert(pProcessMgr);
-    std::unordered_map<int,WorkflowVertex>  mapDbIdToVertexId;
-    std::unique_ptr<CWorkflow> pWorkflow = nullptr;
+    assert(pRegistry);
 
     if(!db.isValid())
        throw CException(DatabaseExCode::INVALID_QUERY, db.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
 
     QSqlQuery q(db);
+    if(!q.prepare("SELECT p.name, p.keywords, p.description, b.data FROM protocol p LEFT JOIN protocolBlob b ON p.id=b.protocolId WHERE p.id=?;"))
+       throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
 
-    //Chargement des tâches
-    if(!q.exec(QString("SELECT p.name as protocolName, p.keywords, p.description, t.id as taskId, t.name as taskName\
-                        FROM protocol p INNER JOIN protocolTask t ON p.id=t.protocolId WHERE p.id=%1;").arg(protocolId)))
-    {
+    q.addBindValue(protocolId);
+    if(!q.exec())
        throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
-    }
 
-    if(!q.first())
+    if(!q.next())
        return nullptr;
 
-    auto name = q.value("protocolName").toString().toStdString();
-    pWorkflow = std::make_unique<CWorkflow>(name, &pProcessMgr->m_registry, graphicsContextPtr);
+    //Workflows saved before the compact representation: tasks, parameters and edges tables
+    TaskRecords tasks;
+    EdgeRecords edges;
+    if(q.isNull(3) || fromBlob(q.value(3).toByteArray(), tasks, edges) == false)
+        loadRecords(db, protocolId, tasks, edges);
 
-    if(m_pSettingsMgr)
-        pWorkflow->setOutputFolder(m_pSettingsMgr->getWorkflowSaveFolder() + name + "/");
+    if(tasks.empty())
+       return nullptr;
+
+    auto name = q.value(0).toString().toStdString();
+    auto pWorkflow = createWorkflow(name, tasks, edges, pRegistry, graphicsContextPtr);
+
+    if(!q.isNull(1))
+        pWorkflow->setKeywords(q.value(1).toString().toStdString());
 
-    if(!q.isNull("keywords"))
-        pWorkflow->setKeywords(q.value("keywords").toString().toStdString());
+    if(!q.isNull(2))
+        pWorkflow->setDescription(q.value(2).toString().toStdString());
+
+    return pWorkflow;
+}
+
+std::unique_ptr<CWorkflow> CWorkflowDBManager::createWorkflow(const std::string &name, const TaskRecords &tasks, const EdgeRecords &edges,
+                                                              CIkomiaRegistry *pRegistry, const GraphicsContextPtr &graphicsContextPtr)
+{
+    std::unordered_map<int,WorkflowVertex>  mapDbIdToVertexId;
+    auto pWorkflow = std::make_unique<CWorkflow>(name, pRegistry, graphicsContextPtr);
 
-    if(!q.isNull("description"))
-        pWorkflow->setKeywords(q.value("description").toString().toStdString());
+    if(m_pSettingsMgr)
+        pWorkflow->setOutputFolder(m_pSettingsMgr->getWorkflowSaveFolder() + name + "/");
 
     CPyEnsureGIL gil;
-    do
+    for(auto&& task : tasks)
     {
-        int taskId = q.value("taskId").toInt();
-        std::string taskName = q.value("taskName").toString().toStdString();
-        UMapString paramMap = getTaskParameters(db, taskId);
-        auto pTask = pProcessMgr->createObject(taskName, nullptr);
+        WorkflowTaskPtr pTask = nullptr;
+        try
+        {
+            pTask = pRegistry->createInstance(task.m_name, nullptr);
+        }
+        catch(std::exception& e)
+        {
+            qCCritical(logPlugin).noquote() << QString::fromStdString(e.what());
+        }
 
         if(pTask)
         {
-            pTask->setParamValues(paramMap);
+            pTask->setParamValues(task.m_params);
             pTask->parametersModified();
             auto vertexId = pWorkflow->addTask(pTask);
-            mapDbIdToVertexId.insert(std::make_pair(taskId, vertexId));
+            mapDbIdToVertexId.insert(std::make_pair(task.m_id, vertexId));
         }
         else
-            throw CException(CoreExCode::NULL_POINTER, "The task of type: " + taskName + " can't be created", __func__, __FILE__, __LINE__);
-    }
-    while(q.next());
-
-    //Chargement des arcs
-    if(!q.exec(QString("SELECT e.srcIndex, e.targetIndex, e.srcTaskId, e.targetTaskId\
-                        FROM protocol p INNER JOIN protocolEdge e ON p.id=e.protocolId WHERE p.id=%1;").arg(protocolId)))
-    {
-       throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+            throw CException(CoreExCode::NULL_POINTER, "The task of type: " + task.m_name + " can't be created", __func__, __FILE__, __LINE__);
     }
 
-    while(q.next())
+    for(auto&& edge : edges)
     {
-        int dbSrcId = q.value("srcTaskId").toInt();
         WorkflowVertex srcTaskId = boost::graph_traits<WorkflowGraph>::null_vertex();
-
-        auto itSrc = mapDbIdToVertexId.find(dbSrcId);
+        auto itSrc = mapDbIdToVertexId.find(edge.m_srcId);
         if(itSrc != mapDbIdToVertexId.end())
             srcTaskId = itSrc->second;
 
-        int dbTargetId = q.value("targetTaskId").toInt();
         WorkflowVertex targetTaskId = boost::graph_traits<WorkflowGraph>::null_vertex();
-
-        auto itTarget = mapDbIdToVertexId.find(dbTargetId);
+        auto itTarget = mapDbIdToVertexId.find(edge.m_targetId);
         if(itTarget != mapDbIdToVertexId.end())
             targetTaskId = itTarget->second;
 
         try
         {
-            pWorkflow->connect(srcTaskId, q.value("srcIndex").toInt(), targetTaskId, q.value("targetIndex").toInt());
+            pWorkflow->connect(srcTaskId, edge.m_srcIndex, targetTaskId, edge.m_targetIndex);
         }
         catch(std::exception& e)
         {
@@ -348,6 +360,9 @@ void CWorkflowDBManager::remove(int protocolId)
 
     if(!q.exec(QString("DELETE FROM protocolFTS WHERE id=%1").arg(protocolId)))
         throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+
+    if(!q.exec(QString("DELETE FROM protocolBlob WHERE protocolId=%1").arg(protocolId)))
+        throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
 }
 
 QSqlDatabase CWorkflowDBManager::initDB(const QString& path, const QString& connectionName)
@@ -408,20 +423,186 @@ void CWorkflowDBManager::createTables(QSqlDatabase& db)
             throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
         }
     }
+
+    //Table compact workflow (tasks, parameters and edges)
+    if(tables.contains("protocolBlob") == false)
+    {
+        if(!q.exec("CREATE TABLE protocolBlob (protocolId INTEGER PRIMARY KEY, data BLOB,\
+                    FOREIGN KEY(protocolId) REFERENCES protocol(id) ON DELETE CASCADE);"))
+        {
+            throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+        }
+    }
+}
+
+void CWorkflowDBManager::getRecords(const WorkflowPtr &pWorkflow, int firstTaskId, TaskRecords &tasks, EdgeRecords &edges) const
+{
+    std::unordered_map<WorkflowVertex, int> mapVertexToDbId;
+    int taskId = firstTaskId;
+
+    auto vertexIt = pWorkflow->getVertices();
+    for(auto it=vertexIt.first; it!=vertexIt.second; ++it)
+    {
+        if(pWorkflow->isRoot(*it) == false)
+        {
+            auto pTask = pWorkflow->getTask(*it);
+            CTaskRecord task;
+            task.m_id = taskId++;
+            task.m_name = pTask->getName();
+            task.m_params = pTask->getParam()->getParamMap();
+            mapVertexToDbId.insert(std::make_pair(*it, task.m_id));
+            tasks.push_back(std::move(task));
+        }
+    }
+
+    auto edgeIt = pWorkflow->getEdges();
+    for(auto it=edgeIt.first; it!=edgeIt.second; ++it)
+    {
+        auto pEdge = pWorkflow->getEdge(*it);
+        CEdgeRecord edge;
+        edge.m_srcIndex = (int)pEdge->getSourceIndex();
+        edge.m_targetIndex = (int)pEdge->getTargetIndex();
+
+        //Root task is not saved: -1
+        auto srcFk = mapVertexToDbId.find(pWorkflow->getEdgeSource(*it));
+        if(srcFk != mapVertexToDbId.end())
+            edge.m_srcId = srcFk->second;
+
+        auto targetFk = mapVertexToDbId.find(pWorkflow->getEdgeTarget(*it));
+        if(targetFk != mapVertexToDbId.end())
+            edge.m_targetId = targetFk->second;
+
+        edges.push_back(edge);
+    }
 }
 
-UMapString CWorkflowDBManager::getTaskParameters(QSqlDatabase& db, int taskId)
+void CWorkflowDBManager::loadRecords(QSqlDatabase &db, int protocolId, TaskRecords &tasks, EdgeRecords &edges)
 {
     QSqlQuery q(db);
 
-    if(!q.exec(QString("SELECT * FROM protocolParameter WHERE taskId=%1").arg(taskId)))
-        throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+    //Chargement des tâches
+    if(!q.exec(QString("SELECT id, name FROM protocolTask WHERE protocolId=%1 ORDER BY id;").arg(protocolId)))
+       throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
 
-    UMapString paramMap;
+    std::unordered_map<int, size_t> mapIdToIndex;
     while(q.next())
     {
-        paramMap.insert(std::make_pair(q.value("name").toString().toStdString(),
-                                       q.value("value").toString().toStdString()));
+        CTaskRecord task;
+        task.m_id = q.value(0).toInt();
+        task.m_name = q.value(1).toString().toStdString();
+        mapIdToIndex.insert(std::make_pair(task.m_id, tasks.size()));
+        tasks.push_back(std::move(task));
     }
-    return paramMap;
+
+    //Paramètres de toutes les tâches
+    if(!q.exec(QString("SELECT pp.taskId, pp.name, pp.value FROM protocolTask t INNER JOIN protocolParameter pp ON t.id=pp.taskId "
+                       "WHERE t.protocolId=%1;").arg(protocolId)))
+    {
+       throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+    }
+
+    while(q.next())
+    {
+        auto it = mapIdToIndex.find(q.value(0).toInt());
+        if(it != mapIdToIndex.end())
+            tasks[it->second].m_params.insert(std::make_pair(q.value(1).toString().toStdString(), q.value(2).toString().toStdString()));
+    }
+
+    //Chargement des arcs
+    if(!q.exec(QString("SELECT srcIndex, targetIndex, srcTaskId, targetTaskId FROM protocolEdge WHERE protocolId=%1;").arg(protocolId)))
+       throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+
+    while(q.next())
+    {
+        CEdgeRecord edge;
+        edge.m_srcIndex = q.value(0).toInt();
+        edge.m_targetIndex = q.value(1).toInt();
+        edge.m_srcId = q.value(2).toInt();
+        edge.m_targetId = q.value(3).toInt();
+        edges.push_back(edge);
+    }
+}
+
+QByteArray CWorkflowDBManager::toBlob(const TaskRecords &tasks, const EdgeRecords &edges) const
+{
+    QJsonArray jsonTasks;
+    for(auto&& task : tasks)
+    {
+        QJsonObject jsonParams;
+        for(auto&& param : task.m_params)
+            jsonParams.insert(QString::fromStdString(param.first), QString::fromStdString(param.second));
+
+        QJsonObject jsonTask;
+        jsonTask["id"] = task.m_id;
+        jsonTask["name"] = QString::fromStdString(task.m_name);
+        jsonTask["parameters"] = jsonParams;
+        jsonTasks.append(jsonTask);
+    }
+
+    QJsonArray jsonEdges;
+    for(auto&& edge : edges)
+        jsonEdges.append(QJsonArray({edge.m_srcId, edge.m_srcIndex, edge.m_targetId, edge.m_targetIndex}));
+
+    QJsonObject jsonWorkflow;
+    jsonWorkflow["version"] = 1;
+    jsonWorkflow["tasks"] = jsonTasks;
+    jsonWorkflow["edges"] = jsonEdges;
+    return qCompress(QJsonDocument(jsonWorkflow).toJson(QJsonDocument::Compact));
+}
+
+bool CWorkflowDBManager::fromBlob(const QByteArray &blob, TaskRecords &tasks, EdgeRecords &edges) const
+{
+    QJsonParseError error;
+    QJsonDocument doc = QJsonDocument::fromJson(qUncompress(blob), &error);
+
+    if(error.error != QJsonParseError::NoError || doc.isObject() == false)
+    {
+        qWarning().noquote() << QObject::tr("Invalid compact workflow data: %1").arg(error.errorString());
+        return false;
+    }
+
+    QJsonObject jsonWorkflow = doc.object();
+    for(auto&& value : jsonWorkflow["tasks"].toArray())
+    {
+        QJsonObject jsonTask = value.toObject();
+        CTaskRecord task;
+        task.m_id = jsonTask["id"].toInt();
+        task.m_name = jsonTask["name"].toString().toStdString();
+
+        QJsonObject jsonParams = jsonTask["parameters"].toObject();
+        for(auto it=jsonParams.begin(); it!=jsonParams.end(); ++it)
+            task.m_params.insert(std::make_pair(it.key().toStdString(), it.value().toString().toStdString()));
+
+        tasks.push_back(std::move(task));
+    }
+
+    for(auto&& value : jsonWorkflow["edges"].toArray())
+    {
+        QJsonArray jsonEdge = value.toArray();
+        if(jsonEdge.size() != 4)
+            continue;
+
+        CEdgeRecord edge;
+        edge.m_srcId = jsonEdge[0].toInt();
+        edge.m_srcIndex = jsonEdge[1].toInt();
+        edge.m_targetId = jsonEdge[2].toInt();
+        edge.m_targetIndex = jsonEdge[3].toInt();
+        edges.push_back(edge);
+    }
+    return true;
+}
+
+void CWorkflowDBManager::execBatch(QSqlQuery &q, const QString &query, const QVector<QVariantList> &values)
+{
+    if(values.isEmpty() || values[0].isEmpty())
+        return;
+
+    if(!q.prepare(query))
+        throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
+
+    for(auto&& columnValues : values)
+        q.addBindValue(columnValues);
+
+    if(!q.execBatch())
+        throw CException(DatabaseExCode::INVALID_QUERY, q.lastError().text().toStdString(), __func__, __FILE__, __LINE__);
 }
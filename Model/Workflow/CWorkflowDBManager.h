@@ -27,6 +27,7 @@
 
 class CProcessManager;
 class CSettingsManager;
+class CIkomiaRegistry;
 class CGraphicsContext;
 using GraphicsContextPtr = std::shared_ptr<CGraphicsContext>;
 
@@ -49,20 +50,47 @@ class CWorkflowDBManager
 
         std::unique_ptr<CWorkflow>  load(int protocolId, CProcessManager* pProcessMgr, const GraphicsContextPtr& graphicsContextPtr);
         std::unique_ptr<CWorkflow>  load(QString path, CProcessManager* pProcessMgr, const GraphicsContextPtr& graphicsContextPtr);
+        std::unique_ptr<CWorkflow>  load(QString path, CIkomiaRegistry* pRegistry, const GraphicsContextPtr& graphicsContextPtr);
 
         void                        remove(int protocolId);
 
     private:
 
+        struct CTaskRecord
+        {
+            int         m_id = -1;
+            std::string m_name;
+            UMapString  m_params;
+        };
+
+        struct CEdgeRecord
+        {
+            int m_srcId = -1;
+            int m_srcIndex = 0;
+            int m_targetId = -1;
+            int m_targetIndex = 0;
+        };
+
+        using TaskRecords = std::vector<CTaskRecord>;
+        using EdgeRecords = std::vector<CEdgeRecord>;
+
         QSqlDatabase                initDB(const QString &path, const QString &connectionName);
 
         void                        createTables(QSqlDatabase &db);
 
-        UMapString                  getTaskParameters(QSqlDatabase &db, int taskId);
+        void                        getRecords(const WorkflowPtr &pWorkflow, int firstTaskId, TaskRecords& tasks, EdgeRecords& edges) const;
+        void                        loadRecords(QSqlDatabase &db, int protocolId, TaskRecords& tasks, EdgeRecords& edges);
+
+        QByteArray                  toBlob(const TaskRecords& tasks, const EdgeRecords& edges) const;
+        bool                        fromBlob(const QByteArray& blob, TaskRecords& tasks, EdgeRecords& edges) const;
+
+        void                        execBatch(QSqlQuery& q, const QString& query, const QVector<QVariantList>& values);
 
         int                         save(QSqlDatabase &db, const WorkflowPtr &pWorkflow);
 
-        std::unique_ptr<CWorkflow>  load(QSqlDatabase &db, int protocolId, CProcessManager* pProcessMgr, const GraphicsContextPtr& graphicsContextPtr);
+        std::unique_ptr<CWorkflow>  load(QSqlDatabase &db, int protocolId, CIkomiaRegistry* pRegistry, const GraphicsContextPtr& graphicsContextPtr);
+        std::unique_ptr<CWorkflow>  createWorkflow(const std::string& name, const TaskRecords& tasks, const EdgeRecords& edges,
+                                                   CIkomiaRegistry* pRegistry, const GraphicsContextPtr& graphicsContextPtr);
 
     private:
 
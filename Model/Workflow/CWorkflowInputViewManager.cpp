@@ -21,6 +21,7 @@
 #include "IO/CImageIO.h"
 #include "IO/CVideoIO.h"
 #include "Data/CDataConversion.h"
+#include "Model/Data/Image/CDisplayConversion.h"
 #include "CWorkflowInput.h"
 #include "Model/Project/CProjectManager.h"
 
@@ -221,7 +222,7 @@ void CWorkflowInputViewManager::manageImageInput(int index, const WorkflowTaskIO
         image = inPtr->getImage();
 
     //Emit signal to display input
-    emit doDisplayImage(index, nullptr, CDataConversion::CMatToQImage(image), QString::fromStdString(taskName), pViewProp);
+    emit doDisplayImage(index, nullptr, CDisplayConversion::toQImage(image), QString::fromStdString(taskName), pViewProp);
 }
 
 void CWorkflowInputViewManager::manageVideoInput(int index, const WorkflowTaskIOPtr &inputPtr, const std::string &taskName, CViewPropertyIO* pViewProp)
@@ -247,8 +248,8 @@ void CWorkflowInputViewManager::manageVideoInput(int index, const WorkflowTaskIO
     if(pItem->getTypeId() == TreeItemType::DATASET)
         modelIndex = m_pProjectMgr->getDatasetDataIndex(modelIndex, 0);
 
-    // Emit signal to display input
-    emit doDisplayVideo(modelIndex, index, nullptr, CDataConversion::CMatToQImage(image), QString::fromStdString(taskName), false, pViewProp);
+    // Emit signal to display input: video frames are reused, display needs a copy
+    emit doDisplayVideo(modelIndex, index, nullptr, CDisplayConversion::toQImage(image, false), QString::fromStdString(taskName), false, pViewProp);
     //Emit signal to initialize video info (fps...)
     emit doInitVideoInfo(modelIndex, index);
 }
@@ -263,7 +264,7 @@ void CWorkflowInputViewManager::manageVolumeInput(int index, const WorkflowTaskI
     }
 
     //Emit signal to update image input only. The 3D scene keeps displaying the result volume.
-    emit doUpdateVolumeImage(index, CDataConversion::CMatToQImage(inPtr->getImage()), QString::fromStdString(taskName), pViewProp);
+    emit doUpdateVolumeImage(index, CDisplayConversion::toQImage(inPtr->getImage()), QString::fromStdString(taskName), pViewProp);
 }
 
 void CWorkflowInputViewManager::manageGraphicsInput(const WorkflowTaskIOPtr &inputPtr)
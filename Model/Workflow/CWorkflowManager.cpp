@@ -91,7 +91,7 @@ void CWorkflowManager::setManagers(CProcessManager *pProcessMgr, CProjectManager
     m_pProgressMgr = pProgressMgr;
     m_pDataMgr = pDataMgr;
     m_pSettingsMgr = pSettingsMgr;
-    m_runMgr.setManagers(pProjectMgr, pDataMgr, pProgressMgr);
+    m_runMgr.setManagers(pProjectMgr, pDataMgr, pProgressMgr, pProcessMgr, pGraphicsMgr, pSettingsMgr);
     m_dbMgr.setManagers(pSettingsMgr);
     m_inputViewMgr.setManagers(pProjectMgr);
 
@@ -350,24 +350,7 @@ bool CWorkflowManager::isWorkflowRunning() const
 
 bool CWorkflowManager::isBatchInput(size_t index) const
 {
-    if(index >= m_inputs.size())
-        return false;
-
-    auto type = m_inputs[index].getType();
-    if(m_inputs[index].getModelIndicesCount() > 1)
-        return true;
-    else if(type == TreeItemType::DATASET)
-        return true;
-    else if(type == TreeItemType::FOLDER)
-    {
-        auto types = m_runMgr.getOriginTargetDataTypes(index);
-        if(types.empty() || types.find(IODataType::PROJECT_FOLDER) != types.end() || types.find(IODataType::FOLDER_PATH) != types.end())
-            return false;
-        else
-            return true;
-    }
-    else
-        return false;
+    return m_runMgr.isBatchInput(index);
 }
 
 void CWorkflowManager::createWorkflow(const std::string &name, const std::string &keywords, const std::string &description)
@@ -400,7 +383,11 @@ void CWorkflowManager::runWorkflow()
         return;
 
     if(m_runMgr.isRunning() == false)
+    {
         clearAllTasks();
+        if(runFromCache(m_pWorkflow->getAllChilds(m_pWorkflow->getRootId())))
+            return;
+    }
 
     m_protocolTimer.start();
     m_runMgr.run();
@@ -413,7 +400,15 @@ void CWorkflowManager::runWorkflowFromActiveTask()
 
     if(m_runMgr.isRunning() == false)
     {
-        clearFrom(m_pWorkflow->getActiveTaskId());
+        auto taskId = m_pWorkflow->getActiveTaskId();
+        clearFrom(taskId);
+
+        auto tasks = m_pWorkflow->getAllChilds(taskId);
+        tasks.insert(tasks.begin(), taskId);
+
+        if(runFromCache(tasks))
+            return;
+
         m_protocolTimer.start();
         m_runMgr.runFromActiveTask();
     }
@@ -689,6 +684,8 @@ void CWorkflowManager::onAllProcessReloaded()
         return;
 
     assert(m_pProcessMgr);
+    // Implementations may have changed
+    m_outputCache.clear();
     CPyEnsureGIL gil;
     auto rangeIt = m_pWorkflow->getVertices();
 
@@ -735,6 +732,7 @@ void CWorkflowManager::onProcessReloaded(const QString &name)
     auto newTaskPtr = m_pProcessMgr->createObject(taskPtr->getName(), nullptr);
     if(newTaskPtr)
     {
+        m_outputCache.clear();
         m_pWorkflow->replaceTask(newTaskPtr, taskId);
         if(m_pWorkflow->getActiveTaskId() == taskId)
             emit doUpdateTaskInfo(newTaskPtr, processInfo);
@@ -806,6 +804,11 @@ CWorkflowInputViewManager *CWorkflowManager::getInputViewManager()
     return &m_inputViewMgr;
 }
 
+CWorkflowProfiler *CWorkflowManager::getProfiler()
+{
+    return m_runMgr.getProfiler();
+}
+
 void CWorkflowManager::onApplyProcess(const QModelIndex &itemIndex, const std::string &processName, const WorkflowTaskParamPtr &pParam)
 {
     assert(m_pProcessMgr && m_pProjectMgr);
@@ -978,7 +981,11 @@ void CWorkflowManager::onRunWorkflowFinished()
     if(m_pWorkflow->isBatchMode())
     {
         if(m_bAutoLoadBatchResult)
-            m_pProjectMgr->onLoadFolder(QString::fromStdString(m_pWorkflow->getLastRunFolder()), currentModelIndex);
+        {
+            // Parallel batch: results are written by the worker workflows
+            for(auto&& folder : m_runMgr.getBatchRunFolders())
+                m_pProjectMgr->onLoadFolder(QString::fromStdString(folder), currentModelIndex);
+        }
     }
     else if(pTask && m_pResultsMgr)
     {
@@ -992,11 +999,13 @@ void CWorkflowManager::onRunWorkflowFinished()
         updateDataInfo();
         m_pResultsMgr->manageOutputs(pTask, taskId, currentModelIndex);
     }
+    m_runCacheKeys.clear();
     emit doWorkflowFinished();
 }
 
 void CWorkflowManager::onRunWorkflowFailed()
 {
+    m_runCacheKeys.clear();
     emit doWorkflowFailed();
 }
 
@@ -1382,7 +1391,15 @@ void CWorkflowManager::onFinishTask(const WorkflowVertex& id, CWorkflowTask::Sta
     updateExecTimeInfo(m_pWorkflow->getActiveTaskId());
 
     if(m_pWorkflow->isValid(id))
+    {
+        if(status == CWorkflowTask::State::VALIDATE)
+        {
+            auto it = m_runCacheKeys.find(id);
+            if(it != m_runCacheKeys.end())
+                m_outputCache.store(it->second, m_pWorkflow->getTask(id));
+        }
         emit doSetTaskState(id, status, msg);
+    }
 }
 
 void CWorkflowManager::onQueryGraphicsProxyModel()
@@ -1798,6 +1815,111 @@ void CWorkflowManager::clearTask(const WorkflowVertex& taskId)
     emit doSetTaskState(taskId, CWorkflowTask::State::UNDONE);
 }
 
+bool CWorkflowManager::runFromCache(const std::vector<WorkflowVertex> &tasks)
+{
+    assert(m_pWorkflow);
+    m_runCacheKeys.clear();
+
+    size_t maxMemory = m_pSettingsMgr ? m_pSettingsMgr->getWorkflowCacheMemory() : 0;
+    m_outputCache.setMaxMemory(maxMemory);
+
+    if(maxMemory == 0 || m_pWorkflow->isBatchMode() || tasks.empty())
+        return false;
+
+    m_runCacheKeys = m_outputCache.computeKeys(m_pWorkflow);
+
+    std::set<WorkflowVertex> misses;
+    for(auto&& id : tasks)
+    {
+        auto it = m_runCacheKeys.find(id);
+        if(it == m_runCacheKeys.end() || !m_outputCache.contains(it->second))
+            misses.insert(id);
+    }
+
+    // Tasks to run: the single missing task whose parents are all available, and its descendants
+    std::set<WorkflowVertex> runTasks;
+    WorkflowVertex startId = boost::graph_traits<WorkflowGraph>::null_vertex();
+
+    if(!misses.empty())
+    {
+        for(auto&& id : misses)
+        {
+            auto parents = m_pWorkflow->getParents(id);
+            bool bFrontier = std::none_of(parents.begin(), parents.end(), [&](const WorkflowVertex& parentId)
+            {
+                return misses.find(parentId) != misses.end();
+            });
+
+            if(bFrontier)
+            {
+                if(runTasks.empty() == false)
+                    return false;
+
+                startId = id;
+                auto childs = m_pWorkflow->getAllChilds(id);
+                runTasks.insert(childs.begin(), childs.end());
+                runTasks.insert(id);
+            }
+        }
+
+        for(auto&& id : misses)
+        {
+            if(runTasks.find(id) == runTasks.end())
+                return false;
+        }
+
+        // Nothing to reuse: regular run, outputs are still cached on completion
+        if(runTasks.size() >= tasks.size())
+            return false;
+    }
+
+    std::vector<WorkflowVertex> restoredTasks;
+    for(auto&& id : tasks)
+    {
+        if(runTasks.find(id) != runTasks.end())
+            continue;
+
+        // Already restored tasks are overwritten by the regular run
+        if(!m_outputCache.restore(m_runCacheKeys.at(id), m_pWorkflow->getTask(id)))
+            return false;
+
+        restoredTasks.push_back(id);
+    }
+
+    // Outputs are restored first so that inputs can be rebuilt in any order
+    for(auto&& id : restoredTasks)
+    {
+        restoreCachedInputs(id);
+        emit doSetTaskState(id, CWorkflowTask::State::VALIDATE);
+    }
+
+    qCInfo(logWorkflow).noquote() << tr("%1 task(s) restored from cache").arg(restoredTasks.size());
+    m_protocolTimer.start();
+
+    if(runTasks.empty())
+    {
+        m_runMgr.resetElapsedTime();
+        onRunWorkflowFinished();
+    }
+    else
+        m_runMgr.runFrom(startId);
+
+    return true;
+}
+
+void CWorkflowManager::restoreCachedInputs(const WorkflowVertex &taskId)
+{
+    auto taskPtr = m_pWorkflow->getTask(taskId);
+    auto inEdgeIt = m_pWorkflow->getInEdges(taskId);
+
+    for(auto it=inEdgeIt.first; it!=inEdgeIt.second; ++it)
+    {
+        auto edgePtr = m_pWorkflow->getEdge(*it);
+        auto srcTaskPtr = m_pWorkflow->getTask(m_pWorkflow->getEdgeSource(*it));
+        taskPtr->setInput(srcTaskPtr->getOutput(edgePtr->getSourceIndex()), edgePtr->getTargetIndex());
+    }
+}
+
 void CWorkflowManager::rootConnectionChanged()
 {
     for(size_t i=0; i<m_inputs.size(); ++i)
@@ -29,6 +29,7 @@
 #include "Model/User/CUser.h"
 #include "CWorkflowInputViewManager.h"
 #include "CWorkflowDBManager.h"
+#include "CWorkflowOutputCache.h"
 
 class CProcessManager;
 class CProjectManager;
@@ -59,6 +60,7 @@ class CWorkflowManager : public QObject
         WorkflowTaskPtr             getActiveTask() const;
         int                         getWorkflowDbId() const;
         CWorkflowInputViewManager*  getInputViewManager();
+        CWorkflowProfiler*          getProfiler();
         int                         getCurrentFPS() const;
         QModelIndex                 getCurrentVideoInputModelIndex() const;
         std::vector<int>            getDisplayedInputIndices(const WorkflowTaskPtr& taskPtr, const std::set<IODataType> &types) const;
@@ -266,6 +268,9 @@ class CWorkflowManager : public QObject
         void                        clearTo(const WorkflowVertex& taskId);
         void                        clearTask(const WorkflowVertex& taskId);
 
+        bool                        runFromCache(const std::vector<WorkflowVertex>& tasks);
+        void                        restoreCachedInputs(const WorkflowVertex& taskId);
+
         void                        checkInput(size_t index) const;
 
         void                        rootConnectionChanged();
@@ -303,6 +308,9 @@ class CWorkflowManager : public QObject
         WorkflowInputViewMode       m_inputViewMode = WorkflowInputViewMode::ORIGIN;
         int                         m_currentFPS = 0;
         bool                        m_bAutoLoadBatchResult = true;
+        CWorkflowOutputCache        m_outputCache;
+        // Keys of the tasks of the current interactive run, outputs are cached when they finish
+        CWorkflowOutputCache::TaskKeys  m_runCacheKeys;
 };
 
 #endif // CWORKFLOWMANAGER_H
@@ -0,0 +1,244 @@
+// Copyright (C) 2021 Ikomia SAS
+// Contact: https://www.ikomia.com
+//
+// This file is part of the IkomiaStudio software.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "CWorkflowOutputCache.h"
+#include <QCryptographicHash>
+#include <QFileInfo>
+#include <QDateTime>
+#include "IO/CImageIO.h"
+#include "IO/CPathIO.h"
+
+CWorkflowOutputCache::CWorkflowOutputCache()
+{
+    m_cache.setMaxCost(0);
+}
+
+void CWorkflowOutputCache::setMaxMemory(size_t maxMemory)
+{
+    // Memory in MB, 0 disables the cache
+    m_cache.setMaxCost((int)std::min<size_t>(maxMemory * 1024, INT_MAX));
+}
+
+size_t CWorkflowOutputCache::getMaxMemory() const
+{
+    return (size_t)m_cache.maxCost() / 1024;
+}
+
+size_t CWorkflowOutputCache::getMemory() const
+{
+    return (size_t)m_cache.totalCost() / 1024;
+}
+
+bool CWorkflowOutputCache::contains(const QByteArray &key) const
+{
+    return !key.isEmpty() && m_cache.contains(key);
+}
+
+CWorkflowOutputCache::TaskKeys CWorkflowOutputCache::computeKeys(const WorkflowPtr &workflowPtr) const
+{
+    TaskKeys keys;
+    if(workflowPtr == nullptr)
+        return keys;
+
+    std::vector<QByteArray> inputKeys;
+    for(size_t i=0; i<workflowPtr->getInputCount(); ++i)
+        inputKeys.push_back(computeIOKey(workflowPtr->getInput(i)));
+
+    auto vertexIt = workflowPtr->getVertices();
+    for(auto it=vertexIt.first; it!=vertexIt.second; ++it)
+    {
+        if(!workflowPtr->isRoot(*it))
+            computeTaskKey(workflowPtr, *it, inputKeys, keys);
+    }
+
+    // Empty keys mark uncacheable tasks during computation only
+    for(auto it=keys.begin(); it!=keys.end();)
+    {
+        if(it->second.isEmpty())
+            it = keys.erase(it);
+        else
+            ++it;
+    }
+    return keys;
+}
+
+void CWorkflowOutputCache::store(const QByteArray &key, const WorkflowTaskPtr &taskPtr)
+{
+    if(key.isEmpty() || taskPtr == nullptr || m_cache.maxCost() == 0)
+        return;
+
+    auto pEntry = new CEntry;
+    for(size_t i=0; i<taskPtr->getOutputCount(); ++i)
+    {
+        auto outputPtr = taskPtr->getOutput(i);
+        pEntry->m_outputs.push_back(outputPtr ? outputPtr->clone() : nullptr);
+    }
+    // Ownership is transferred, entry is deleted if it does not fit
+    m_cache.insert(key, pEntry, getCost(pEntry->m_outputs));
+}
+
+bool CWorkflowOutputCache::restore(const QByteArray &key, const WorkflowTaskPtr &taskPtr)
+{
+    if(key.isEmpty() || taskPtr == nullptr)
+        return false;
+
+    auto pEntry = m_cache.object(key);
+    if(pEntry == nullptr || pEntry->m_outputs.size() != taskPtr->getOutputCount())
+        return false;
+
+    // Cached data must stay untouched by downstream tasks
+    for(size_t i=0; i<pEntry->m_outputs.size(); ++i)
+    {
+        if(pEntry->m_outputs[i])
+            taskPtr->setOutput(pEntry->m_outputs[i]->clone(), i);
+    }
+    return true;
+}
+
+void CWorkflowOutputCache::clear()
+{
+    m_cache.clear();
+}
+
+QByteArray CWorkflowOutputCache::computeTaskKey(const WorkflowPtr &workflowPtr, const WorkflowVertex &id, const std::vector<QByteArray> &inputKeys, TaskKeys &keys) const
+{
+    auto it = keys.find(id);
+    if(it != keys.end())
+        return it->second;
+
+    // Mark as visited (and uncacheable until proven otherwise)
+    keys[id] = QByteArray();
+
+    auto taskPtr = workflowPtr->getTask(id);
+    // Tasks without output are run for their side effects (training, export...)
+    if(taskPtr == nullptr || taskPtr->getOutputCount() == 0)
+        return QByteArray();
+
+    std::map<size_t, QByteArray> inputMap;
+    auto inEdgeIt = workflowPtr->getInEdges(id);
+
+    for(auto edgeIt=inEdgeIt.first; edgeIt!=inEdgeIt.second; ++edgeIt)
+    {
+        auto edgePtr = workflowPtr->getEdge(*edgeIt);
+        auto srcId = workflowPtr->getEdgeSource(*edgeIt);
+        QByteArray srcKey;
+
+        if(workflowPtr->isRoot(srcId))
+        {
+            if(edgePtr->getSourceIndex() < inputKeys.size())
+                srcKey = inputKeys[edgePtr->getSourceIndex()];
+        }
+        else
+            srcKey = computeTaskKey(workflowPtr, srcId, inputKeys, keys);
+
+        if(srcKey.isEmpty())
+            return QByteArray();
+
+        inputMap[edgePtr->getTargetIndex()] = srcKey + QByteArray::number((qulonglong)edgePtr->getSourceIndex());
+    }
+
+    // Unconnected inputs (graphics from the user for example) are not part of the key
+    if(inputMap.size() != taskPtr->getInputCount())
+        return QByteArray();
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(QByteArray::fromStdString(taskPtr->getName()));
+
+    // Parameter map is unordered
+    auto paramMap = taskPtr->getParam()->getParamMap();
+    std::map<std::string, std::string> sortedParams(paramMap.begin(), paramMap.end());
+
+    for(auto&& param : sortedParams)
+    {
+        hash.addData(QByteArray::fromStdString(param.first));
+        hash.addData("=", 1);
+        hash.addData(QByteArray::fromStdString(param.second));
+        hash.addData(";", 1);
+    }
+
+    for(auto&& input : inputMap)
+    {
+        hash.addData(QByteArray::number((qulonglong)input.first));
+        hash.addData(input.second);
+    }
+
+    auto key = hash.result();
+    keys[id] = key;
+    return key;
+}
+
+QByteArray CWorkflowOutputCache::computeIOKey(const WorkflowTaskIOPtr &ioPtr) const
+{
+    if(ioPtr == nullptr)
+        return QByteArray();
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+
+    auto imageIOPtr = std::dynamic_pointer_cast<CImageIO>(ioPtr);
+    if(imageIOPtr)
+    {
+        CMat image = imageIOPtr->getImage();
+        if(image.empty())
+            return QByteArray();
+
+        if(!image.isContinuous())
+            image = image.clone();
+
+        hash.addData("image", 5);
+        hash.addData(QByteArray::number(image.type()));
+        for(int i=0; i<image.dims; ++i)
+            hash.addData(QByteArray::number(image.size[i]));
+
+        hash.addData(reinterpret_cast<const char*>(image.data), (int)(image.total() * image.elemSize()));
+        return hash.result();
+    }
+
+    auto pathIOPtr = std::dynamic_pointer_cast<CPathIO>(ioPtr);
+    if(pathIOPtr)
+    {
+        // File content is identified by its modification time and size.
+        // Folder content can't be checked cheaply: not cached
+        QFileInfo info(QString::fromStdString(pathIOPtr->getPath()));
+        if(info.isFile() == false)
+            return QByteArray();
+
+        hash.addData("path", 4);
+        hash.addData(QByteArray::fromStdString(pathIOPtr->getPath()));
+        hash.addData(QByteArray::number(info.lastModified().toMSecsSinceEpoch()));
+        hash.addData(QByteArray::number(info.size()));
+        return hash.result();
+    }
+    // Video, stream and other inputs are not addressable by content
+    return QByteArray();
+}
+
+int CWorkflowOutputCache::getCost(const std::vector<WorkflowTaskIOPtr> &outputs) const
+{
+    size_t size = 0;
+    for(auto&& outputPtr : outputs)
+    {
+        auto imageIOPtr = std::dynamic_pointer_cast<CImageIO>(outputPtr);
+        if(imageIOPtr)
+        {
+            CMat image = imageIOPtr->getImage();
+            size += image.total() * image.elemSize();
+        }
+    }
+    // Non image outputs are accounted 1 KB
+    return (int)std::min<size_t>(std::max<size_t>(1, size / 1024 + outputs.size()), INT_MAX);
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2021 Ikomia SAS
+ * Contact: https://www.ikomia.com
+ *
+ * This file is part of the IkomiaStudio software.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CWORKFLOWOUTPUTCACHE_H
+#define CWORKFLOWOUTPUTCACHE_H
+
+#include <QCache>
+#include <QByteArray>
+#include "Core/CWorkflow.h"
+
+// Task outputs of previous interactive runs, addressed by a hash of task name,
+// parameters and upstream content. Least recently used entries are evicted first.
+class CWorkflowOutputCache
+{
+    public:
+
+        using TaskKeys = std::unordered_map<WorkflowVertex, QByteArray>;
+
+        CWorkflowOutputCache();
+
+        void        setMaxMemory(size_t maxMemory);
+
+        size_t      getMaxMemory() const;
+        size_t      getMemory() const;
+
+        bool        contains(const QByteArray& key) const;
+
+        TaskKeys    computeKeys(const WorkflowPtr& workflowPtr) const;
+
+        void        store(const QByteArray& key, const WorkflowTaskPtr& taskPtr);
+        bool        restore(const QByteArray& key, const WorkflowTaskPtr& taskPtr);
+
+        void        clear();
+
+    private:
+
+        struct CEntry
+        {
+            std::vector<WorkflowTaskIOPtr>  m_outputs;
+        };
+
+        QByteArray  computeTaskKey(const WorkflowPtr& workflowPtr, const WorkflowVertex& id, const std::vector<QByteArray>& inputKeys, TaskKeys& keys) const;
+        QByteArray  computeIOKey(const WorkflowTaskIOPtr& ioPtr) const;
+
+        int         getCost(const std::vector<WorkflowTaskIOPtr>& outputs) const;
+
+    private:
+
+        // Cost unit is KB
+        QCache<QByteArray, CEntry>  m_cache;
+};
+
+#endif // CWORKFLOWOUTPUTCACHE_H
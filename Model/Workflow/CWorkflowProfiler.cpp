@@ -0,0 +1,303 @@
+// Copyright (C) 2021 Ikomia SAS
+// Contact: https://www.ikomia.com
+//
+// This file is part of the IkomiaStudio software.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "CWorkflowProfiler.h"
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include "Main/LogCategory.h"
+#include "IO/CImageIO.h"
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#include <psapi.h>
+#elif defined(Q_OS_MACOS)
+#include <mach/mach.h>
+#include <sys/resource.h>
+#endif
+
+// Batch item processed by the current thread
+static thread_local int s_currentItem = -1;
+
+CWorkflowProfiler::CWorkflowProfiler()
+{
+    m_clock.start();
+}
+
+void CWorkflowProfiler::setCurrentItem(int index)
+{
+    s_currentItem = index;
+}
+
+void CWorkflowProfiler::setEnabled(bool bEnabled)
+{
+    m_bEnabled = bEnabled;
+}
+
+bool CWorkflowProfiler::isEnabled() const
+{
+    return m_bEnabled;
+}
+
+std::vector<CTaskExecRecord> CWorkflowProfiler::getRecords(size_t maxCount) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t first = 0;
+
+    if(maxCount > 0 && m_records.size() > maxCount)
+        first = m_records.size() - maxCount;
+
+    return std::vector<CTaskExecRecord>(m_records.begin() + (std::ptrdiff_t)first, m_records.end());
+}
+
+std::vector<QString> CWorkflowProfiler::getThreadNames() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<QString> names(m_threads.size());
+
+    for(auto&& it : m_threads)
+        names[it.second] = tr("Thread %1").arg(it.second);
+
+    return names;
+}
+
+QString CWorkflowProfiler::getRunTypeName(int type)
+{
+    switch(type)
+    {
+        case SINGLE: return "single";
+        case LIVE: return "live";
+        case BATCH: return "batch";
+        case SEQUENTIAL: return "sequential";
+        default: return "unknown";
+    }
+}
+
+void CWorkflowProfiler::attach(const WorkflowPtr &workflowPtr)
+{
+    if(workflowPtr == nullptr)
+        return;
+
+    // Direct connection: the record is taken on the thread that executed the task.
+    // Weak pointer because the signal handler is owned by the workflow itself.
+    std::weak_ptr<CWorkflow> weakPtr = workflowPtr;
+    auto pSignal = static_cast<CWorkflowSignalHandler*>(workflowPtr->getSignalRawPtr());
+    connect(pSignal, &CWorkflowSignalHandler::doFinishTask, this, [this, weakPtr](const WorkflowVertex& id, CWorkflowTask::State state, const QString&)
+    {
+        if(!m_bEnabled)
+            return;
+
+        auto workflowPtr = weakPtr.lock();
+        if(workflowPtr)
+            record(workflowPtr, id, state);
+    }, Qt::DirectConnection);
+}
+
+void CWorkflowProfiler::beginRun(RunType type)
+{
+    m_runType = type;
+    m_runId++;
+}
+
+void CWorkflowProfiler::endRun()
+{
+    if(m_bEnabled)
+        emit doRecordsChanged();
+}
+
+void CWorkflowProfiler::clear()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_records.clear();
+        m_threads.clear();
+    }
+    emit doRecordsChanged();
+}
+
+bool CWorkflowProfiler::exportChromeTrace(const QString &path) const
+{
+    // Trace Event Format: complete events ("X") per task, counter events ("C") for memory
+    auto records = getRecords();
+    auto threadNames = getThreadNames();
+    QJsonArray events;
+
+    for(size_t i=0; i<threadNames.size(); ++i)
+    {
+        QJsonObject args;
+        args["name"] = threadNames[i];
+
+        QJsonObject event;
+        event["name"] = "thread_name";
+        event["ph"] = "M";
+        event["pid"] = 1;
+        event["tid"] = (int)i;
+        event["args"] = args;
+        events.append(event);
+    }
+
+    for(auto&& record : records)
+    {
+        QJsonObject args;
+        args["run"] = record.m_runId;
+        args["state"] = record.m_state;
+        args["input_bytes"] = (qint64)record.m_inputBytes;
+        args["inputs"] = record.m_inputShapes;
+        args["memory_mb"] = (double)record.m_memory / (1024.0 * 1024.0);
+        args["peak_memory_mb"] = (double)record.m_peakMemory / (1024.0 * 1024.0);
+
+        if(record.m_itemIndex >= 0)
+            args["item"] = record.m_itemIndex;
+
+        QJsonObject event;
+        event["name"] = record.m_taskName;
+        event["cat"] = getRunTypeName(record.m_runType);
+        event["ph"] = "X";
+        event["ts"] = record.m_start;
+        event["dur"] = record.m_end - record.m_start;
+        event["pid"] = 1;
+        event["tid"] = record.m_threadIndex;
+        event["args"] = args;
+        events.append(event);
+
+        QJsonObject memoryArgs;
+        memoryArgs["resident_mb"] = (double)record.m_memory / (1024.0 * 1024.0);
+
+        QJsonObject memoryEvent;
+        memoryEvent["name"] = "Memory";
+        memoryEvent["ph"] = "C";
+        memoryEvent["ts"] = record.m_end;
+        memoryEvent["pid"] = 1;
+        memoryEvent["args"] = memoryArgs;
+        events.append(memoryEvent);
+    }
+
+    QJsonObject root;
+    root["traceEvents"] = events;
+    root["displayTimeUnit"] = "ms";
+
+    QFile file(path);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        qCCritical(logWorkflow).noquote() << tr("Unable to write trace file %1").arg(path);
+        return false;
+    }
+
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    return true;
+}
+
+void CWorkflowProfiler::record(const WorkflowPtr &workflowPtr, const WorkflowVertex &id, CWorkflowTask::State state)
+{
+    auto taskPtr = workflowPtr->getTask(id);
+    if(taskPtr == nullptr)
+        return;
+
+    CTaskExecRecord record;
+    record.m_end = m_clock.nsecsElapsed() / 1000;
+    // Task elapsed time is in ms
+    record.m_start = record.m_end - (qint64)(taskPtr->getElapsedTime() * 1000.0);
+    record.m_taskName = QString::fromStdString(taskPtr->getName());
+    record.m_taskId = std::hash<WorkflowVertex>()(id);
+    record.m_runId = m_runId;
+    record.m_runType = m_runType;
+    record.m_itemIndex = s_currentItem;
+    record.m_state = static_cast<int>(state);
+
+    QStringList shapes;
+    for(size_t i=0; i<taskPtr->getInputCount(); ++i)
+    {
+        auto imageIOPtr = std::dynamic_pointer_cast<CImageIO>(taskPtr->getInput(i));
+        if(imageIOPtr == nullptr)
+            continue;
+
+        CMat image = imageIOPtr->getImage();
+        if(image.data == nullptr)
+            continue;
+
+        QStringList dims;
+        for(int j=0; j<image.dims; ++j)
+            dims.append(QString::number(image.size[j]));
+
+        dims.append(QString::number(image.channels()));
+        shapes.append(dims.join('x'));
+        record.m_inputBytes += image.total() * image.elemSize();
+    }
+    record.m_inputShapes = shapes.join(' ');
+    getProcessMemory(record.m_memory, record.m_peakMemory);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    record.m_threadIndex = getThreadIndex();
+    m_records.push_back(record);
+
+    if(m_records.size() > m_maxRecords)
+        m_records.pop_front();
+}
+
+int CWorkflowProfiler::getThreadIndex()
+{
+    // Called with m_mutex locked
+    auto handle = QThread::currentThreadId();
+    auto it = m_threads.find(handle);
+
+    if(it != m_threads.end())
+        return it->second;
+
+    int index = (int)m_threads.size();
+    m_threads.insert(std::make_pair(handle, index));
+    return index;
+}
+
+void CWorkflowProfiler::getProcessMemory(size_t &current, size_t &peak)
+{
+    current = 0;
+    peak = 0;
+
+#if defined(Q_OS_LINUX)
+    // Resident size and its high water mark, in kB
+    QFile file("/proc/self/status");
+    if(!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        return;
+
+    QTextStream stream(&file);
+    QString line;
+    while(stream.readLineInto(&line))
+    {
+        if(line.startsWith("VmRSS:"))
+            current = line.mid(6).trimmed().section(' ', 0, 0).toULongLong() * 1024;
+        else if(line.startsWith("VmHWM:"))
+            peak = line.mid(6).trimmed().section(' ', 0, 0).toULongLong() * 1024;
+    }
+#elif defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS counters;
+    if(GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    {
+        current = counters.WorkingSetSize;
+        peak = counters.PeakWorkingSetSize;
+    }
+#elif defined(Q_OS_MACOS)
+    mach_task_basic_info info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if(task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info, &count) == KERN_SUCCESS)
+        current = info.resident_size;
+
+    // Bytes on macOS
+    struct rusage usage;
+    if(getrusage(RUSAGE_SELF, &usage) == 0)
+        peak = usage.ru_maxrss;
+#endif
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2021 Ikomia SAS
+ * Contact: https://www.ikomia.com
+ *
+ * This file is part of the IkomiaStudio software.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CWORKFLOWPROFILER_H
+#define CWORKFLOWPROFILER_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <deque>
+#include <mutex>
+#include "Core/CWorkflow.h"
+
+// One task execution. Times are in microseconds from profiler creation, memory in bytes.
+struct CTaskExecRecord
+{
+    QString     m_taskName;
+    size_t      m_taskId = 0;
+    int         m_runId = 0;
+    int         m_runType = 0;
+    // Batch item index, -1 outside batch runs
+    int         m_itemIndex = -1;
+    int         m_threadIndex = 0;
+    int         m_state = 0;
+    qint64      m_start = 0;
+    qint64      m_end = 0;
+    size_t      m_inputBytes = 0;
+    QString     m_inputShapes;
+    size_t      m_memory = 0;
+    size_t      m_peakMemory = 0;
+};
+
+class CWorkflowProfiler : public QObject
+{
+    Q_OBJECT
+
+    public:
+
+        enum RunType : int
+        {
+            SINGLE,
+            LIVE,
+            BATCH,
+            SEQUENTIAL
+        };
+
+        CWorkflowProfiler();
+
+        static void                     setCurrentItem(int index);
+
+        void                            setEnabled(bool bEnabled);
+
+        bool                            isEnabled() const;
+
+        // Last maxCount records, all of them if 0
+        std::vector<CTaskExecRecord>    getRecords(size_t maxCount=0) const;
+        std::vector<QString>            getThreadNames() const;
+        static QString                  getRunTypeName(int type);
+
+        void                            attach(const WorkflowPtr& workflowPtr);
+
+        void                            beginRun(RunType type);
+        void                            endRun();
+
+        void                            clear();
+
+        bool                            exportChromeTrace(const QString& path) const;
+
+    signals:
+
+        void                            doRecordsChanged();
+
+    private:
+
+        void                            record(const WorkflowPtr& workflowPtr, const WorkflowVertex& id, CWorkflowTask::State state);
+
+        int                             getThreadIndex();
+
+        static void                     getProcessMemory(size_t& current, size_t& peak);
+
+    private:
+
+        const size_t                    m_maxRecords = 200000;
+        QElapsedTimer                   m_clock;
+        mutable std::mutex              m_mutex;
+        std::deque<CTaskExecRecord>     m_records;
+        std::map<Qt::HANDLE, int>       m_threads;
+        std::atomic_bool                m_bEnabled{false};
+        std::atomic_int                 m_runId{0};
+        std::atomic_int                 m_runType{SINGLE};
+};
+
+#endif // CWORKFLOWPROFILER_H
@@ -22,11 +22,16 @@
 #include "Model/Project/CProjectManager.h"
 #include "Model/Data/CMainDataManager.h"
 #include "Model/ProgressBar/CProgressBarManager.h"
+#include "Model/Process/CProcessManager.h"
+#include "Model/Graphics/CGraphicsManager.h"
+#include "Model/Settings/CSettingsManager.h"
 #include "IO/CPathIO.h"
 
 CWorkflowRunManager::CWorkflowRunManager(CWorkflowInputs *pInputs)
 {
     m_pInputs = pInputs;
+    // Worker instances must be released from the GUI thread
+    connect(&m_processWatcher, &QFutureWatcher<void>::finished, this, &CWorkflowRunManager::onBatchFinished);
 }
 
 CWorkflowRunManager::~CWorkflowRunManager()
@@ -36,11 +41,15 @@ CWorkflowRunManager::~CWorkflowRunManager()
     waitForWorkflow();
 }
 
-void CWorkflowRunManager::setManagers(CProjectManager *pProjectMgr, CMainDataManager* pDataMgr, CProgressBarManager *pProgressMgr)
+void CWorkflowRunManager::setManagers(CProjectManager *pProjectMgr, CMainDataManager* pDataMgr, CProgressBarManager *pProgressMgr,
+                                      CProcessManager* pProcessMgr, CGraphicsManager* pGraphicsMgr, CSettingsManager* pSettingsMgr)
 {
     m_pProjectMgr = pProjectMgr;
     m_pDataMgr = pDataMgr;
     m_pProgressMgr = pProgressMgr;
+    m_pProcessMgr = pProcessMgr;
+    m_pGraphicsMgr = pGraphicsMgr;
+    m_pSettingsMgr = pSettingsMgr;
     connect(this, &CWorkflowRunManager::doAbortProgressBar, m_pProgressMgr, &CProgressBarManager::onAbortProgressBar);
 }
 
@@ -52,6 +61,7 @@ void CWorkflowRunManager::setWorkflow(WorkflowPtr WorkflowPtr)
         auto pWorkflowSignal = static_cast<CWorkflowSignalHandler*>(m_workflowPtr->getSignalRawPtr());
         connect(pWorkflowSignal, &CWorkflowSignalHandler::doSetElapsedTime, this, &CWorkflowRunManager::onSetElapsedTime);
         connect(pWorkflowSignal, &CWorkflowSignalHandler::doFinishWorkflow, this, &CWorkflowRunManager::onWorkflowFinished);
+        m_profiler.attach(m_workflowPtr);
     }
 }
 
@@ -60,11 +70,46 @@ double CWorkflowRunManager::getTotalElapsedTime() const
     return m_totalElapsedTime;
 }
 
+std::vector<std::string> CWorkflowRunManager::getBatchRunFolders() const
+{
+    if(m_batchRunFolders.empty() == false)
+        return m_batchRunFolders;
+
+    return {m_workflowPtr->getLastRunFolder()};
+}
+
+CWorkflowProfiler *CWorkflowRunManager::getProfiler()
+{
+    return &m_profiler;
+}
+
 bool CWorkflowRunManager::isRunning() const
 {
     return m_bRunning;
 }
 
+bool CWorkflowRunManager::isBatchInput(size_t index) const
+{
+    if(index >= m_pInputs->size())
+        return false;
+
+    auto type = m_pInputs->at(index).getType();
+    if(m_pInputs->at(index).getModelIndicesCount() > 1)
+        return true;
+    else if(type == TreeItemType::DATASET)
+        return true;
+    else if(type == TreeItemType::FOLDER)
+    {
+        auto types = getOriginTargetDataTypes(index);
+        if(types.empty() || types.find(IODataType::PROJECT_FOLDER) != types.end() || types.find(IODataType::FOLDER_PATH) != types.end())
+            return false;
+        else
+            return true;
+    }
+    else
+        return false;
+}
+
 std::vector<std::string> CWorkflowRunManager::getVideoInputPaths() const
 {
     std::vector<std::string> paths;
@@ -304,6 +349,7 @@ void CWorkflowRunManager::run()
 
     m_bRunning = true;
     m_bStop = false;
+    m_profiler.beginRun(m_workflowPtr->isBatchMode() ? CWorkflowProfiler::BATCH : CWorkflowProfiler::SINGLE);
 
     if(m_workflowPtr->isBatchMode())
         runBatch();
@@ -323,6 +369,7 @@ void CWorkflowRunManager::runLive(size_t inputIndex)
     {
         m_liveInputIndex = inputIndex;
         m_bStopThread = false;
+        m_profiler.beginRun(CWorkflowProfiler::LIVE);
 
         auto protocolThread = QtConcurrent::run([&]
         {
@@ -368,11 +415,27 @@ void CWorkflowRunManager::runFromActiveTask()
 
     m_bRunning = true;
     m_bStop = false;
+    m_profiler.beginRun(m_workflowPtr->isBatchMode() ? CWorkflowProfiler::BATCH : CWorkflowProfiler::SINGLE);
 
     if(m_workflowPtr->isBatchMode())
         runFromBatch();
     else
-        runFromSingle();
+        runFromSingle(m_workflowPtr->getActiveTaskId());
+}
+
+void CWorkflowRunManager::runFrom(const WorkflowVertex &taskId)
+{
+    if(m_bRunning)
+    {
+        qCWarning(logWorkflow).noquote() << "Workflow is already running...";
+        return;
+    }
+
+    // Interactive runs only: batch runs always start from the active task
+    m_bRunning = true;
+    m_bStop = false;
+    m_profiler.beginRun(CWorkflowProfiler::SINGLE);
+    runFromSingle(taskId);
 }
 
 void CWorkflowRunManager::runToActiveTask()
@@ -391,6 +454,8 @@ void CWorkflowRunManager::runToActiveTask()
     if(m_workflowPtr->isRoot(taskId))
         return;
 
+    m_profiler.beginRun(m_workflowPtr->isBatchMode() ? CWorkflowProfiler::BATCH : CWorkflowProfiler::SINGLE);
+
      if(m_workflowPtr->isBatchMode())
          runToBatch();
      else
@@ -413,6 +478,7 @@ void CWorkflowRunManager::runSequentialTask(const WorkflowVertex &taskId)
     }
 
     m_bRunning = true;
+    m_profiler.beginRun(CWorkflowProfiler::SEQUENTIAL);
     //Thread watcher -> protocol manager
     m_pSequentialRunWatcher = new QFutureWatcher<void>;
     connect(m_pSequentialRunWatcher, &QFutureWatcher<void>::finished, this, &CWorkflowRunManager::onSequentialRunFinished);
@@ -447,6 +513,11 @@ void CWorkflowRunManager::addSequentialRun(const WorkflowVertex& taskId)
     m_sequentialRuns.push_back(taskId);
 }
 
+void CWorkflowRunManager::resetElapsedTime()
+{
+    m_totalElapsedTime = 0;
+}
+
 void CWorkflowRunManager::notifyGraphicsChanged()
 {
     if(m_workflowPtr == nullptr)
@@ -481,6 +552,11 @@ void CWorkflowRunManager::stop()
         {
             m_bStop = true;
             m_workflowPtr->stop();
+
+            for(auto&& worker : m_batchWorkers)
+                worker.m_workflowPtr->stop();
+
+            m_prefetcher.cancel();
         }
         catch(const std::exception& e)
         {
@@ -548,6 +624,7 @@ void CWorkflowRunManager::workflowErrorHandling(const std::exception &e)
     auto pWorkflowSignal = static_cast<CWorkflowSignalHandler*>(m_workflowPtr->getSignalRawPtr());
     emit pWorkflowSignal->doFinishTask(m_workflowPtr->getRunningTaskId(), CWorkflowTask::State::_ERROR, msg);
     emit doWorkflowFailed();
+    m_profiler.endRun();
     qCCritical(logWorkflow).noquote() << msg;
 }
 
@@ -569,8 +646,12 @@ void CWorkflowRunManager::batchErrorHandling(const std::exception &e)
         msg = QString(e.what());
     }
     qCCritical(logWorkflow).noquote() << msg;
-    restoreBatchConfig();
     m_bStop = true;
+
+    // Other workers stop at their next task, batch configuration is restored
+    // in onWorkflowFinished() once they are all joined
+    for(auto&& worker : m_batchWorkers)
+        worker.m_workflowPtr->stop();
 }
 
 void CWorkflowRunManager::onSetElapsedTime(double time)
@@ -586,6 +667,8 @@ void CWorkflowRunManager::onSequentialRunFinished()
     assert(m_sequentialRuns.size()>0);
     m_sequentialRuns.pop_front();
 
+    m_profiler.endRun();
+
     if(m_sequentialRuns.empty() == false)
         runSequentialTask(m_sequentialRuns.front());
     else
@@ -594,23 +677,67 @@ void CWorkflowRunManager::onSequentialRunFinished()
 
 void CWorkflowRunManager::onWorkflowFinished()
 {
-    if(!m_workflowPtr->isBatchMode() || m_batchIndex == m_batchCount - 1 || m_bStop)
+    size_t batchIndex = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_batchMutex);
+        batchIndex = m_batchIndex;
+    }
+
+    if(!m_workflowPtr->isBatchMode() || batchIndex == m_batchCount - 1 || m_bStop)
     {
         m_bRunning = false;
         m_workflowPtr->workflowFinished();
+        m_profiler.endRun();
         emit doWorkflowFinished();
         restoreBatchConfig();
     }
 }
 
-void CWorkflowRunManager::setBatchInput(int index)
+void CWorkflowRunManager::onBatchFinished()
 {
-    for (size_t i=0; i<m_pInputs->size(); ++i)
+    m_batchWorkers.clear();
+    m_batchDone.clear();
+}
+
+bool CWorkflowRunManager::setBatchInput(int index)
+{
+    return setBatchInput(m_workflowPtr, index);
+}
+
+bool CWorkflowRunManager::setBatchInput(const WorkflowPtr &workflowPtr, size_t index)
+{
+    // Batch stopped meanwhile: workers must not fall back to inline loading
+    if(m_bStop || m_prefetcher.isStopped())
+        return false;
+
+    CBatchInputPrefetcher::BatchInputs inputs;
+    if(m_prefetcher.isActive())
     {
-        auto inputPtr = createTaskIO(i, index, true);
-        if (inputPtr)
-            m_workflowPtr->setInput(inputPtr, i, true);
+        if(!m_prefetcher.take(index, inputs))
+            return false;
     }
+    else
+        inputs = loadBatchInputs(index);
+
+    for (size_t i=0; i<inputs.size(); ++i)
+    {
+        if (inputs[i])
+            workflowPtr->setInput(inputs[i], i, true);
+    }
+    return true;
+}
+
+CBatchInputPrefetcher::BatchInputs CWorkflowRunManager::loadBatchInputs(size_t index)
+{
+    // Project model and data managers are not designed for concurrent access:
+    // input creation is serialized, workflow execution is not
+    std::lock_guard<std::mutex> lock(m_batchInputMutex);
+    CBatchInputPrefetcher::BatchInputs inputs;
+
+    for (size_t i=0; i<m_pInputs->size(); ++i)
+        inputs.push_back(createTaskIO(i, index, true));
+
+    return inputs;
 }
 
 std::set<IODataType> CWorkflowRunManager::getTargetDataTypes(size_t inputIndex) const
@@ -1164,136 +1291,207 @@ bool CWorkflowRunManager::checkFolderInputs(size_t index1, size_t index2, std::s
 
 void CWorkflowRunManager::runBatch()
 {
-    auto lambdaRun = [&]
+    auto runFunc = [](const WorkflowPtr& workflowPtr, const WorkflowVertex&)
     {
-        m_batchIndex = 0;
-        m_totalElapsedTime = 0;
-        m_workflowPtr->updateStartTime();
-        m_workflowPtr->workflowStarted();
+        workflowPtr->run();
+    };
+    runBatchGeneric(runFunc, m_workflowPtr->getRootId());
+}
 
-        for(size_t i=0; i<m_batchCount && !m_bStop; ++i)
-        {
-            try
-            {
-                setBatchInput(i);
-                m_batchIndex = i;
-                m_workflowPtr->clearAllOutputData();
-                m_workflowPtr->run();
-            }
-            catch(std::exception& e)
-            {
-                batchErrorHandling(e);
-            }
-        }
+void CWorkflowRunManager::runFromBatch()
+{
+    auto id = m_workflowPtr->getActiveTaskId();
+    if(m_workflowPtr->getTask(id) == nullptr)
+    {
+        m_bRunning = false;
+        qCCritical(logWorkflow).noquote() << tr("Invalid workflow current task");
+        return;
+    }
 
-        if(m_bStop)
-            onWorkflowFinished();
+    auto runFunc = [](const WorkflowPtr& workflowPtr, const WorkflowVertex& taskId)
+    {
+        workflowPtr->runFrom(taskId);
     };
+    runBatchGeneric(runFunc, id);
+}
+
+void CWorkflowRunManager::runToBatch()
+{
+    auto id = m_workflowPtr->getActiveTaskId();
+    if(m_workflowPtr->getTask(id) == nullptr)
+    {
+        m_bRunning = false;
+        qCCritical(logWorkflow).noquote() << tr("Invalid workflow current task");
+        return;
+    }
 
-    runBatchGeneric(lambdaRun);
+    auto runFunc = [](const WorkflowPtr& workflowPtr, const WorkflowVertex& taskId)
+    {
+        workflowPtr->runTo(taskId);
+    };
+    runBatchGeneric(runFunc, id);
 }
 
-void CWorkflowRunManager::runFromBatch()
+void CWorkflowRunManager::runBatchGeneric(const BatchRunFunc& runFunc, const WorkflowVertex& taskId)
 {
-    auto lambdaRun = [&]
+    std::string erroMsg;
+    if(!checkInputs(erroMsg))
     {
-        m_batchIndex = 0;
-        m_totalElapsedTime = 0;
-        auto id = m_workflowPtr->getActiveTaskId();
-        auto taskPtr = m_workflowPtr->getTask(id);
+        m_bRunning = false;
+        qCCritical(logWorkflow) << QString::fromStdString(erroMsg);
+        return;
+    }
 
-        if(taskPtr == nullptr)
-        {
-            qCCritical(logWorkflow).noquote() << tr("Invalid workflow current task");
-            return;
-        }
+    m_batchCount = getBatchCount();
+    if(m_batchCount == 0)
+    {
+        m_bRunning = false;
+        return;
+    }
+
+    prepareBatchConfig();
 
-        m_workflowPtr->workflowStarted();
-        m_workflowPtr->updateStartTime();
+    // Whole video processing relies on workflow signals: keep it sequential
+    bool bVideo = getVideoInputPaths().empty() == false;
+    if(!bVideo)
+        startBatchPrefetch();
 
-        for(size_t i=0; i<m_batchCount && !m_bStop; ++i)
+    size_t workerCount = std::min(getBatchWorkerCount(), m_batchCount);
+    if(workerCount > 1 && !bVideo)
+    {
+        try
         {
-            try
-            {
-                setBatchInput(i);
-                m_batchIndex = i;
-                m_workflowPtr->clearAllOutputData();
-                m_workflowPtr->runFrom(id);
-            }
-            catch(std::exception& e)
-            {
-                batchErrorHandling(e);
-            }
+            createBatchWorkers(workerCount);
+        }
+        catch(std::exception& e)
+        {
+            m_batchWorkers.clear();
+            qCWarning(logWorkflow).noquote() << tr("Parallel batch disabled: %1").arg(QString::fromStdString(e.what()));
         }
+    }
 
-        if(m_bStop)
-            onWorkflowFinished();
-    };
+    QFuture<void> future;
+    if(m_batchWorkers.size() > 1)
+        future = QtConcurrent::run([this, runFunc, taskId]{ runBatchParallel(runFunc, taskId); });
+    else
+        future = QtConcurrent::run([this, runFunc, taskId]{ runBatchSequential(runFunc, taskId); });
 
-    runBatchGeneric(lambdaRun);
+    m_processWatcher.setFuture(future);
+    m_sync.setFuture(future);
 }
 
-void CWorkflowRunManager::runToBatch()
+void CWorkflowRunManager::runBatchSequential(const BatchRunFunc& runFunc, const WorkflowVertex& taskId)
 {
-    auto lambdaRun = [&]
     {
+        std::lock_guard<std::mutex> lock(m_batchMutex);
         m_batchIndex = 0;
-        m_totalElapsedTime = 0;
-        auto id = m_workflowPtr->getActiveTaskId();
-        auto taskPtr = m_workflowPtr->getTask(id);
+    }
+    m_batchRunFolders.clear();
+    m_totalElapsedTime = 0;
+    m_workflowPtr->updateStartTime();
+    m_workflowPtr->workflowStarted();
 
-        if(taskPtr == nullptr)
+    for(size_t i=0; i<m_batchCount && !m_bStop; ++i)
+    {
+        try
         {
-            qCCritical(logWorkflow).noquote() << tr("Invalid workflow current task");
-            return;
-        }
+            if(!setBatchInput(i))
+                break;
 
-        m_workflowPtr->workflowStarted();
-        m_workflowPtr->updateStartTime();
-
-        for(size_t i=0; i<m_batchCount && !m_bStop; ++i)
-        {
-            try
             {
-                setBatchInput(i);
+                std::lock_guard<std::mutex> lock(m_batchMutex);
                 m_batchIndex = i;
-                m_workflowPtr->clearAllOutputData();
-                m_workflowPtr->runTo(id);
-            }
-            catch(std::exception& e)
-            {
-                batchErrorHandling(e);
             }
+            CWorkflowProfiler::setCurrentItem((int)i);
+            m_workflowPtr->clearAllOutputData();
+            runFunc(m_workflowPtr, taskId);
+        }
+        catch(std::exception& e)
+        {
+            batchErrorHandling(e);
         }
+    }
 
-        if(m_bStop)
-            onWorkflowFinished();
-    };
+    // Pool threads are reused by other runs
+    CWorkflowProfiler::setCurrentItem(-1);
+    m_prefetcher.stop();
 
-    runBatchGeneric(lambdaRun);
+    // Finish notification is handled in the main thread
+    if(m_bStop)
+        QMetaObject::invokeMethod(this, "onWorkflowFinished", Qt::QueuedConnection);
 }
 
-void CWorkflowRunManager::runBatchGeneric(std::function<void(void)> runFunc)
+void CWorkflowRunManager::runBatchParallel(const BatchRunFunc& runFunc, const WorkflowVertex& taskId)
 {
-    std::string erroMsg;
-    if(!checkInputs(erroMsg))
     {
-        m_bRunning = false;
-        qCCritical(logWorkflow) << QString::fromStdString(erroMsg);
-        return;
+        std::lock_guard<std::mutex> lock(m_batchMutex);
+        m_batchIndex = 0;
+        m_batchDoneCount = 0;
+        m_batchDone.assign(m_batchCount, false);
     }
+    m_nextBatchIndex = 0;
+    m_totalElapsedTime = 0;
+    m_workflowPtr->updateStartTime();
+    m_workflowPtr->workflowStarted();
 
-    m_batchCount = getBatchCount();
-    if(m_batchCount == 0)
+    m_batchRunFolders.clear();
+    m_batchPool.setMaxThreadCount((int)m_batchWorkers.size());
+    QFutureSynchronizer<void> workerSync;
+
+    for(size_t i=0; i<m_batchWorkers.size(); ++i)
     {
-        m_bRunning = false;
-        return;
+        const CBatchWorker& worker = m_batchWorkers[i];
+        worker.m_workflowPtr->updateStartTime();
+        worker.m_workflowPtr->workflowStarted();
+        workerSync.addFuture(QtConcurrent::run(&m_batchPool, [this, &worker, runFunc, taskId]
+        {
+            runBatchWorker(worker, runFunc, taskId);
+        }));
     }
+    workerSync.waitForFinished();
 
-    prepareBatchConfig();
-    auto future = QtConcurrent::run(runFunc);
-    m_processWatcher.setFuture(future);
-    m_sync.setFuture(future);
+    m_prefetcher.stop();
+
+    for(auto&& worker : m_batchWorkers)
+    {
+        worker.m_workflowPtr->workflowFinished();
+
+        auto folder = worker.m_workflowPtr->getLastRunFolder();
+        if(folder.empty() == false && std::find(m_batchRunFolders.begin(), m_batchRunFolders.end(), folder) == m_batchRunFolders.end())
+            m_batchRunFolders.push_back(folder);
+    }
+
+    // Either every item is done (m_batchIndex is the last one) or m_bStop is set.
+    // All workers are joined, finish notification is handled in the main thread
+    QMetaObject::invokeMethod(this, "onWorkflowFinished", Qt::QueuedConnection);
+}
+
+void CWorkflowRunManager::runBatchWorker(const CBatchWorker &worker, const BatchRunFunc &runFunc, const WorkflowVertex &taskId)
+{
+    WorkflowVertex workerTaskId = worker.m_workflowPtr->getRootId();
+    auto it = worker.m_vertexMap.find(taskId);
+    if(it != worker.m_vertexMap.end())
+        workerTaskId = it->second;
+
+    // Batch items are dispatched in input order from a shared counter
+    for(size_t i=m_nextBatchIndex++; i<m_batchCount && !m_bStop; i=m_nextBatchIndex++)
+    {
+        try
+        {
+            if(!setBatchInput(worker.m_workflowPtr, i))
+                break;
+
+            CWorkflowProfiler::setCurrentItem((int)i);
+            worker.m_workflowPtr->clearAllOutputData();
+            runFunc(worker.m_workflowPtr, workerTaskId);
+            notifyBatchItemDone(i);
+        }
+        catch(std::exception& e)
+        {
+            batchErrorHandling(e);
+        }
+    }
+    CWorkflowProfiler::setCurrentItem(-1);
 }
 
 void CWorkflowRunManager::runSingle()
@@ -1321,16 +1519,15 @@ void CWorkflowRunManager::runSingle()
     m_sync.setFuture(future);
 }
 
-void CWorkflowRunManager::runFromSingle()
+void CWorkflowRunManager::runFromSingle(const WorkflowVertex &taskId)
 {
     auto pSignal = static_cast<CWorkflowSignalHandler*>(m_workflowPtr->getSignalRawPtr());
     m_pProgressMgr->launchProgress(pSignal, QString("The workflow %1 is running.").arg(QString::fromStdString(m_workflowPtr->getName())), true);
-    pSignal->emitSetTotalSteps(m_workflowPtr->getProgressStepsFrom(m_workflowPtr->getActiveTaskId()));
+    pSignal->emitSetTotalSteps(m_workflowPtr->getProgressStepsFrom(taskId));
 
-    auto future = QtConcurrent::run([this]
+    auto future = QtConcurrent::run([this, taskId]
     {
-        auto id = m_workflowPtr->getActiveTaskId();
-        auto pTask = m_workflowPtr->getTask(id);
+        auto pTask = m_workflowPtr->getTask(taskId);
 
         if(pTask == nullptr)
         {
@@ -1344,7 +1541,7 @@ void CWorkflowRunManager::runFromSingle()
             m_workflowPtr->workflowStarted();
             m_workflowPtr->updateStartTime();
             m_totalElapsedTime = 0;
-            m_workflowPtr->runFrom(id);
+            m_workflowPtr->runFrom(taskId);
         }
         catch(std::exception& e)
         {
@@ -1401,11 +1598,9 @@ void CWorkflowRunManager::prepareBatchConfig()
         m_workflowPtr->setCfgEntry("GraphicsEmbedded", std::to_string(true));
         m_workflowPtr->setCfgEntry("WholeVideo", std::to_string(true));
 
+        // Frame counts come from the video index, files are only opened when not indexed yet
         for (size_t i=0; i<videoPaths.size(); ++i)
-        {
-            CDataVideoBuffer videoReader(videoPaths[i]);
-            steps += videoReader.getFrameCount();
-        }
+            steps += m_pDataMgr->getVideoMgr()->getFrameCount(videoPaths[i]);
         steps *= m_workflowPtr->getProgressSteps();
     }
     else
@@ -1414,6 +1609,24 @@ void CWorkflowRunManager::prepareBatchConfig()
     pSignal->emitSetTotalSteps(steps);
 }
 
+void CWorkflowRunManager::startBatchPrefetch()
+{
+    size_t depth = 0;
+    size_t maxMemory = 0;
+
+    if(m_pSettingsMgr)
+    {
+        depth = m_pSettingsMgr->getBatchPrefetchDepth();
+        maxMemory = m_pSettingsMgr->getBatchPrefetchMemory() * 1024 * 1024;
+    }
+
+    if(depth == 0)
+        return;
+
+    // Items i+1..i+depth are decoded while item i is processed
+    m_prefetcher.start([this](size_t index){ return loadBatchInputs(index); }, m_batchCount, depth, maxMemory);
+}
+
 void CWorkflowRunManager::restoreBatchConfig()
 {
     if (m_workflowPtr && m_workflowConfig.size() > 0)
@@ -1423,6 +1636,115 @@ void CWorkflowRunManager::restoreBatchConfig()
     }
 }
 
+CWorkflowRunManager::CBatchWorker CWorkflowRunManager::createBatchWorker() const
+{
+    assert(m_pProcessMgr && m_pGraphicsMgr);
+
+    CBatchWorker worker;
+    worker.m_workflowPtr = std::make_shared<CWorkflow>(m_workflowPtr->getName(), &m_pProcessMgr->m_registry, m_pGraphicsMgr->getContext());
+    worker.m_workflowPtr->setOutputFolder(m_workflowPtr->getOutputFolder());
+    worker.m_workflowPtr->setConfig(m_workflowPtr->getConfig());
+    worker.m_vertexMap.insert(std::make_pair(m_workflowPtr->getRootId(), worker.m_workflowPtr->getRootId()));
+
+    // Each worker owns its inputs: batch items are set in place
+    for(size_t i=0; i<m_workflowPtr->getInputCount(); ++i)
+    {
+        auto inputPtr = m_workflowPtr->getInput(i);
+        worker.m_workflowPtr->setInputBatchState(i, isBatchInput(i));
+        worker.m_workflowPtr->setInput(inputPtr ? inputPtr->clone() : nullptr, i, true);
+    }
+
+    // Same tasks with same parameters, instantiated from the registry like workflow loading does
+    auto vertexIt = m_workflowPtr->getVertices();
+    for(auto it=vertexIt.first; it!=vertexIt.second; ++it)
+    {
+        if(m_workflowPtr->isRoot(*it))
+            continue;
+
+        auto taskPtr = m_workflowPtr->getTask(*it);
+        auto newTaskPtr = m_pProcessMgr->createObject(taskPtr->getName(), nullptr);
+        if(newTaskPtr == nullptr)
+            throw CException(CoreExCode::NULL_POINTER, "The task of type: " + taskPtr->getName() + " can't be created", __func__, __FILE__, __LINE__);
+
+        newTaskPtr->setParamValues(taskPtr->getParam()->getParamMap());
+        newTaskPtr->parametersModified();
+        auto newId = worker.m_workflowPtr->addTask(newTaskPtr);
+        worker.m_vertexMap.insert(std::make_pair(*it, newId));
+    }
+
+    auto edgeIt = m_workflowPtr->getEdges();
+    for(auto it=edgeIt.first; it!=edgeIt.second; ++it)
+    {
+        auto edgePtr = m_workflowPtr->getEdge(*it);
+        auto srcId = worker.m_vertexMap.at(m_workflowPtr->getEdgeSource(*it));
+        auto targetId = worker.m_vertexMap.at(m_workflowPtr->getEdgeTarget(*it));
+        worker.m_workflowPtr->connect(srcId, edgePtr->getSourceIndex(), targetId, edgePtr->getTargetIndex());
+    }
+
+    // Output export settings are only known once connections are made
+    for(auto it=worker.m_vertexMap.begin(); it!=worker.m_vertexMap.end(); ++it)
+    {
+        if(m_workflowPtr->isRoot(it->first))
+            continue;
+
+        auto taskPtr = m_workflowPtr->getTask(it->first);
+        auto newTaskPtr = worker.m_workflowPtr->getTask(it->second);
+        newTaskPtr->setOutputFolder(taskPtr->getOutputFolder());
+        size_t outputCount = std::min(taskPtr->getOutputCount(), newTaskPtr->getOutputCount());
+
+        for(size_t i=0; i<outputCount; ++i)
+        {
+            newTaskPtr->getOutput(i)->setAutoSave(taskPtr->getOutput(i)->isAutoSave());
+            newTaskPtr->getOutput(i)->setSaveFormat(taskPtr->getOutput(i)->getSaveFormat());
+        }
+    }
+    return worker;
+}
+
+void CWorkflowRunManager::createBatchWorkers(size_t count)
+{
+    CPyEnsureGIL gil;
+    auto pMainSignal = static_cast<CWorkflowSignalHandler*>(m_workflowPtr->getSignalRawPtr());
+    m_batchWorkers.clear();
+
+    for(size_t i=0; i<count; ++i)
+    {
+        auto worker = createBatchWorker();
+        // Forward progress and timing to the main workflow handler, where the progress bar is connected
+        auto pSignal = static_cast<CWorkflowSignalHandler*>(worker.m_workflowPtr->getSignalRawPtr());
+        connect(pSignal, &CWorkflowSignalHandler::doProgress, pMainSignal, &CWorkflowSignalHandler::doProgress);
+        connect(pSignal, &CWorkflowSignalHandler::doSetElapsedTime, this, &CWorkflowRunManager::onSetElapsedTime);
+        m_profiler.attach(worker.m_workflowPtr);
+        m_batchWorkers.push_back(worker);
+    }
+}
+
+size_t CWorkflowRunManager::getBatchWorkerCount() const
+{
+    size_t count = 0;
+    if(m_pSettingsMgr)
+        count = m_pSettingsMgr->getBatchWorkerCount();
+
+    if(count == 0)
+        count = (size_t)std::max(1, QThread::idealThreadCount());
+
+    return count;
+}
+
+void CWorkflowRunManager::notifyBatchItemDone(size_t index)
+{
+    // Batch index only moves over contiguous finished items so that
+    // completion is reported in input order whatever the worker scheduling
+    std::lock_guard<std::mutex> lock(m_batchMutex);
+    m_batchDone[index] = true;
+
+    while(m_batchDoneCount < m_batchCount && m_batchDone[m_batchDoneCount])
+        m_batchDoneCount++;
+
+    if(m_batchDoneCount > 0)
+        m_batchIndex = m_batchDoneCount - 1;
+}
+
 void CWorkflowRunManager::waitForWorkflow()
 {
     if(m_bRunning)
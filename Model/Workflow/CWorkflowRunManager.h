@@ -23,10 +23,15 @@
 
 #include "Core/CWorkflow.h"
 #include "CWorkflowInput.h"
+#include "CBatchInputPrefetcher.h"
+#include "CWorkflowProfiler.h"
 
 class CProjectManager;
 class CMainDataManager;
 class CProgressBarManager;
+class CProcessManager;
+class CGraphicsManager;
+class CSettingsManager;
 
 class CWorkflowRunManager : public QObject
 {
@@ -37,20 +42,25 @@ class CWorkflowRunManager : public QObject
         CWorkflowRunManager(CWorkflowInputs* pInputs);
         ~CWorkflowRunManager();
 
-        void                    setManagers(CProjectManager *pProjectMgr, CMainDataManager *pDataMgr, CProgressBarManager* pProgressMgr);
+        void                    setManagers(CProjectManager *pProjectMgr, CMainDataManager *pDataMgr, CProgressBarManager* pProgressMgr,
+                                            CProcessManager* pProcessMgr, CGraphicsManager* pGraphicsMgr, CSettingsManager* pSettingsMgr);
         void                    setWorkflow(WorkflowPtr WorkflowPtr);
 
         double                  getTotalElapsedTime() const;
+        std::vector<std::string> getBatchRunFolders() const;
+        CWorkflowProfiler*      getProfiler();
         std::set<IODataType>    getTargetDataTypes(size_t inputIndex) const;
         std::set<IODataType>    getOriginTargetDataTypes(size_t inputIndex) const;
 
         bool                    isRunning() const;
+        bool                    isBatchInput(size_t index) const;
 
         WorkflowTaskIOPtr       createTaskIO(size_t inputIndex, size_t dataIndex, bool bNewSequence);
 
         void                    run();
         void                    runLive(size_t inputIndex);
         void                    runFromActiveTask();
+        void                    runFrom(const WorkflowVertex& taskId);
         void                    runToActiveTask();
         void                    runSequentialTask(const WorkflowVertex& taskId);
 
@@ -58,6 +68,8 @@ class CWorkflowRunManager : public QObject
 
         void                    notifyGraphicsChanged();
 
+        void                    resetElapsedTime();
+
         void                    stop();
         void                    stopWaitThread();
 
@@ -84,12 +96,23 @@ class CWorkflowRunManager : public QObject
 
         void                    onSequentialRunFinished();
         void                    onWorkflowFinished();
+        void                    onBatchFinished();
 
     private:
 
-        void                    setBatchInput(int index);
+        using BatchRunFunc = std::function<void(const WorkflowPtr&, const WorkflowVertex&)>;
+
+        struct CBatchWorker
+        {
+            WorkflowPtr                                         m_workflowPtr = nullptr;
+            std::unordered_map<WorkflowVertex, WorkflowVertex>  m_vertexMap;
+        };
+
+        bool                    setBatchInput(int index);
+        bool                    setBatchInput(const WorkflowPtr& workflowPtr, size_t index);
 
         size_t                  getBatchCount() const;
+        size_t                  getBatchWorkerCount() const;
         std::vector<std::string> getVideoInputPaths() const;
 
         bool                    checkInputs(std::string &err) const;
@@ -108,24 +131,37 @@ class CWorkflowRunManager : public QObject
 
         WorkflowTaskIOPtr       createIOFromDataItem(const QModelIndex& index, bool bNewSequence) const;
 
+        CBatchInputPrefetcher::BatchInputs  loadBatchInputs(size_t index);
+
         void                    runBatch();
         void                    runFromBatch();
         void                    runToBatch();
-        void                    runBatchGeneric(std::function<void(void)> runFunc);
+        void                    runBatchGeneric(const BatchRunFunc& runFunc, const WorkflowVertex& taskId);
+        void                    runBatchSequential(const BatchRunFunc& runFunc, const WorkflowVertex& taskId);
+        void                    runBatchParallel(const BatchRunFunc& runFunc, const WorkflowVertex& taskId);
+        void                    runBatchWorker(const CBatchWorker& worker, const BatchRunFunc& runFunc, const WorkflowVertex& taskId);
         void                    runSingle();
-        void                    runFromSingle();
+        void                    runFromSingle(const WorkflowVertex& taskId);
         void                    runToSingle();
 
         void                    prepareBatchConfig();
+        void                    startBatchPrefetch();
 
         void                    restoreBatchConfig();
 
+        CBatchWorker            createBatchWorker() const;
+        void                    createBatchWorkers(size_t count);
+        void                    notifyBatchItemDone(size_t index);
+
     private:
 
         WorkflowPtr                 m_workflowPtr = nullptr;
         CProjectManager*            m_pProjectMgr = nullptr;
         CMainDataManager*           m_pDataMgr = nullptr;
         CProgressBarManager*        m_pProgressMgr = nullptr;
+        CProcessManager*            m_pProcessMgr = nullptr;
+        CGraphicsManager*           m_pGraphicsMgr = nullptr;
+        CSettingsManager*           m_pSettingsMgr = nullptr;
 
         CWorkflowInputs*            m_pInputs = nullptr;
 
@@ -135,6 +171,8 @@ class CWorkflowRunManager : public QObject
         std::list<WorkflowVertex>   m_sequentialRuns;
 
         std::mutex                  m_mutex;
+        std::mutex                  m_batchMutex;
+        std::mutex                  m_batchInputMutex;
         QFutureSynchronizer<void>   m_sync;
         QFutureWatcher<void>        m_processWatcher;
         QFutureWatcher<void>        m_waitThreadWatcher;
@@ -145,8 +183,17 @@ class CWorkflowRunManager : public QObject
         size_t                      m_liveInputIndex = 0;
         size_t                      m_batchIndex = 0;
         size_t                      m_batchCount = 0;
+        std::atomic_size_t          m_nextBatchIndex{0};
+        size_t                      m_batchDoneCount = 0;
+        std::vector<bool>           m_batchDone;
+        std::vector<CBatchWorker>   m_batchWorkers;
+        QThreadPool                 m_batchPool;
+        CBatchInputPrefetcher       m_prefetcher;
+        CWorkflowProfiler           m_profiler;
         double                      m_totalElapsedTime = 0;
         MapString                   m_workflowConfig;
+        // Run folders of the parallel batch workers: the main workflow does not run in that mode
+        std::vector<std::string>    m_batchRunFolders;
 };
 
 #endif // CWORKFLOWRUNMANAGER_H
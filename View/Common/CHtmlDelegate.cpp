@@ -28,6 +28,11 @@ void CHtmlDelegate::setMutex(std::mutex* pMutex)
     m_pMutex = pMutex;
 }
 
+void CHtmlDelegate::setWordWrap(bool bWrap)
+{
+    m_bWordWrap = bWrap;
+}
+
 void CHtmlDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const
 {
     if(!index.isValid())
@@ -40,7 +45,7 @@ void CHtmlDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option,
 
     QTextDocument doc;
     QTextOption textOption(doc.defaultTextOption());
-    textOption.setWrapMode(QTextOption::WordWrap);
+    textOption.setWrapMode(m_bWordWrap ? QTextOption::WordWrap : QTextOption::NoWrap);
     doc.setDefaultTextOption(textOption);
     doc.setHtml(options.text);
     doc.setTextWidth(options.rect.width());
@@ -67,7 +72,7 @@ QSize CHtmlDelegate::sizeHint(const QStyleOptionViewItem &option, const QModelIn
 
     QTextDocument doc;
     QTextOption textOption(doc.defaultTextOption());
-    textOption.setWrapMode(QTextOption::WordWrap);
+    textOption.setWrapMode(m_bWordWrap ? QTextOption::WordWrap : QTextOption::NoWrap);
     doc.setDefaultTextOption(textOption);
     doc.setHtml(text);
     doc.setTextWidth(option.rect.width());
@@ -28,6 +28,7 @@ class CHtmlDelegate : public QStyledItemDelegate
 {
     public:
         void setMutex(std::mutex* pMutex);
+        void setWordWrap(bool bWrap);
 
     protected:
         void paint ( QPainter * painter, const QStyleOptionViewItem & option, const QModelIndex & index ) const;
@@ -37,6 +38,7 @@ class CHtmlDelegate : public QStyledItemDelegate
 
     private:
         mutable std::mutex* m_pMutex = nullptr;
+        bool m_bWordWrap = true;
 };
 
 
@@ -26,6 +26,7 @@
 
 #include "CImageScene.h"
 #include <QGraphicsPixmapItem>
+#include "CTiledImageItem.h"
 #include "CImageView.h"
 #include "Graphics/CGraphicsLayer.h"
 #include "Graphics/CGraphicsPoint.h"
@@ -47,12 +48,20 @@ CImageScene::~CImageScene()
 
 QImage CImageScene::getImage() const
 {
-    return m_pPixmapItem->pixmap().toImage();
+    if(m_pTiledItem)
+        return m_pTiledItem->getImage();
+    else if(m_pPixmapItem)
+        return m_pPixmapItem->pixmap().toImage();
+    else
+        return QImage();
 }
 
-QGraphicsPixmapItem* CImageScene::getPixmapItem() const
+QGraphicsItem *CImageScene::getImageItem() const
 {
-    return m_pPixmapItem;
+    if(m_pTiledItem)
+        return m_pTiledItem;
+    else
+        return m_pPixmapItem;
 }
 
 CGraphicsLayer* CImageScene::getCurrentGraphicsLayer() const
@@ -65,12 +74,21 @@ void CImageScene::setImage(const QImage& image)
     if(image.isNull())
         return;
 
-    if(m_pPixmapItem)
-        delete m_pPixmapItem;
+    removePixmap();
 
-    m_pPixmapItem = addPixmap(QPixmap::fromImage(image));
-    m_pPixmapItem->setTransformationMode(Qt::SmoothTransformation);
-    m_pPixmapItem->setZValue(-2);
+    if(CTiledImageItem::isTilingRequired(image))
+    {
+        //Huge image: render visible tiles only from a multi-resolution pyramid
+        m_pTiledItem = new CTiledImageItem(image);
+        m_pTiledItem->setZValue(-2);
+        addItem(m_pTiledItem);
+    }
+    else
+    {
+        m_pPixmapItem = addPixmap(QPixmap::fromImage(image));
+        m_pPixmapItem->setTransformationMode(Qt::SmoothTransformation);
+        m_pPixmapItem->setZValue(-2);
+    }
 }
 
 void CImageScene::setOverlayImage(const QImage &image)
@@ -99,6 +117,16 @@ void CImageScene::setCurrentGraphicsLayer(CGraphicsLayer *pLayer)
     m_pCurrentLayer = pLayer;
 }
 
+bool CImageScene::hasAlphaChannel() const
+{
+    if(m_pTiledItem)
+        return m_pTiledItem->hasAlphaChannel();
+    else if(m_pPixmapItem)
+        return m_pPixmapItem->pixmap().hasAlphaChannel();
+    else
+        return false;
+}
+
 void CImageScene::activateGraphics(bool bActivate)
 {
     m_bGraphicsActivated = bActivate;
@@ -123,6 +151,13 @@ void CImageScene::removePixmap()
         delete m_pPixmapItem;
         m_pPixmapItem = nullptr;
     }
+
+    if(m_pTiledItem != nullptr)
+    {
+        removeItem(m_pTiledItem);
+        delete m_pTiledItem;
+        m_pTiledItem = nullptr;
+    }
 }
 
 void CImageScene::removeGraphicsLayer(CGraphicsLayer *pLayer, bool bDelete)
@@ -173,6 +208,7 @@ void CImageScene::clearAll()
     clearOverlay();
     clear();
     m_pPixmapItem = nullptr;
+    m_pTiledItem = nullptr;
     m_pCurrentLayer = nullptr;
     m_pTemporaryItem = nullptr;
     m_pSelectionBox = nullptr;
@@ -248,7 +284,8 @@ bool CImageScene::isGraphicsItemAt(QPointF pt)
 {
     auto pItem = itemAt(pt, QTransform());
     auto pImgItem = dynamic_cast<QGraphicsPixmapItem*>(pItem);
-    return (pItem != nullptr && pImgItem == nullptr);
+    auto pTiledItem = dynamic_cast<CTiledImageItem*>(pItem);
+    return (pItem != nullptr && pImgItem == nullptr && pTiledItem == nullptr);
 }
 
 void CImageScene::initSelectionBox()
@@ -37,6 +37,7 @@
 
 class QAbstractGraphicsShapeItem;
 class CGraphicsLayer;
+class CTiledImageItem;
 
 /**
  * @brief
@@ -53,7 +54,7 @@ class CImageScene : public QGraphicsScene
 
 
         QImage                  getImage() const;
-        QGraphicsPixmapItem*    getPixmapItem() const;
+        QGraphicsItem*          getImageItem() const;
         CGraphicsLayer*         getCurrentGraphicsLayer() const;
 
         void                    setImage(const QImage& image);
@@ -61,6 +62,8 @@ class CImageScene : public QGraphicsScene
         void                    setGraphicsContext(GraphicsContextPtr &graphicsContextPtr);
         void                    setCurrentGraphicsLayer(CGraphicsLayer* pLayer);
 
+        bool                    hasAlphaChannel() const;
+
         void                    activateGraphics(bool bActivate);
 
         void                    addGraphicsLayer(CGraphicsLayer* pLayer, bool bTopMost);
@@ -128,6 +131,7 @@ class CImageScene : public QGraphicsScene
         //Image
         QGraphicsPixmapItem*        m_pPixmapItem = nullptr;
         QGraphicsPixmapItem*        m_pOverlayPixmapItem = nullptr;
+        CTiledImageItem*            m_pTiledItem = nullptr;
 
         //Graphics
         GraphicsContextPtr          m_graphicsContextPtr = nullptr;
@@ -317,15 +317,15 @@ void CImageView::drawBackground(QPainter *painter, const QRectF &r)
 {
     QGraphicsView::drawBackground(painter, r);
 
-    auto pPixmapItem = m_pScene->getPixmapItem();
-    if(pPixmapItem == nullptr)
+    auto pImageItem = m_pScene->getImageItem();
+    if(pImageItem == nullptr)
         return;
 
-    if(pPixmapItem->pixmap().hasAlphaChannel() == false)
+    if(m_pScene->hasAlphaChannel() == false)
         return;
 
     //Draw transparency pattern (alternance of two-colors squares)
-    const QRectF rcImage = pPixmapItem->boundingRect();
+    const QRectF rcImage = pImageItem->boundingRect();
     const QRectF rcImageVisible = rcImage.intersected(r);
 
     const QColor color1(80, 80, 80);
@@ -436,10 +436,10 @@ void CImageView::zoomFit()
 {
     assert(m_pScene != nullptr);
 
-    if(m_pScene->getPixmapItem() == nullptr)
+    if(m_pScene->getImageItem() == nullptr)
         return;
 
-    fitInView(m_pScene->getPixmapItem()->boundingRect(), Qt::KeepAspectRatio);
+    fitInView(m_pScene->getImageItem()->boundingRect(), Qt::KeepAspectRatio);
     m_numScheduledScalings = 0;
     m_bZoomFit = true;
 }
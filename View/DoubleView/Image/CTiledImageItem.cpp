@@ -0,0 +1,161 @@
+// Copyright (C) 2021 Ikomia SAS
+// Contact: https://www.ikomia.com
+//
+// This file is part of the IkomiaStudio software.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#include "CTiledImageItem.h"
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+#include <QtConcurrent/QtConcurrent>
+#include <cmath>
+
+CTiledImageItem::CTiledImageItem(const QImage &image, QGraphicsItem *pParent) : QGraphicsObject(pParent)
+{
+    m_image = image;
+    //Full resolution level is available immediately, lower levels are computed in background
+    m_levels.push_back(m_image);
+    m_tiles.setMaxCost(m_tileCacheSize);
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption, true);
+
+    connect(&m_pyramidWatcher, &QFutureWatcher<Pyramid>::finished, this, &CTiledImageItem::onPyramidReady);
+    m_pyramidWatcher.setFuture(QtConcurrent::run(getPyramidPool(), &CTiledImageItem::buildPyramid, m_image));
+}
+
+CTiledImageItem::~CTiledImageItem()
+{
+    //No wait: the build job works on its own copy of the image, its result is just dropped
+    m_pyramidWatcher.disconnect();
+}
+
+QImage CTiledImageItem::getImage() const
+{
+    return m_image;
+}
+
+bool CTiledImageItem::hasAlphaChannel() const
+{
+    return m_image.hasAlphaChannel();
+}
+
+bool CTiledImageItem::isTilingRequired(const QImage &image)
+{
+    return image.width() > m_tilingThreshold || image.height() > m_tilingThreshold;
+}
+
+QRectF CTiledImageItem::boundingRect() const
+{
+    return QRectF(0, 0, m_image.width(), m_image.height());
+}
+
+void CTiledImageItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+{
+    Q_UNUSED(widget);
+
+    const qreal scale = QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform());
+    const QRectF exposedRect = option->exposedRect.intersected(boundingRect());
+
+    if(exposedRect.isEmpty())
+        return;
+
+    painter->save();
+    painter->setRenderHint(QPainter::SmoothPixmapTransform, true);
+    paintLevel(painter, exposedRect, getLevel(scale));
+    painter->restore();
+}
+
+void CTiledImageItem::onPyramidReady()
+{
+    m_levels = m_pyramidWatcher.result();
+    m_tiles.clear();
+    update();
+}
+
+CTiledImageItem::Pyramid CTiledImageItem::buildPyramid(const QImage &image)
+{
+    Pyramid levels;
+    levels.push_back(image);
+
+    QImage level = image;
+    while(level.width() > m_tileSize || level.height() > m_tileSize)
+    {
+        level = level.scaled(std::max(1, level.width() / 2), std::max(1, level.height() / 2), Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+        levels.push_back(level);
+    }
+    return levels;
+}
+
+QThreadPool *CTiledImageItem::getPyramidPool()
+{
+    //Small dedicated pool: pyramids of huge images must not hold global pool threads
+    static QThreadPool pool;
+    static bool bInit = [] { pool.setMaxThreadCount(2); return true; }();
+    Q_UNUSED(bInit);
+    return &pool;
+}
+
+int CTiledImageItem::getLevel(qreal scale) const
+{
+    if(scale <= 0 || scale >= 1.0)
+        return 0;
+
+    //Each level halves the resolution: pick the coarsest one still at least as fine as the screen
+    int level = static_cast<int>(std::floor(std::log2(1.0 / scale)));
+    return std::min(level, static_cast<int>(m_levels.size()) - 1);
+}
+
+QPixmap *CTiledImageItem::getTile(int level, int row, int col)
+{
+    const quint64 key = (static_cast<quint64>(level) << 48) | (static_cast<quint64>(row) << 24) | static_cast<quint64>(col);
+    QPixmap* pTile = m_tiles.object(key);
+
+    if(pTile == nullptr)
+    {
+        const QImage& levelImg = m_levels[level];
+        const QRect tileRect = QRect(col * m_tileSize, row * m_tileSize, m_tileSize, m_tileSize).intersected(levelImg.rect());
+        pTile = new QPixmap(QPixmap::fromImage(levelImg.copy(tileRect)));
+        const int cost = std::max(1, tileRect.width() * tileRect.height() * 4 / 1024);
+
+        if(m_tiles.insert(key, pTile, cost) == false)
+            return nullptr;
+    }
+    return pTile;
+}
+
+void CTiledImageItem::paintLevel(QPainter *painter, const QRectF &exposedRect, int level)
+{
+    const QImage& levelImg = m_levels[level];
+    const qreal sx = (qreal)levelImg.width() / (qreal)m_image.width();
+    const qreal sy = (qreal)levelImg.height() / (qreal)m_image.height();
+    const int colCount = (levelImg.width() + m_tileSize - 1) / m_tileSize;
+    const int rowCount = (levelImg.height() + m_tileSize - 1) / m_tileSize;
+
+    const int firstCol = std::max(0, (int)std::floor(exposedRect.left() * sx / m_tileSize));
+    const int lastCol = std::min(colCount - 1, (int)std::floor(exposedRect.right() * sx / m_tileSize));
+    const int firstRow = std::max(0, (int)std::floor(exposedRect.top() * sy / m_tileSize));
+    const int lastRow = std::min(rowCount - 1, (int)std::floor(exposedRect.bottom() * sy / m_tileSize));
+
+    for(int row=firstRow; row<=lastRow; ++row)
+    {
+        for(int col=firstCol; col<=lastCol; ++col)
+        {
+            QPixmap* pTile = getTile(level, row, col);
+            if(pTile == nullptr)
+                continue;
+
+            const QRectF target(col * m_tileSize / sx, row * m_tileSize / sy, pTile->width() / sx, pTile->height() / sy);
+            painter->drawPixmap(target, *pTile, QRectF(pTile->rect()));
+        }
+    }
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2021 Ikomia SAS
+ * Contact: https://www.ikomia.com
+ *
+ * This file is part of the IkomiaStudio software.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef CTILEDIMAGEITEM_H
+#define CTILEDIMAGEITEM_H
+
+/**
+ * @file      CTiledImageItem.h
+ * @brief     Header file including CTiledImageItem definition
+ *
+ * @details   Graphics item displaying huge images through a multi-resolution pyramid.
+ * Only the tiles intersecting the exposed area are rendered, at the level matching the current zoom.
+ */
+
+#include <QGraphicsObject>
+#include <QFutureWatcher>
+#include <QThreadPool>
+#include <QCache>
+#include <QImage>
+
+/**
+ * @brief
+ *
+ */
+class CTiledImageItem : public QGraphicsObject
+{
+    Q_OBJECT
+
+    public:
+
+        using Pyramid = std::vector<QImage>;
+
+        CTiledImageItem(const QImage& image, QGraphicsItem* pParent = nullptr);
+        ~CTiledImageItem();
+
+        QImage                  getImage() const;
+
+        bool                    hasAlphaChannel() const;
+
+        static bool             isTilingRequired(const QImage& image);
+
+        virtual QRectF          boundingRect() const override;
+
+        virtual void            paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) override;
+
+    private slots:
+
+        void                    onPyramidReady();
+
+    private:
+
+        static Pyramid          buildPyramid(const QImage& image);
+
+        static QThreadPool*     getPyramidPool();
+
+        int                     getLevel(qreal scale) const;
+
+        QPixmap*                getTile(int level, int row, int col);
+
+        void                    paintLevel(QPainter* painter, const QRectF& exposedRect, int level);
+
+    private:
+
+        QImage                      m_image;
+        Pyramid                     m_levels;
+        QFutureWatcher<Pyramid>     m_pyramidWatcher;
+        QCache<quint64, QPixmap>    m_tiles;
+        static const int            m_tileSize = 512;
+        static const int            m_tilingThreshold = 4096;
+        static const int            m_tileCacheSize = 256 * 1024;   //KB
+};
+
+#endif // CTILEDIMAGEITEM_H
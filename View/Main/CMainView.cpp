@@ -61,7 +61,7 @@ CMainView::CMainView(QWidget *parent) : QMainWindow(parent), ui(new Ui::CMainVie
 
     // Display all Qt Message in Notification Center
     CLogManager::instance().addOutputManager([&](int type, const QString& msg, const QString& categoryName){
-        emit doDisplayLogMsg(type, msg, categoryName);
+        m_pNotificationPane->onDisplayLogMsg(type, msg, categoryName);
     });
 
     /*QTimer::singleShot(0, this, SLOT(showMaximized()));
@@ -522,7 +522,6 @@ void CMainView::initConnections()
     connect(m_pNotifyBtn, &QToolButton::clicked, [this]{ m_pCentralViewLayout->getRightTab()->setCurrentRow(0); });
 
     // Mainview -> notification pane
-    connect(this, &CMainView::doDisplayLogMsg, m_pNotificationPane, &CNotificationPane::onDisplayLogMsg);
 
     // Tutorials standby
     //connect(m_pTutoBtn, &QToolButton::clicked, [this]{ m_pCentralViewLayout->getRightTab()->setCurrentRow(1); });
@@ -157,8 +157,6 @@ class CMainView : public QMainWindow
 
         void                    doCloseApp();
 
-        void                    doDisplayLogMsg(int type, const QString& msg, const QString& categoryName);
-
         void                    doStartJupyterLab();
 
         //Plugin manager module
@@ -62,6 +62,7 @@ void CWorkflowModuleWidget::onSetModel(CWorkflowManager *pModel)
 {
     m_pModel = pModel;
     m_pView->setModel(pModel);
+    m_pTimeline->setProfiler(pModel->getProfiler());
     initConnections();
 }
 
@@ -335,6 +336,7 @@ void CWorkflowModuleWidget::initLayout()
     m_pParamLayout = createTab(QIcon(":/Images/properties_white.png"), tr("Parameters"), pInfoBtn);
     m_pInfoLayout = createTab(QIcon(":/Images/info-white.png"), tr("Info"), nullptr);
     m_pIOLayout = createTab(QIcon(":/Images/io.png"), tr("I/O"), nullptr);
+    auto pTimelineLayout = createTab(QIcon(":/Images/time.png"), tr("Timeline"), nullptr);
 
     // Object to create property for QtTreePropertyBrowser
     m_pVariantManager = new QtVariantPropertyManager(this);
@@ -355,6 +357,10 @@ void CWorkflowModuleWidget::initLayout()
     m_pIOPropertyList->setPropertiesWithoutValueMarked(true);
     m_pIOLayout->addWidget(m_pIOPropertyList);
 
+    // Init timeline layout
+    m_pTimeline = new CWorkflowTimelineWidget(this);
+    pTimelineLayout->addWidget(m_pTimeline);
+
     QSplitter* pSplitter = new QSplitter(this);
     pSplitter->setOrientation(Qt::Horizontal);
     pSplitter->addWidget(pContainerView);
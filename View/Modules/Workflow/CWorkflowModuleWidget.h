@@ -25,6 +25,7 @@
 #include <QWidget>
 #include "Main/forwards.hpp"
 #include "CWorkflowView.h"
+#include "CWorkflowTimelineWidget.h"
 
 class QtVariantPropertyManager;
 class QtTreePropertyBrowser;
@@ -125,6 +126,7 @@ class CWorkflowModuleWidget : public QWidget
         QVBoxLayout*                m_pIOLayout = nullptr;
         QtTreePropertyBrowser*      m_pInfoPropertyList = nullptr;
         QtTreePropertyBrowser*      m_pIOPropertyList = nullptr;
+        CWorkflowTimelineWidget*    m_pTimeline = nullptr;
         QtVariantPropertyManager*   m_pVariantManager = nullptr;
         QMap<QtProperty*, PropAttribute> m_ioProperties;
         CTaskInfo                   m_currentProcessInfo;
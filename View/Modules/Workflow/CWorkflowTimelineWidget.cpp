@@ -0,0 +1,315 @@
+// Copyright (C) 2021 Ikomia SAS
+// Contact: https://www.ikomia.com
+//
+// This file is part of the IkomiaStudio software.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "CWorkflowTimelineWidget.h"
+#include <QPainter>
+#include <QMouseEvent>
+#include <QToolTip>
+#include <QTreeWidget>
+#include <QHeaderView>
+#include <QCheckBox>
+#include <QLabel>
+#include <cmath>
+#include "Main/AppTools.hpp"
+
+CWorkflowTimelineView::CWorkflowTimelineView(QWidget *parent) : QWidget(parent)
+{
+    setMouseTracking(true);
+    setMinimumHeight(m_axisHeight + m_laneHeight);
+}
+
+void CWorkflowTimelineView::setRecords(const std::vector<CTaskExecRecord> &records, size_t laneCount)
+{
+    m_records = records;
+    m_laneCount = laneCount;
+
+    if(m_records.empty() == false)
+    {
+        m_startTime = m_records.front().m_start;
+        m_endTime = m_records.front().m_end;
+    }
+
+    for(auto&& record : m_records)
+    {
+        m_startTime = std::min(m_startTime, record.m_start);
+        m_endTime = std::max(m_endTime, record.m_end);
+        m_laneCount = std::max(m_laneCount, (size_t)record.m_threadIndex + 1);
+    }
+
+    setMinimumHeight(m_axisHeight + (int)std::max<size_t>(m_laneCount, 1) * m_laneHeight + 4);
+    update();
+}
+
+void CWorkflowTimelineView::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event);
+    QPainter painter(this);
+    painter.fillRect(rect(), palette().base());
+
+    if(m_records.empty())
+    {
+        painter.setPen(palette().text().color());
+        painter.drawText(rect(), Qt::AlignCenter, tr("No task execution recorded"));
+        return;
+    }
+
+    QRect area = getArea();
+    for(size_t i=0; i<m_laneCount; ++i)
+    {
+        int y = area.top() + (int)i * m_laneHeight;
+        if(i % 2 == 1)
+            painter.fillRect(QRect(0, y, width(), m_laneHeight), palette().alternateBase());
+
+        painter.setPen(palette().text().color());
+        painter.drawText(QRect(4, y, m_headerWidth - 8, m_laneHeight), Qt::AlignVCenter | Qt::AlignLeft, tr("Thread %1").arg(i));
+    }
+
+    // Time axis in ms from the first displayed execution
+    const int tickCount = 5;
+    double span = (double)(m_endTime - m_startTime) / 1000.0;
+    painter.setPen(palette().text().color());
+
+    for(int i=0; i<=tickCount; ++i)
+    {
+        int x = area.left() + (area.width() - 1) * i / tickCount;
+        painter.drawLine(x, m_axisHeight - 4, x, m_axisHeight);
+
+        QString label = QString("%1 ms").arg(span * i / tickCount, 0, 'f', 1);
+        int flags = Qt::AlignVCenter | (i == tickCount ? Qt::AlignRight : Qt::AlignLeft);
+        QRect labelRect = (i == tickCount) ? QRect(x - 100, 0, 100, m_axisHeight - 4) : QRect(x + 2, 0, 100, m_axisHeight - 4);
+        painter.drawText(labelRect, flags, label);
+    }
+
+    for(auto&& record : m_records)
+    {
+        QRectF barRect = getBarRect(record);
+        painter.fillRect(barRect, getTaskColor(record.m_taskName));
+
+        if(record.m_state == static_cast<int>(CWorkflowTask::State::_ERROR))
+        {
+            painter.setPen(Qt::red);
+            painter.drawRect(barRect);
+        }
+
+        if(barRect.width() > 40)
+        {
+            painter.setPen(Qt::black);
+            QString name = painter.fontMetrics().elidedText(record.m_taskName, Qt::ElideRight, (int)barRect.width() - 4);
+            painter.drawText(barRect.adjusted(2, 0, -2, 0), Qt::AlignVCenter | Qt::AlignLeft, name);
+        }
+    }
+}
+
+void CWorkflowTimelineView::mouseMoveEvent(QMouseEvent *event)
+{
+    // Last drawn bar is on top
+    for(auto it=m_records.rbegin(); it!=m_records.rend(); ++it)
+    {
+        if(getBarRect(*it).contains(event->pos()))
+        {
+            QToolTip::showText(event->globalPos(), getToolTip(*it), this);
+            return;
+        }
+    }
+    QToolTip::hideText();
+}
+
+QRect CWorkflowTimelineView::getArea() const
+{
+    return rect().adjusted(m_headerWidth, m_axisHeight, -4, 0);
+}
+
+QRectF CWorkflowTimelineView::getBarRect(const CTaskExecRecord &record) const
+{
+    QRect area = getArea();
+    double span = std::max<double>(1.0, (double)(m_endTime - m_startTime));
+    double scale = (double)area.width() / span;
+    double x = area.left() + (record.m_start - m_startTime) * scale;
+    double w = std::max(1.0, (record.m_end - record.m_start) * scale);
+    double y = area.top() + record.m_threadIndex * m_laneHeight + 2;
+    return QRectF(x, y, w, m_laneHeight - 4);
+}
+
+QColor CWorkflowTimelineView::getTaskColor(const QString &name) const
+{
+    // Stable color per task name
+    return QColor::fromHsv((int)(qHash(name) % 360), 110, 230);
+}
+
+QString CWorkflowTimelineView::getToolTip(const CTaskExecRecord &record) const
+{
+    const double mb = 1024.0 * 1024.0;
+    QString text = QString("<b>%1</b><br>").arg(record.m_taskName.toHtmlEscaped());
+    text += tr("Duration: %1 ms").arg((record.m_end - record.m_start) / 1000.0, 0, 'f', 2) + "<br>";
+    text += tr("Run: %1 (%2)").arg(record.m_runId).arg(CWorkflowProfiler::getRunTypeName(record.m_runType)) + "<br>";
+
+    if(record.m_itemIndex >= 0)
+        text += tr("Batch item: %1").arg(record.m_itemIndex) + "<br>";
+
+    if(record.m_inputShapes.isEmpty() == false)
+        text += tr("Inputs: %1 (%2 MB)").arg(record.m_inputShapes).arg(record.m_inputBytes / mb, 0, 'f', 1) + "<br>";
+
+    text += tr("Memory: %1 MB (peak %2 MB)").arg(record.m_memory / mb, 0, 'f', 0).arg(record.m_peakMemory / mb, 0, 'f', 0);
+    return text;
+}
+
+CWorkflowTimelineWidget::CWorkflowTimelineWidget(QWidget *parent) : QWidget(parent)
+{
+    initLayout();
+
+    // Live runs notify after each frame: refresh at most a few times per second
+    m_updateTimer.setSingleShot(true);
+    m_updateTimer.setInterval(250);
+    connect(&m_updateTimer, &QTimer::timeout, this, &CWorkflowTimelineWidget::updateView);
+}
+
+void CWorkflowTimelineWidget::setProfiler(CWorkflowProfiler *pProfiler)
+{
+    m_pProfiler = pProfiler;
+    if(m_pProfiler)
+    {
+        m_pRecordCheck->setChecked(m_pProfiler->isEnabled());
+        connect(m_pProfiler, &CWorkflowProfiler::doRecordsChanged, this, &CWorkflowTimelineWidget::onRecordsChanged);
+    }
+    updateView();
+}
+
+void CWorkflowTimelineWidget::onRecordsChanged()
+{
+    if(!m_updateTimer.isActive())
+        m_updateTimer.start();
+}
+
+void CWorkflowTimelineWidget::onExportTrace()
+{
+    if(m_pProfiler == nullptr)
+        return;
+
+    QSettings IkomiaSettings;
+    auto fileName = Utils::File::saveFile(this, tr("Export execution trace"), IkomiaSettings.value(_defaultDirWorkflowExport).toString(),
+                                          tr("Chrome trace (*.json)"), QStringList({"json"}), ".json");
+    if(fileName.isEmpty())
+        return;
+
+    IkomiaSettings.setValue(_defaultDirWorkflowExport, QFileInfo(fileName).path());
+    m_pProfiler->exportChromeTrace(fileName);
+}
+
+void CWorkflowTimelineWidget::initLayout()
+{
+    m_pRecordCheck = new QCheckBox(tr("Record"));
+    m_pRecordCheck->setToolTip(tr("Record task executions of single, live and batch runs"));
+    connect(m_pRecordCheck, &QCheckBox::toggled, [&](bool bChecked)
+    {
+        if(m_pProfiler)
+            m_pProfiler->setEnabled(bChecked);
+    });
+
+    auto pClearBtn = new QPushButton(tr("Clear"));
+    connect(pClearBtn, &QPushButton::clicked, [&]
+    {
+        if(m_pProfiler)
+            m_pProfiler->clear();
+    });
+
+    auto pExportBtn = new QPushButton(tr("Export trace"));
+    pExportBtn->setToolTip(tr("Save executions in Chrome trace format (chrome://tracing, Perfetto)"));
+    connect(pExportBtn, &QPushButton::clicked, this, &CWorkflowTimelineWidget::onExportTrace);
+
+    auto pBtnLayout = new QHBoxLayout;
+    pBtnLayout->addWidget(m_pRecordCheck);
+    pBtnLayout->addStretch(1);
+    pBtnLayout->addWidget(pClearBtn);
+    pBtnLayout->addWidget(pExportBtn);
+
+    m_pView = new CWorkflowTimelineView;
+    m_pInfoLabel = new QLabel;
+
+    m_pSummary = new QTreeWidget;
+    m_pSummary->setRootIsDecorated(false);
+    m_pSummary->setSortingEnabled(true);
+    m_pSummary->setHeaderLabels({tr("Task"), tr("Count"), tr("Total (ms)"), tr("Mean (ms)"), tr("Max (ms)"), tr("Share (%)")});
+    m_pSummary->header()->setSectionResizeMode(0, QHeaderView::Stretch);
+    m_pSummary->setMinimumHeight(150);
+
+    auto pLayout = new QVBoxLayout;
+    pLayout->setContentsMargins(0, 5, 0, 0);
+    pLayout->addLayout(pBtnLayout);
+    pLayout->addWidget(m_pView);
+    pLayout->addWidget(m_pInfoLabel);
+    pLayout->addWidget(m_pSummary);
+    setLayout(pLayout);
+}
+
+void CWorkflowTimelineWidget::updateView()
+{
+    std::vector<CTaskExecRecord> records;
+    size_t laneCount = 0;
+
+    if(m_pProfiler)
+    {
+        records = m_pProfiler->getRecords(m_maxDisplayed);
+        laneCount = m_pProfiler->getThreadNames().size();
+    }
+
+    m_pView->setRecords(records, laneCount);
+    updateSummary(records);
+}
+
+void CWorkflowTimelineWidget::updateSummary(const std::vector<CTaskExecRecord> &records)
+{
+    struct CTaskStat
+    {
+        int     m_count = 0;
+        double  m_total = 0;
+        double  m_max = 0;
+    };
+
+    std::map<QString, CTaskStat> stats;
+    double total = 0;
+
+    for(auto&& record : records)
+    {
+        double duration = (record.m_end - record.m_start) / 1000.0;
+        auto& stat = stats[record.m_taskName];
+        stat.m_count++;
+        stat.m_total += duration;
+        stat.m_max = std::max(stat.m_max, duration);
+        total += duration;
+    }
+
+    m_pSummary->setSortingEnabled(false);
+    m_pSummary->clear();
+
+    for(auto&& it : stats)
+    {
+        const CTaskStat& stat = it.second;
+        auto pItem = new QTreeWidgetItem(m_pSummary);
+        pItem->setText(0, it.first);
+        pItem->setData(1, Qt::DisplayRole, stat.m_count);
+        pItem->setData(2, Qt::DisplayRole, std::round(stat.m_total * 100.0) / 100.0);
+        pItem->setData(3, Qt::DisplayRole, std::round(stat.m_total / stat.m_count * 100.0) / 100.0);
+        pItem->setData(4, Qt::DisplayRole, std::round(stat.m_max * 100.0) / 100.0);
+        pItem->setData(5, Qt::DisplayRole, total > 0 ? std::round(stat.m_total * 1000.0 / total) / 10.0 : 0.0);
+    }
+
+    // Stage limiting throughput first
+    m_pSummary->setSortingEnabled(true);
+    m_pSummary->sortByColumn(2, Qt::DescendingOrder);
+    m_pInfoLabel->setText(tr("%1 task execution(s) displayed").arg(records.size()));
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2021 Ikomia SAS
+ * Contact: https://www.ikomia.com
+ *
+ * This file is part of the IkomiaStudio software.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CWORKFLOWTIMELINEWIDGET_H
+#define CWORKFLOWTIMELINEWIDGET_H
+
+#include <QWidget>
+#include <QTimer>
+#include "Model/Workflow/CWorkflowProfiler.h"
+
+class QTreeWidget;
+class QCheckBox;
+class QLabel;
+
+// Task executions drawn as bars, one lane per thread
+class CWorkflowTimelineView : public QWidget
+{
+    Q_OBJECT
+
+    public:
+
+        CWorkflowTimelineView(QWidget* parent = nullptr);
+
+        void        setRecords(const std::vector<CTaskExecRecord>& records, size_t laneCount);
+
+    protected:
+
+        void        paintEvent(QPaintEvent* event) override;
+        void        mouseMoveEvent(QMouseEvent* event) override;
+
+    private:
+
+        QRect       getArea() const;
+        QRectF      getBarRect(const CTaskExecRecord& record) const;
+        QColor      getTaskColor(const QString& name) const;
+        QString     getToolTip(const CTaskExecRecord& record) const;
+
+    private:
+
+        const int                       m_laneHeight = 20;
+        const int                       m_headerWidth = 70;
+        const int                       m_axisHeight = 18;
+        std::vector<CTaskExecRecord>    m_records;
+        size_t                          m_laneCount = 0;
+        qint64                          m_startTime = 0;
+        qint64                          m_endTime = 0;
+};
+
+class CWorkflowTimelineWidget : public QWidget
+{
+    Q_OBJECT
+
+    public:
+
+        CWorkflowTimelineWidget(QWidget* parent = nullptr);
+
+        void        setProfiler(CWorkflowProfiler* pProfiler);
+
+    private slots:
+
+        void        onRecordsChanged();
+        void        onExportTrace();
+
+    private:
+
+        void        initLayout();
+
+        void        updateView();
+        void        updateSummary(const std::vector<CTaskExecRecord>& records);
+
+    private:
+
+        // Most recent executions only: live runs produce records continuously
+        const size_t                m_maxDisplayed = 5000;
+        CWorkflowProfiler*          m_pProfiler = nullptr;
+        CWorkflowTimelineView*      m_pView = nullptr;
+        QTreeWidget*                m_pSummary = nullptr;
+        QCheckBox*                  m_pRecordCheck = nullptr;
+        QLabel*                     m_pInfoLabel = nullptr;
+        QTimer                      m_updateTimer;
+};
+
+#endif // CWORKFLOWTIMELINEWIDGET_H
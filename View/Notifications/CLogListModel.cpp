@@ -0,0 +1,288 @@
+// Copyright (C) 2021 Ikomia SAS
+// Contact: https://www.ikomia.com
+//
+// This file is part of the IkomiaStudio software.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "CLogListModel.h"
+#include <QtConcurrent/QtConcurrent>
+#include <QColor>
+
+CLogListModel::CLogListModel(QObject *parent) : QAbstractListModel(parent)
+{
+    m_htmlCache.setMaxCost(2000);
+    connect(this, &CLogListModel::doFilterResults, this, &CLogListModel::onFilterResults, Qt::QueuedConnection);
+}
+
+CLogListModel::~CLogListModel()
+{
+    stopFilter();
+}
+
+int CLogListModel::rowCount(const QModelIndex &parent) const
+{
+    if(parent.isValid())
+        return 0;
+
+    if(m_bFiltered)
+        return static_cast<int>(m_rows.size());
+    else
+        return static_cast<int>(m_end - m_begin);
+}
+
+QVariant CLogListModel::data(const QModelIndex &index, int role) const
+{
+    if(!index.isValid() || index.row() >= rowCount())
+        return QVariant();
+
+    quint64 seq = getSeq(index.row());
+    if(seq < m_store.getBegin() || seq >= m_store.getEnd())
+        return QVariant();
+
+    if(role == Qt::DisplayRole)
+    {
+        QString* pHtml = m_htmlCache.object(seq);
+        if(pHtml)
+            return *pHtml;
+
+        QString html = formatEntry(m_store.at(seq));
+        m_htmlCache.insert(seq, new QString(html));
+        return html;
+    }
+    else if(role == Qt::ToolTipRole)
+        return m_store.at(seq).m_msg;
+
+    return QVariant();
+}
+
+void CLogListModel::setCapacity(int capacity)
+{
+    m_store.setCapacity(static_cast<size_t>(std::max(capacity, 1)));
+    removeDiscardedRows();
+}
+
+void CLogListModel::setHtmlFontSize(size_t ftSize)
+{
+    m_htmlFontSize = ftSize;
+    m_htmlCache.clear();
+
+    if(rowCount() > 0)
+        emit dataChanged(index(0), index(rowCount() - 1));
+}
+
+void CLogListModel::setFilter(const CLogFilter &filter)
+{
+    stopFilter();
+
+    beginResetModel();
+    m_filter = filter;
+    m_bFiltered = filter.isActive();
+    m_rows.clear();
+    m_begin = m_store.getBegin();
+    m_end = m_store.getEnd();
+    endResetModel();
+
+    if(m_bFiltered)
+        startFilter();
+}
+
+CLogFilter CLogListModel::getFilter() const
+{
+    return m_filter;
+}
+
+void CLogListModel::append(const CLogEntries &entries)
+{
+    if(entries.isEmpty())
+        return;
+
+    std::vector<quint64> matches;
+    for(auto&& entry : entries)
+    {
+        quint64 seq = m_store.append(entry);
+        if(m_bFiltered && m_filter.accept(entry))
+            matches.push_back(seq);
+    }
+    removeDiscardedRows();
+
+    if(m_bFiltered)
+    {
+        // Entries may have been discarded by the same batch
+        auto it = std::lower_bound(matches.begin(), matches.end(), m_store.getBegin());
+        int count = static_cast<int>(matches.end() - it);
+
+        if(count > 0)
+        {
+            int row = static_cast<int>(m_rows.size());
+            beginInsertRows(QModelIndex(), row, row + count - 1);
+            m_rows.insert(m_rows.end(), it, matches.end());
+            endInsertRows();
+        }
+    }
+    else
+    {
+        int count = static_cast<int>(m_store.getEnd() - m_end);
+        if(count > 0)
+        {
+            int row = rowCount();
+            beginInsertRows(QModelIndex(), row, row + count - 1);
+            m_end = m_store.getEnd();
+            endInsertRows();
+        }
+    }
+}
+
+void CLogListModel::clear()
+{
+    stopFilter();
+
+    beginResetModel();
+    m_store.clear();
+    m_rows.clear();
+    m_begin = m_end = m_store.getEnd();
+    m_htmlCache.clear();
+    endResetModel();
+}
+
+void CLogListModel::onFilterResults(int generation, const QVector<quint64> &seqs)
+{
+    // Results of a previous filter
+    if(generation != m_generation)
+        return;
+
+    auto first = std::lower_bound(seqs.begin(), seqs.end(), m_store.getBegin());
+    if(first == seqs.end())
+        return;
+
+    // Slices are disjoint and older than entries evaluated on arrival: rows are inserted as one block
+    int row = static_cast<int>(std::lower_bound(m_rows.begin(), m_rows.end(), *first) - m_rows.begin());
+    int count = static_cast<int>(seqs.end() - first);
+    beginInsertRows(QModelIndex(), row, row + count - 1);
+    m_rows.insert(m_rows.begin() + row, first, seqs.end());
+    endInsertRows();
+}
+
+quint64 CLogListModel::getSeq(int row) const
+{
+    if(m_bFiltered)
+        return m_rows[static_cast<size_t>(row)];
+    else
+        return m_begin + static_cast<quint64>(row);
+}
+
+QString CLogListModel::formatEntry(const CLogEntry &entry) const
+{
+    QColor color;
+
+    switch(entry.m_type)
+    {
+        case QtDebugMsg:
+            color = QColor(70,195,230);
+            break;
+
+        case QtInfoMsg:
+            color = QColor(45,255,130);
+            break;
+
+        case QtWarningMsg:
+            color = QColor(255,110,45);
+            break;
+
+        case QtCriticalMsg:
+            color = QColor(255,45,45);
+            break;
+
+        case QtFatalMsg:
+            color = QColor(255,45,45);
+            break;
+
+        default:
+            color = QColor(255,255,255);
+            break;
+    }
+
+    // One line per row (uniform row height), full message is shown as tooltip
+    QString htmlMsg = entry.m_msg.toHtmlEscaped();
+    htmlMsg.replace("\n", " &#8629; ");
+    QString str = QString("<b>%1</b> <i>%2</i> : %3").arg(entry.m_dateTime.date().toString(Qt::ISODate)).arg(entry.m_dateTime.time().toString(Qt::ISODate)).arg(htmlMsg);
+    const QString fontTemplate = "<font size='%3' color='%1'>%2</font>";
+    return fontTemplate.arg(color.name(), str, QString::number(m_htmlFontSize));
+}
+
+void CLogListModel::removeDiscardedRows()
+{
+    quint64 begin = m_store.getBegin();
+
+    if(m_bFiltered)
+    {
+        int count = static_cast<int>(std::lower_bound(m_rows.begin(), m_rows.end(), begin) - m_rows.begin());
+        if(count > 0)
+        {
+            beginRemoveRows(QModelIndex(), 0, count - 1);
+            m_rows.erase(m_rows.begin(), m_rows.begin() + count);
+            endRemoveRows();
+        }
+    }
+    else if(begin > m_begin)
+    {
+        int count = static_cast<int>(std::min(begin, m_end) - m_begin);
+        if(count > 0)
+        {
+            beginRemoveRows(QModelIndex(), 0, count - 1);
+            m_begin += static_cast<quint64>(count);
+            endRemoveRows();
+        }
+        m_begin = begin;
+        m_end = std::max(m_end, begin);
+    }
+}
+
+void CLogListModel::startFilter()
+{
+    CLogStore::CSnapshot snapshot = m_store.getSnapshot();
+    CLogFilter filter = m_filter;
+    int generation = m_generation;
+
+    m_filterFuture = QtConcurrent::run([this, snapshot, filter, generation]
+    {
+        // Newest entries first: they are displayed at the bottom of the view
+        quint64 end = snapshot.m_end;
+        while(end > snapshot.m_begin && m_generation == generation)
+        {
+            quint64 begin = end - std::min(end - snapshot.m_begin, m_filterSlice);
+            QVector<quint64> seqs;
+
+            for(quint64 seq=begin; seq<end; ++seq)
+            {
+                if(filter.accept(snapshot.at(seq)))
+                    seqs.push_back(seq);
+            }
+
+            if(seqs.isEmpty() == false)
+                emit doFilterResults(generation, seqs);
+
+            end = begin;
+        }
+    });
+}
+
+void CLogListModel::stopFilter()
+{
+    // Running task stops at the end of its current slice
+    m_generation++;
+    m_filterFuture.waitForFinished();
+}
+
+#include "moc_CLogListModel.cpp"
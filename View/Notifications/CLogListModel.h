@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2021 Ikomia SAS
+ * Contact: https://www.ikomia.com
+ *
+ * This file is part of the IkomiaStudio software.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CLOGLISTMODEL_H
+#define CLOGLISTMODEL_H
+
+#include <QAbstractListModel>
+#include <QCache>
+#include <QFuture>
+#include <atomic>
+#include "Model/Log/CLogStore.hpp"
+
+// Virtual list model of the notification center.
+// Rows are mapped to entries of the log store, HTML is only built for displayed rows.
+// When a filter is set, stored entries are evaluated by slices in a background task
+// (newest first) while new entries are evaluated on arrival.
+class CLogListModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+    public:
+
+        CLogListModel(QObject* parent = nullptr);
+        ~CLogListModel();
+
+        int         rowCount(const QModelIndex& parent = QModelIndex()) const override;
+        QVariant    data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+        void        setCapacity(int capacity);
+        void        setHtmlFontSize(size_t ftSize);
+        void        setFilter(const CLogFilter& filter);
+
+        CLogFilter  getFilter() const;
+
+        void        append(const CLogEntries& entries);
+        void        clear();
+
+    signals:
+
+        void        doFilterResults(int generation, const QVector<quint64>& seqs);
+
+    private slots:
+
+        void        onFilterResults(int generation, const QVector<quint64>& seqs);
+
+    private:
+
+        quint64     getSeq(int row) const;
+        QString     formatEntry(const CLogEntry& entry) const;
+        void        removeDiscardedRows();
+        void        startFilter();
+        void        stopFilter();
+
+    private:
+
+        // Entries evaluated between two generation checks
+        const quint64                   m_filterSlice = 4096;
+        CLogStore                       m_store;
+        CLogFilter                      m_filter;
+        bool                            m_bFiltered = false;
+        // Sequence numbers of matching entries (filtered)
+        std::deque<quint64>             m_rows;
+        // Displayed sequence range (not filtered)
+        quint64                         m_begin = 0;
+        quint64                         m_end = 0;
+        std::atomic<int>                m_generation{0};
+        QFuture<void>                   m_filterFuture;
+        size_t                          m_htmlFontSize = 3;
+        mutable QCache<quint64, QString> m_htmlCache;
+};
+
+#endif // CLOGLISTMODEL_H
@@ -51,12 +51,10 @@ CNotificationPane::~CNotificationPane()
 
 void CNotificationPane::init()
 {
-    // QString list Model
-    m_pModel = new CNotificationModel;
-
-    // Proxy model for filtering
-    m_pProxy = new CNotificationProxyModel;
-    m_pProxy->setSourceModel(m_pModel);
+    // Log history model, filtered in place
+    m_pModel = new CLogListModel(this);
+    m_pModel->setCapacity(m_maxItems);
+    m_pModel->setHtmlFontSize(m_htmlFontSize);
 
     // init layout
     initLayout();
@@ -75,10 +73,13 @@ void CNotificationPane::initLayout()
     m_pListView->setStyleSheet(styleSheet);
     m_pListView->setEditTriggers(QListView::EditTrigger::NoEditTriggers);
     m_pListView->setVerticalScrollMode(QListView::ScrollPerPixel);
-    m_pListView->setModel(m_pProxy);
+    // One line per message: row height is computed once, only visible rows are formatted
+    m_pListView->setUniformItemSizes(true);
+    m_pListView->setModel(m_pModel);
     m_pDelegate = new CHtmlDelegate;
+    m_pDelegate->setWordWrap(false);
     m_pListView->setItemDelegate(m_pDelegate);
-    m_pListView->setWordWrap(true);
+    m_pListView->setWordWrap(false);
 
     // Title bar frame
     QFrame* pTitleBar = new QFrame;
@@ -104,6 +105,10 @@ void CNotificationPane::initLayout()
     pHBox->setSpacing(5);
     pHBox->addWidget(pClearBtn);
     pHBox->addWidget(m_pSearchEdit);
+
+    // Log message rate and dropped count
+    m_pStatsLabel = new QLabel;
+    pHBox->addWidget(m_pStatsLabel);
     // Notification parameters standby
     //pHBox->addWidget(m_pParamsBtn);
 
@@ -132,6 +137,9 @@ void CNotificationPane::initConnections()
 {
     connect(m_pSearchEdit, &QLineEdit::textChanged, this, &CNotificationPane::filterText);
     connect(this, &CNotificationPane::doUpdateView, this, &CNotificationPane::onUpdateView);
+    connect(&m_logTimer, &QTimer::timeout, this, &CNotificationPane::onFlushLogMsg);
+    m_rateTime = QDateTime::currentDateTime();
+    m_logTimer.start(m_refreshPeriod);
 }
 
 void CNotificationPane::initParams()
@@ -221,6 +229,8 @@ void CNotificationPane::initParams()
     QSpinBox* pSpinHistory = new QSpinBox;
     QLabel* pLabelHistory = new QLabel(tr("Max size (in rows)"));
     pLabelHistory->setWordWrap(true);
+    pSpinHistory->setRange(100, 1000000);
+    pSpinHistory->setSingleStep(1000);
     pSpinHistory->setValue(m_maxItems);
     pHLayout->addWidget(pLabelHistory);
     pHLayout->addWidget(pSpinHistory);
@@ -244,12 +254,10 @@ void CNotificationPane::initParams()
 
 void CNotificationPane::addNotification(const QString& text)
 {
-    auto date = QDate::currentDate();
-    auto time = QTime::currentTime();
-
-    QString str = QString("<b>%1</b> <i>%2</i> : %3").arg(date.toString()).arg(time.toString()).arg(text);
-    QString newLine = QString("<font size='%2'>%1</font><br/>").arg(str, QString::number(m_htmlFontSize));
-    setText(newLine, "");
+    CLogEntry entry;
+    entry.m_msg = text;
+    entry.m_dateTime = QDateTime::currentDateTime();
+    m_pModel->append({entry});
 }
 
 void CNotificationPane::setPadding(size_t padding)
@@ -260,6 +268,7 @@ void CNotificationPane::setPadding(size_t padding)
 void CNotificationPane::setHtmlFontSize(size_t ftSize)
 {
     m_htmlFontSize = ftSize;
+    m_pModel->setHtmlFontSize(ftSize);
 }
 
 void CNotificationPane::setAnimation(QByteArray name, int min, int max)
@@ -312,7 +321,7 @@ void CNotificationPane::onActivateDebugLog(bool bEnable)
 void CNotificationPane::onSetMaxItems(int maxItems)
 {
     m_maxItems = maxItems;
-    updateModelRows();
+    m_pModel->setCapacity(maxItems);
     emit doUpdateView();
 }
 
@@ -320,119 +329,92 @@ void CNotificationPane::onUpdateView()
 {
     // Select last inserted item and scroll to it
     auto index = m_pModel->index(m_pModel->rowCount()-1, 0);
-    QModelIndex proxyIndex = m_pProxy->mapFromSource(index);
-    m_pListView->setCurrentIndex(proxyIndex);
-    m_pListView->scrollTo(proxyIndex);
+    m_pListView->setCurrentIndex(index);
     m_pListView->scrollToBottom();
 }
 
 void CNotificationPane::onDisplayLogMsg(int type, const QString& msg, const QString& categoryName)
 {
-    QColor color;
-
-    switch(type)
-    {
-        case QtDebugMsg:
-            color = QColor(70,195,230);
 #ifdef QT_NO_DEBUG
-            // Do not print debug information in notification center
-            return;
+    // Do not print debug information in notification center
+    if(type == QtDebugMsg)
+        return;
 #endif
-            break;
-
-        case QtInfoMsg:
-            color = QColor(45,255,130);
-            break;
-
-        case QtWarningMsg:
-            color = QColor(255,110,45);
-            break;
-
-        case QtCriticalMsg:
-            color = QColor(255,45,45);
-            break;
-
-        case QtFatalMsg:
-            color = QColor(255,45,45);
-            break;
-
-        default:
-            color = QColor(255,255,255);
-            break;
-    }
-    auto date = QDate::currentDate();
-    auto time = QTime::currentTime();
-
-    QString htmlMsg = msg.toHtmlEscaped();
-    htmlMsg.replace("\n", "<br>");
-    QString str = QString("<b>%1</b> <i>%2</i> : %3").arg(date.toString(Qt::ISODate)).arg(time.toString(Qt::ISODate)).arg(htmlMsg);
-    const QString fontTemplate = "<font size='%3' color='%1'>%2</font><br/>";
-    QString newLine = fontTemplate.arg(color.name(), str, QString::number(m_htmlFontSize));
-
-    setText(newLine, categoryName);
+    // Called from any thread: messages are displayed by batch at most every m_refreshPeriod ms
+    m_logQueue.push(type, msg, categoryName);
 }
 
-void CNotificationPane::filterText(const QString& text)
+void CNotificationPane::onFlushLogMsg()
 {
-    if(text.isEmpty())
-    {
-        m_pProxy->invalidate();
-        m_pProxy->setSourceModel(m_pModel);
+    // Bounded by the current size so that a flood of messages can't keep the GUI thread busy
+    CLogEntries entries;
+    m_logQueue.popAll(entries, m_logQueue.getSize());
+    updateLogStats();
+
+    size_t dropped = m_logQueue.getDroppedCount();
+    if(entries.empty() && dropped == m_lastDropped)
         return;
-    }
 
-    QRegExp rx("[, ]");// match a comma or a space
-    QStringList list = text.split(rx, QString::SkipEmptyParts);
-    QString str = "^.*(";
-    for(auto&& it : list)
+    if(dropped > m_lastDropped)
     {
-        str += it+"|";
+        CLogEntry entry;
+        entry.m_type = QtWarningMsg;
+        entry.m_msg = tr("%1 message(s) dropped").arg(dropped - m_lastDropped);
+        entry.m_dateTime = QDateTime::currentDateTime();
+        entries.push_back(entry);
+        m_lastDropped = dropped;
     }
-    str.chop(1);
-    str += ").*$";
-    QRegExp regExp(str, Qt::CaseInsensitive, QRegExp::RegExp);
-    m_pProxy->setFilterRegExp(regExp);
+    m_pModel->append(entries);
+    emit doUpdateView();
 }
 
-void CNotificationPane::setText(const QString& text, const QString& category)
+void CNotificationPane::updateLogStats()
 {
-    int r = m_pModel->rowCount();
-    if(m_pModel->insertRows(r, 1))
-    {
-        QModelIndex index = m_pModel->index(m_pModel->rowCount() - 1, 0);
-        m_pModel->setData(index, text);
-        m_pModel->setData(index, category, CNotificationModel::categoryRole);
-    }
+    auto now = QDateTime::currentDateTime();
+    auto elapsed = m_rateTime.msecsTo(now);
 
-    updateModelRows();
-    emit doUpdateView();
+    if(elapsed < 1000)
+        return;
+
+    size_t count = m_logQueue.getCount();
+    m_logRate = (double)(count - m_rateCount) * 1000.0 / (double)elapsed;
+    m_rateCount = count;
+    m_rateTime = now;
+
+    QString stats;
+    if(m_logRate >= 1)
+        stats = tr("%1 msg/s").arg(qRound(m_logRate));
+
+    if(m_logQueue.getDroppedCount() > 0)
+        stats += (stats.isEmpty() ? "" : " - ") + tr("%1 dropped").arg(m_logQueue.getDroppedCount());
+
+    m_pStatsLabel->setText(stats);
 }
 
-void CNotificationPane::clearAllItems()
+void CNotificationPane::filterText(const QString& text)
 {
-    m_pModel->setStringList(QStringList{});
+    // Match a comma or a space
+    QRegExp rx("[, ]");
+    CLogFilter filter = m_pModel->getFilter();
+    filter.m_words = text.split(rx, QString::SkipEmptyParts);
+    m_pModel->setFilter(filter);
+    emit doUpdateView();
 }
 
-void CNotificationPane::updateModelRows()
+void CNotificationPane::clearAllItems()
 {
-    int r = m_pModel->rowCount();
-    // Check in order to keep only the last m_maxItems items
-    while(r > m_maxItems)
-    {
-        m_pModel->deleteItem(m_pModel->index(0,0));
-        r--;
-    }
-    m_pModel->update();
+    m_pModel->clear();
 }
 
 void CNotificationPane::manageCategory(bool bChecked, const QString& text)
 {
+    CLogFilter filter = m_pModel->getFilter();
     if(bChecked)
-        m_pProxy->addCategory(text);
+        filter.m_categories.push_back(text);
     else
-        m_pProxy->removeCategory(text);
+        filter.m_categories.removeAll(text);
 
-    m_pModel->update();
+    m_pModel->setFilter(filter);
 }
 
 void CNotificationPane::animate()
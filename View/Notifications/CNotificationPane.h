@@ -23,10 +23,11 @@
 
 #include <QDialog>
 #include <QMutex>
-#include <QSortFilterProxyModel>
-#include <QStringListModel>
 #include <QDockWidget>
+#include <QTimer>
 #include <mutex>
+#include "Model/Log/CLogQueue.hpp"
+#include "CLogListModel.h"
 
 class QPlainTextEdit;
 class QListView;
@@ -35,138 +36,9 @@ class QComboBox;
 class QFrame;
 class QLineEdit;
 class QToolButton;
+class QLabel;
 class CHtmlDelegate;
 
-class CNotificationModel : public QStringListModel
-{
-    public:
-        enum NotificationRole
-        {
-            categoryRole = Qt::UserRole + 1
-        };
-        CNotificationModel(QObject* parent = nullptr)
-            :    QStringListModel(parent)
-        {}
-
-        QVariant data(const QModelIndex & index, int role = Qt::EditRole) const override
-        {
-            if (role == categoryRole)
-            {
-                auto itr = m_categoryMap.find(index.row());
-                if (itr != m_categoryMap.end())
-                    return itr->second;
-            }
-            else if (role == Qt::FontRole)
-            {
-                QFont font;
-                font.setPointSize(1);
-                return font;
-            }
-
-            return QStringListModel::data(index, role);
-        }
-
-        bool setData(const QModelIndex & index, const QVariant & value, int role = Qt::EditRole) override
-        {
-            //std::lock_guard<std::mutex> lock(m_mutex);
-            if (role == categoryRole)
-            {
-                m_categoryMap[index.row()] = value.toString();
-                emit dataChanged(index, index);
-                return true;
-            }
-
-            return QStringListModel::setData(index, value, role);
-        }
-
-        void deleteItem(const QModelIndex& index)
-        {
-            if (!index.isValid() || index.row() >= stringList().size())
-                return;
-
-            removeRows(index.row(), 1);
-        }
-
-        void update()
-        {
-            emit dataChanged(createIndex(0,0), createIndex(rowCount()-1,0));
-        }
-
-    private:
-
-        mutable std::mutex m_mutex;
-        std::map<int, QString> m_categoryMap;
-};
-
-class CNotificationProxyModel : public QSortFilterProxyModel
-{
-    Q_OBJECT
-
-    public:
-
-        CNotificationProxyModel(QObject *parent = nullptr) : QSortFilterProxyModel(parent){}
-
-        void addCategory(const QString& text)
-        {
-            m_categoryList.push_back(text);
-        }
-
-        void removeCategory(const QString& text)
-        {
-            m_categoryList.removeAll(text);
-        }
-
-        void clearCategory()
-        {
-            m_categoryList.clear();
-        }
-
-        QList<QString> getCategoryList()
-        {
-            return m_categoryList;
-        }
-
-        QVariant data(const QModelIndex &proxyIndex, int role = Qt::DisplayRole) const Q_DECL_OVERRIDE
-        {
-            //std::lock_guard<std::mutex> lock(m_mutex);
-            return QSortFilterProxyModel::data(proxyIndex, role);
-        }
-        void setSourceModel(QAbstractItemModel *sourceModel) Q_DECL_OVERRIDE
-        {
-            //std::lock_guard<std::mutex> lock(m_mutex);
-            QSortFilterProxyModel::setSourceModel(sourceModel);
-        }
-
-    protected:
-
-        virtual bool filterAcceptsRow(int source_row, const QModelIndex & source_parent) const override
-        {
-            // check the current item
-            QModelIndex currIndex = sourceModel()->index(source_row, 0, source_parent);
-            if(!currIndex.isValid())
-                return false;
-
-            auto text = currIndex.data().toString();
-            auto categoryName = currIndex.data(CNotificationModel::categoryRole).toString();
-
-            // Select row if contains some words from search box
-            bool bRet = text.contains(filterRegExp());
-            if(!m_categoryList.empty())
-            {
-                bRet = bRet && m_categoryList.contains(categoryName);
-                for(auto&& it : m_categoryList)
-                    bRet = bRet || text.contains(it, Qt::CaseInsensitive);
-            }
-
-            return bRet;
-        }
-
-    private:
-
-        mutable std::mutex m_mutex;
-        QList<QString> m_categoryList = {};
-};
-
 class CNotificationPane : public QWidget
 {
     Q_OBJECT
@@ -201,14 +73,18 @@ class CNotificationPane : public QWidget
         void    onActivateDebugLog(bool bEnable);
         void    onSetMaxItems(int maxItems);
         void    onUpdateView();
+        // Thread-safe
         void    onDisplayLogMsg(int type, const QString &msg, const QString &categoryName);
 
+    private slots:
+
+        void    onFlushLogMsg();
+
     private:
 
         void    filterText(const QString& text);
-        void    setText(const QString& text, const QString& category);
+        void    updateLogStats();
         void    clearAllItems();
-        void    updateModelRows();
         void    manageCategory(bool bChecked, const QString& text);
 
     private:
@@ -216,8 +92,7 @@ class CNotificationPane : public QWidget
         std::mutex                  m_mutex;
         QListView*                  m_pListView = nullptr;
         QListWidget*                m_pListWidget = nullptr;
-        CNotificationModel*         m_pModel = nullptr;
-        CNotificationProxyModel*    m_pProxy = nullptr;
+        CLogListModel*              m_pModel = nullptr;
         CHtmlDelegate*              m_pDelegate = nullptr;
         QLineEdit*                  m_pSearchEdit = nullptr;
         QFrame*                     m_pParams = nullptr;
@@ -229,7 +104,17 @@ class CNotificationPane : public QWidget
         int                         m_animationMinValue = 0;
         int                         m_animationMaxValue = 0;
         bool                        m_bIsOpened = false;
-        int                         m_maxItems = 100;
+        int                         m_maxItems = 100000;
+        // Log display refresh period in ms
+        const int                   m_refreshPeriod = 100;
+        // Separate from the log file sink queue: each consumer pops its own entries
+        CLogQueue                   m_logQueue;
+        QTimer                      m_logTimer;
+        QLabel*                     m_pStatsLabel = nullptr;
+        size_t                      m_lastDropped = 0;
+        size_t                      m_rateCount = 0;
+        double                      m_logRate = 0;
+        QDateTime                   m_rateTime;
 };
 
 #endif // CNOTIFICATIONPANE_H
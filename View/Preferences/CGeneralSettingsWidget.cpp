@@ -19,6 +19,8 @@
 #include "CGeneralSettingsWidget.h"
 #include <QCheckBox>
 #include <QVBoxLayout>
+#include <QSpinBox>
+#include <QLabel>
 
 CGeneralSettingsWidget::CGeneralSettingsWidget(QWidget* parent) : QWidget(parent)
 {
@@ -37,6 +39,12 @@ void CGeneralSettingsWidget::onEnableNativeDialog(bool bEnable)
     m_pCheckNative->setChecked(bEnable);
 }
 
+void CGeneralSettingsWidget::onSetImageCacheMemory(int memory)
+{
+    QSignalBlocker blocker(m_pSpinImageCache);
+    m_pSpinImageCache->setValue(memory);
+}
+
 void CGeneralSettingsWidget::initLayout()
 {
     QVBoxLayout* pVBoxLayout = new QVBoxLayout;
@@ -47,6 +55,17 @@ void CGeneralSettingsWidget::initLayout()
     m_pCheckNative = new QCheckBox(tr("Enable native file manager"));
     pVBoxLayout->addWidget(m_pCheckNative);
 
+    m_pSpinImageCache = new QSpinBox;
+    m_pSpinImageCache->setRange(0, 65536);
+    m_pSpinImageCache->setSuffix(" MB");
+    m_pSpinImageCache->setSpecialValueText(tr("Disabled"));
+    m_pSpinImageCache->setToolTip(tr("Memory used to keep decoded images so that browsing back and forth does not read them again"));
+
+    QHBoxLayout* pCacheLayout = new QHBoxLayout;
+    pCacheLayout->addWidget(new QLabel(tr("Image cache")));
+    pCacheLayout->addWidget(m_pSpinImageCache);
+    pVBoxLayout->addLayout(pCacheLayout);
+
     setLayout(pVBoxLayout);
 }
 
@@ -55,4 +74,5 @@ void CGeneralSettingsWidget::initConnections()
     // Tutorials standby
     connect(m_pCheckTuto, &QCheckBox::toggled, [&](bool bEnable){ emit doEnableTutorialHelper(bEnable); });
     connect(m_pCheckNative, &QCheckBox::toggled, [&](bool bEnable){ emit doEnableNativeDialog(bEnable); });
+    connect(m_pSpinImageCache, QOverload<int>::of(&QSpinBox::valueChanged), [&](int memory){ emit doSetImageCacheMemory(memory); });
 }
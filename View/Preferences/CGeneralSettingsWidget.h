@@ -24,6 +24,7 @@
 #include <QWidget>
 
 class QCheckBox;
+class QSpinBox;
 
 class CGeneralSettingsWidget : public QWidget
 {
@@ -37,11 +38,13 @@ class CGeneralSettingsWidget : public QWidget
 
         void        doEnableTutorialHelper(bool bEnable);
         void        doEnableNativeDialog(bool bEnable);
+        void        doSetImageCacheMemory(int memory);
 
     public slots:
 
         void        onEnableTutorialHelper(bool bEnable);
         void        onEnableNativeDialog(bool bEnable);
+        void        onSetImageCacheMemory(int memory);
 
     private:
 
@@ -53,6 +56,7 @@ class CGeneralSettingsWidget : public QWidget
         // Tutorials standby
         QCheckBox*  m_pCheckTuto = nullptr;
         QCheckBox*  m_pCheckNative = nullptr;
+        QSpinBox*   m_pSpinImageCache = nullptr;
 };
 
 #endif // CGENERALSETTINGSWIDGET_H
@@ -30,6 +30,26 @@ void CWorkflowSettingsWidget::onSetSaveFolder(const QString &path)
     m_pBrowseWidget->setPath(path);
 }
 
+void CWorkflowSettingsWidget::onSetBatchWorkerCount(int count)
+{
+    QSignalBlocker blocker(m_pSpinWorkers);
+    m_pSpinWorkers->setValue(count);
+}
+
+void CWorkflowSettingsWidget::onSetBatchPrefetch(int depth, int memory)
+{
+    QSignalBlocker blockerDepth(m_pSpinPrefetchDepth);
+    QSignalBlocker blockerMemory(m_pSpinPrefetchMemory);
+    m_pSpinPrefetchDepth->setValue(depth);
+    m_pSpinPrefetchMemory->setValue(memory);
+}
+
+void CWorkflowSettingsWidget::onSetCacheMemory(int memory)
+{
+    QSignalBlocker blocker(m_pSpinCacheMemory);
+    m_pSpinCacheMemory->setValue(memory);
+}
+
 void CWorkflowSettingsWidget::initLayout()
 {
     auto pLabel = new QLabel(tr("Auto-save folder"));
@@ -37,13 +57,60 @@ void CWorkflowSettingsWidget::initLayout()
     m_pBrowseWidget = new CBrowseFileWidget();
     m_pBrowseWidget->setMode(QFileDialog::FileMode::Directory);
 
+    auto pLabelWorkers = new QLabel(tr("Batch workers"));
+
+    m_pSpinWorkers = new QSpinBox;
+    m_pSpinWorkers->setRange(0, 256);
+    m_pSpinWorkers->setSpecialValueText(tr("Auto"));
+    m_pSpinWorkers->setToolTip(tr("Number of workflow instances running batch items in parallel (Auto: one per core)"));
+
+    auto pLabelDepth = new QLabel(tr("Batch read-ahead"));
+
+    m_pSpinPrefetchDepth = new QSpinBox;
+    m_pSpinPrefetchDepth->setRange(0, 64);
+    m_pSpinPrefetchDepth->setSpecialValueText(tr("Disabled"));
+    m_pSpinPrefetchDepth->setToolTip(tr("Number of batch items loaded in advance while the current one is processed"));
+
+    auto pLabelMemory = new QLabel(tr("Read-ahead memory"));
+
+    m_pSpinPrefetchMemory = new QSpinBox;
+    m_pSpinPrefetchMemory->setRange(0, 65536);
+    m_pSpinPrefetchMemory->setSuffix(" MB");
+    m_pSpinPrefetchMemory->setSpecialValueText(tr("Unlimited"));
+
+    auto pLabelCache = new QLabel(tr("Task output cache"));
+
+    m_pSpinCacheMemory = new QSpinBox;
+    m_pSpinCacheMemory->setRange(0, 65536);
+    m_pSpinCacheMemory->setSuffix(" MB");
+    m_pSpinCacheMemory->setSpecialValueText(tr("Disabled"));
+    m_pSpinCacheMemory->setToolTip(tr("Memory used to keep task results so that unchanged tasks are not computed again"));
+
     auto pLayout = new QGridLayout;
     pLayout->addWidget(pLabel, 0, 0);
     pLayout->addWidget(m_pBrowseWidget, 0, 1);
+    pLayout->addWidget(pLabelWorkers, 1, 0);
+    pLayout->addWidget(m_pSpinWorkers, 1, 1);
+    pLayout->addWidget(pLabelDepth, 2, 0);
+    pLayout->addWidget(m_pSpinPrefetchDepth, 2, 1);
+    pLayout->addWidget(pLabelMemory, 3, 0);
+    pLayout->addWidget(m_pSpinPrefetchMemory, 3, 1);
+    pLayout->addWidget(pLabelCache, 4, 0);
+    pLayout->addWidget(m_pSpinCacheMemory, 4, 1);
     setLayout(pLayout);
 }
 
 void CWorkflowSettingsWidget::initConnections()
 {
     connect(m_pBrowseWidget, &CBrowseFileWidget::selectedFileChanged, [&](const QString& path){ emit doSetSaveFolder(path);});
+    connect(m_pSpinWorkers, QOverload<int>::of(&QSpinBox::valueChanged), [&](int count){ emit doSetBatchWorkerCount(count); });
+    connect(m_pSpinPrefetchDepth, QOverload<int>::of(&QSpinBox::valueChanged), [&](int depth)
+    {
+        emit doSetBatchPrefetch(depth, m_pSpinPrefetchMemory->value());
+    });
+    connect(m_pSpinPrefetchMemory, QOverload<int>::of(&QSpinBox::valueChanged), [&](int memory)
+    {
+        emit doSetBatchPrefetch(m_pSpinPrefetchDepth->value(), memory);
+    });
+    connect(m_pSpinCacheMemory, QOverload<int>::of(&QSpinBox::valueChanged), [&](int memory){ emit doSetCacheMemory(memory); });
 }
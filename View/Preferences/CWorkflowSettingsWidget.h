@@ -24,6 +24,7 @@
 #include <QWidget>
 
 class CBrowseFileWidget;
+class QSpinBox;
 
 class CWorkflowSettingsWidget : public QWidget
 {
@@ -36,10 +37,16 @@ class CWorkflowSettingsWidget : public QWidget
     signals:
 
         void    doSetSaveFolder(const QString& path);
+        void    doSetBatchWorkerCount(int count);
+        void    doSetBatchPrefetch(int depth, int memory);
+        void    doSetCacheMemory(int memory);
 
     public slots:
 
         void    onSetSaveFolder(const QString& path);
+        void    onSetBatchWorkerCount(int count);
+        void    onSetBatchPrefetch(int depth, int memory);
+        void    onSetCacheMemory(int memory);
 
     private:
 
@@ -48,7 +55,11 @@ class CWorkflowSettingsWidget : public QWidget
 
     private:
 
-        CBrowseFileWidget* m_pBrowseWidget = nullptr;
+        CBrowseFileWidget*  m_pBrowseWidget = nullptr;
+        QSpinBox*           m_pSpinWorkers = nullptr;
+        QSpinBox*           m_pSpinPrefetchDepth = nullptr;
+        QSpinBox*           m_pSpinPrefetchMemory = nullptr;
+        QSpinBox*           m_pSpinCacheMemory = nullptr;
 };
 
 #endif // CWORKFLOWSETTINGSWIDGET_H
@@ -268,6 +268,8 @@ void CStoreDlg::showEvent(QShowEvent *event)
 
 void CStoreDlg::closeEvent(QCloseEvent* event)
 {
+    //Closed by user: pending plugin compression or extraction is stopped
+    emit doCancelArchive();
     emit doClose();
     QDialog::closeEvent(event);
 }
@@ -50,6 +50,7 @@ class CStoreDlg : public CDialog
         void            doServerSearchChanged(const QString& text);
         void            doLocalSearchChanged(const QString& text);
         void            doClose();
+        void            doCancelArchive();
 
     public slots:
 